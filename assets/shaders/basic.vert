@@ -1,9 +1,14 @@
-#version 460 core
+#version 450 core
 
 layout(location = 0) in vec3 inPos;
 
 uniform mat4 model;
-uniform mat4 projectionView;
+
+// The per frame data shared by every pipeline, see renderer::opengl::FrameUniforms.
+layout(std140, binding = 0) uniform Frame {
+    mat4 projectionView;
+    vec3 cameraWorldPos;
+};
 
 void main() {
     gl_Position = projectionView * model * vec4(inPos, 1.0f);
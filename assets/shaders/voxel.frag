@@ -0,0 +1,23 @@
+#version 450 core
+
+in vec3 normal;
+in vec2 textureCoords;
+in float occlusion;
+flat in uint material;
+
+layout(location = 0) out vec4 outColor;
+
+#define SUN_DIRECTION normalize(vec3(0.3f, 1.0f, 0.5f))
+
+const vec3 MATERIAL_COLORS[4] = vec3[](
+    vec3(1.0f, 0.0f, 1.0f),
+    vec3(0.5f, 0.5f, 0.52f),
+    vec3(0.45f, 0.3f, 0.18f),
+    vec3(0.3f, 0.6f, 0.2f)
+);
+
+void main() {
+    vec3 color = MATERIAL_COLORS[material < 4u ? material : 0u];
+    float light = 0.4f + 0.6f * max(dot(normal, SUN_DIRECTION), 0.0f);
+    outColor = vec4(color * light * mix(0.5f, 1.0f, occlusion), 1.0f);
+}
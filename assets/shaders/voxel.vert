@@ -0,0 +1,40 @@
+#version 450 core
+
+// The layout of voxels::PackedVertex.
+layout(location = 0) in uvec2 inVertex;
+// The minimum corner of the section in xyz and the level of detail in w, one per draw of the mesh arena.
+layout(location = 1) in ivec4 inSectionOrigin;
+
+out vec3 normal;
+out vec2 textureCoords;
+out float occlusion;
+flat out uint material;
+
+uniform mat4 model;
+
+// The per frame data shared by every pipeline, see renderer::opengl::FrameUniforms.
+layout(std140, binding = 0) uniform Frame {
+    mat4 projectionView;
+    vec3 cameraWorldPos;
+};
+
+const vec3 NORMALS[6] = vec3[](
+    vec3(1, 0, 0), vec3(-1, 0, 0),
+    vec3(0, 1, 0), vec3(0, -1, 0),
+    vec3(0, 0, 1), vec3(0, 0, -1)
+);
+
+void main() {
+    // A coarser level of detail meshes cells of 2^level voxels.
+    vec3 position = vec3(inVertex.x & 63u, (inVertex.x >> 6) & 63u, (inVertex.x >> 12) & 63u) * float(1 << inSectionOrigin.w);
+    uint normalIndex = (inVertex.x >> 18) & 7u;
+
+    normal = NORMALS[normalIndex];
+    // The two axes of the face plane, so a texture repeats once per voxel across merged faces.
+    uint axis = normalIndex / 2u;
+    textureCoords = vec2(position[(axis + 1u) % 3u], position[(axis + 2u) % 3u]);
+    occlusion = float((inVertex.x >> 21) & 3u) / 3.0f;
+    material = inVertex.y;
+
+    gl_Position = projectionView * model * vec4(position + vec3(inSectionOrigin.xyz), 1.0f);
+}
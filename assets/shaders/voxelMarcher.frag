@@ -1,4 +1,4 @@
-#version 460 core
+#version 450 core
 
 in vec2 textureCoords;
 in vec3 localPos;
@@ -6,9 +6,14 @@ in mat4 invModel;
 
 out vec4 outColor;
 
-uniform vec3 cameraWorldPos;
 uniform usampler2D uTexture;
 
+// The per frame data shared by every pipeline, see renderer::opengl::FrameUniforms.
+layout(std140, binding = 0) uniform Frame {
+    mat4 projectionView;
+    vec3 cameraWorldPos;
+};
+
 #define MAX_STEPS 256
 #define CHUNK_SIZE 32
 #define MINIMUM_DISTANCE 1.0f / (CHUNK_SIZE * 2.0f)
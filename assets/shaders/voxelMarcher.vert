@@ -1,4 +1,4 @@
-#version 460 core
+#version 450 core
 
 layout(location = 0) in vec3 inPos;
 layout(location = 1) in vec2 inTexCoords;
@@ -8,7 +8,12 @@ out vec3 localPos;
 out mat4 invModel;
 
 uniform mat4 model;
-uniform mat4 projectionView;
+
+// The per frame data shared by every pipeline, see renderer::opengl::FrameUniforms.
+layout(std140, binding = 0) uniform Frame {
+    mat4 projectionView;
+    vec3 cameraWorldPos;
+};
 
 void main() {
     vec4 worldPos = model * vec4(inPos, 1.0f);
@@ -0,0 +1,129 @@
+/**
+ * @file AssetBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the file reading and mesh loading benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "File.hpp"
+#include "Utilities/MeshLoading.hpp"
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+    /// @brief How many times each benchmark is repeated, enough for a 99th percentile.
+    constexpr uint32 REPETITIONS = 100;
+    /// @brief How many times the large file and mesh benchmarks are repeated.
+    constexpr uint32 LARGE_REPETITIONS = 10;
+    /// @brief The size of a small file, about a shader.
+    constexpr size_t SMALL_FILE_SIZE = 4 * 1024;
+    /// @brief The size of a large file.
+    constexpr size_t LARGE_FILE_SIZE = 16 * 1024 * 1024;
+    /// @brief The number of quads per side of the generated grid mesh.
+    constexpr uint32 GRID_LENGTH = 128;
+
+    /**
+     * @brief Drops everything written to std::cout while it lives, the obj loader prints its progress.
+     */
+    class SilenceOutput {
+    public:
+        SilenceOutput() noexcept : m_buffer(std::cout.rdbuf(nullptr)) {  }
+        ~SilenceOutput() noexcept {
+            std::cout.rdbuf(m_buffer);
+            std::cout.clear();
+        }
+
+        SilenceOutput(const SilenceOutput&) = delete;
+        SilenceOutput& operator=(const SilenceOutput&) = delete;
+
+    private:
+        std::streambuf* m_buffer; //< The buffer that is restored.
+    };
+
+    /**
+     * @brief Replaces the file with the content.
+     */
+    void writeFile(const std::filesystem::path& path, std::string_view content) {
+        std::filesystem::remove(path);
+        voxels::createAndWrite(path.string()).writeContent(content);
+    }
+
+    /**
+     * @brief Returns deterministic text of the size, so every run reads the same bytes.
+     */
+    [[nodiscard]] std::string createText(size_t size) {
+        std::string text(size, ' ');
+        for(size_t i = 0; i < size; ++i) {
+            text[i] = i % 64 == 63 ? '\n' : static_cast<char>('a' + i % 26);
+        }
+        return text;
+    }
+
+    /**
+     * @brief Returns an obj file of a flat grid with texture coordinates.
+     *
+     * @param length The number of quads per side.
+     */
+    [[nodiscard]] std::string createGridObj(uint32 length) {
+        std::ostringstream obj;
+        obj << "o grid\n";
+        for(uint32 z = 0; z <= length; ++z) {
+            for(uint32 x = 0; x <= length; ++x) {
+                obj << "v " << x << " 0 " << z << '\n';
+                obj << "vt " << static_cast<float32>(x) / length << ' ' << static_cast<float32>(z) / length << '\n';
+            }
+        }
+        obj << "vn 0 1 0\n";
+        for(uint32 z = 0; z < length; ++z) {
+            for(uint32 x = 0; x < length; ++x) {
+                auto corner = z * (length + 1) + x + 1;
+                auto above = corner + length + 1;
+                obj << "f " << corner << '/' << corner << "/1 " << above << '/' << above << "/1 "
+                    << above + 1 << '/' << above + 1 << "/1 " << corner + 1 << '/' << corner + 1 << "/1\n";
+            }
+        }
+        return obj.str();
+    }
+}
+
+void bench::runAssetBenchmarks() {
+    auto directory = std::filesystem::temp_directory_path();
+    auto smallPath = directory / "voxels_bench_small.txt";
+    auto largePath = directory / "voxels_bench_large.txt";
+    auto cubePath = directory / "voxels_bench_cube.obj";
+    auto gridPath = directory / "voxels_bench_grid.obj";
+    writeFile(smallPath, createText(SMALL_FILE_SIZE));
+    writeFile(largePath, createText(LARGE_FILE_SIZE));
+    writeFile(cubePath, createGridObj(1));
+    writeFile(gridPath, createGridObj(GRID_LENGTH));
+
+    run("FileReader::readContent (4 KiB)", REPETITIONS, SMALL_FILE_SIZE, [&] {
+        auto content = voxels::openForReading(smallPath.string()).readContent().get();
+        doNotOptimize(content);
+    });
+    run("FileReader::readContent (16 MiB)", LARGE_REPETITIONS, LARGE_FILE_SIZE, [&] {
+        auto content = voxels::openForReading(largePath.string()).readContent().get();
+        doNotOptimize(content);
+    });
+
+    run("loadMeshes (1 quad)", REPETITIONS, 4, [&] {
+        const SilenceOutput silence;
+        auto meshes = voxels::loadMeshes(cubePath);
+        doNotOptimize(meshes);
+    });
+    uint64 vertexCount = 0;
+    run("loadMeshes (" + std::to_string(GRID_LENGTH) + "^2 quad grid)", LARGE_REPETITIONS, uint64(GRID_LENGTH) * GRID_LENGTH * 4, [&] {
+        const SilenceOutput silence;
+        auto meshes = voxels::loadMeshes(gridPath);
+        vertexCount = meshes.empty() ? 0 : meshes.front().vertices.size();
+        doNotOptimize(meshes);
+    });
+    report("loadMeshes grid vertices", static_cast<float64>(vertexCount), "vertices");
+
+    for(const auto& path : { smallPath, largePath, cubePath, gridPath }) {
+        std::filesystem::remove(path);
+    }
+}
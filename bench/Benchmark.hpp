@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Global.hpp"
+#include <algorithm> // For sorting the samples.
+#include <chrono> // For timing.
+#include <cmath> // For the percentile rank.
+#include <iomanip> // For formatting the output.
+#include <iostream> // For printing the results.
+#include <ostream> // For writing the JSON.
+#include <string> // For the benchmark names.
+#include <string_view> // For the benchmark names.
+#include <vector> // For the samples.
+
+namespace bench {
+    /**
+     * @brief The result of a single benchmark.
+     */
+    struct Result {
+        std::string name; //< The benchmark name.
+        float64 median; //< The median duration of a repetition in seconds.
+        float64 min; //< The fastest repetition in seconds.
+        float64 p99; //< The 99th percentile of the repetitions in seconds, the slowest one below 100 repetitions.
+        uint32 repetitions; //< How many times the benchmark ran.
+        uint64 items; //< The number of items processed per repetition.
+    };
+
+    /**
+     * @brief A named measurement that is not a timing.
+     */
+    struct Measurement {
+        std::string name; //< The measurement name.
+        float64 value; //< The measured value.
+        std::string unit; //< The unit of the value.
+    };
+
+    /**
+     * @brief Everything the benchmarks measured in this run.
+     */
+    struct Results {
+        std::vector<Result> benchmarks; //< The timings in the order they ran.
+        std::vector<Measurement> measurements; //< The other measurements in the order they were reported.
+        std::vector<std::string> failures; //< The names of the correctness checks that failed.
+    };
+
+    /**
+     * @brief Returns the results of this run, run and report append to them.
+     */
+    [[nodiscard]] inline Results& getResults() noexcept {
+        static Results results;
+        return results;
+    }
+
+    /**
+     * @brief Prevents the compiler from optimizing away a value.
+     * 
+     * @param value The value to keep alive.
+     */
+    template<typename T>
+    inline void doNotOptimize(const T& value) noexcept {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * @brief Prints the benchmark result.
+     * 
+     * @param result The result to print.
+     */
+    inline void print(const Result& result) {
+        std::cout << std::left << std::setw(40) << result.name
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(12) << result.median * 1000.0 << " ms"
+            << std::setw(12) << result.min * 1000.0 << " ms (min)";
+        if(result.items > 0) {
+            std::cout << std::setw(12) << static_cast<float64>(result.items) / result.median / 1'000'000.0 << " M items/s";
+        }
+        std::cout << '\n';
+    }
+
+    /**
+     * @brief Prints a named measurement that is not a timing, like a memory usage.
+     * 
+     * @param name The name of the measurement.
+     * @param value The measured value.
+     * @param unit The unit of the value.
+     */
+    inline void report(std::string_view name, float64 value, std::string_view unit) {
+        getResults().measurements.push_back({ std::string(name), value, std::string(unit) });
+        std::cout << std::left << std::setw(40) << name
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(12) << value << ' ' << unit << '\n';
+    }
+
+    /**
+     * @brief Records a correctness check of a benchmark, a failed one makes voxels_bench exit with an error.
+     *
+     * @param name What was checked.
+     * @param passed Whether the check passed.
+     * @return bool passed.
+     */
+    inline bool check(std::string_view name, bool passed) {
+        if(!passed)
+            getResults().failures.emplace_back(name);
+        std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << (passed ? "ok" : "FAILED") << '\n';
+        return passed;
+    }
+
+    /**
+     * @brief Runs the function multiple times and prints the timings.
+     * 
+     * @param name The benchmark name.
+     * @param repetitions How many times to run the function.
+     * @param items How many items the function processes per call, used for the throughput.
+     * @param function The function to benchmark.
+     * @return Result The benchmark result.
+     */
+    template<typename F>
+    Result run(std::string_view name, uint32 repetitions, uint64 items, F&& function) {
+        std::vector<float64> samples;
+        samples.reserve(repetitions);
+
+        for(uint32 i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<float64>(end - start).count());
+        }
+
+        std::ranges::sort(samples);
+        // The nearest rank, the smallest sample that is at least as slow as 99 percent of them.
+        auto p99 = static_cast<size_t>(std::ceil(0.99 * static_cast<float64>(samples.size()))) - 1;
+        auto result = Result { std::string(name), samples[samples.size() / 2], samples.front(), samples[p99], repetitions, items };
+        print(result);
+        getResults().benchmarks.push_back(result);
+        return result;
+    }
+
+    /**
+     * @brief Writes the string as a JSON string.
+     */
+    inline void writeJsonString(std::ostream& stream, std::string_view string) {
+        stream << '"';
+        for(auto character : string) {
+            if(character == '"' || character == '\\')
+                stream << '\\' << character;
+            else if(static_cast<unsigned char>(character) < 0x20)
+                stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int32>(character) << std::dec << std::setfill(' ');
+            else
+                stream << character;
+        }
+        stream << '"';
+    }
+
+    /**
+     * @brief Writes the results as JSON, the timings in milliseconds.
+     *
+     * @param stream The stream to write to.
+     * @param results The results to write.
+     */
+    inline void writeJson(std::ostream& stream, const Results& results) {
+        stream << std::fixed << std::setprecision(6) << "{\n  \"benchmarks\": [";
+        for(size_t i = 0; i < results.benchmarks.size(); ++i) {
+            const auto& result = results.benchmarks[i];
+            stream << (i == 0 ? "\n" : ",\n") << "    { \"name\": ";
+            writeJsonString(stream, result.name);
+            stream << ", \"median_ms\": " << result.median * 1000.0
+                << ", \"p99_ms\": " << result.p99 * 1000.0
+                << ", \"min_ms\": " << result.min * 1000.0
+                << ", \"repetitions\": " << result.repetitions
+                << ", \"items\": " << result.items << " }";
+        }
+        stream << "\n  ],\n  \"measurements\": [";
+        for(size_t i = 0; i < results.measurements.size(); ++i) {
+            const auto& measurement = results.measurements[i];
+            stream << (i == 0 ? "\n" : ",\n") << "    { \"name\": ";
+            writeJsonString(stream, measurement.name);
+            // JSON has no infinity or NaN.
+            stream << ", \"value\": ";
+            if(std::isfinite(measurement.value))
+                stream << measurement.value;
+            else
+                stream << "null";
+            stream << ", \"unit\": ";
+            writeJsonString(stream, measurement.unit);
+            stream << " }";
+        }
+        stream << "\n  ]\n}\n";
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace bench {
+    /// @brief Compares the pointer based and the linear oct tree.
+    void runOctTreeBenchmarks();
+    /// @brief Compares the oct tree ray cast with a voxel by voxel traversal.
+    void runOctTreeRaycastBenchmarks();
+    /// @brief Measures the sparse voxel DAG compression and queries.
+    void runOctTreeDagBenchmarks();
+    /// @brief Compares the palette compressed voxel storage with a dense array.
+    void runPaletteStorageBenchmarks();
+    /// @brief Measures how the job system scales with the number of workers.
+    void runJobSystemBenchmarks();
+    /// @brief Measures the greedy mesher on terrain and on the worst case.
+    void runChunkMesherBenchmarks();
+    /// @brief Measures the ray throughput of the CPU ray marcher.
+    void runCpuRendererBenchmarks();
+    /// @brief Compares reallocating buffer uploads with the persistently mapped ring.
+    void runStreamBufferBenchmarks();
+    /// @brief Compares a draw call per section with the multi draw of the mesh arena.
+    void runMeshArenaBenchmarks();
+    /// @brief Measures the frustum and occlusion culling of the sections.
+    void runCullingBenchmarks();
+    /// @brief Compares looking uniforms up by name with the cached locations and the frame uniform buffer.
+    void runPipelineBenchmarks();
+    /// @brief Compares compiling the pipelines in order with the pipeline cache with and without program binaries.
+    void runPipelineCacheBenchmarks();
+    /// @brief Compares binding and unbinding around every use with the state cache and direct state access.
+    void runStateCacheBenchmarks();
+    /// @brief Measures the cost of the profiler zones, the trace and the GPU timer queries.
+    void runProfilerBenchmarks();
+    /// @brief Measures the observer dispatch and the event parsing of a busy frame.
+    void runEventBenchmarks();
+    /// @brief Measures reading files and loading obj meshes.
+    void runAssetBenchmarks();
+    /// @brief Measures the frame time of the OpenGl renderer on a headless surface.
+    void runRendererBenchmarks();
+}
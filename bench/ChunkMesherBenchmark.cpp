@@ -0,0 +1,157 @@
+/**
+ * @file ChunkMesherBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the greedy mesher benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "World/ChunkMesher.hpp"
+#include "World/Remesher.hpp"
+#include "World/TerrainGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The number of voxels in a section.
+    constexpr uint64 SECTION_VOLUME = static_cast<uint64>(world::SECTION_LENGTH) * world::SECTION_LENGTH * world::SECTION_LENGTH;
+
+    /**
+     * @brief Meshes every section in the list and reports the voxel throughput and the triangle reduction.
+     */
+    void runSections(const std::string& name, const world::World& world, const world::Chunk& chunk, const std::vector<glm::uvec3>& sections) {
+        auto mesher = world::ChunkMesher();
+        uint64 triangles = 0, naiveTriangles = 0;
+        size_t bytes = 0, packedBytes = 0;
+        for(auto section : sections) {
+            for(const auto& mesh : mesher.mesh(world, chunk, section)) {
+                triangles += mesh.mesh.getIndexCount() / 3;
+                bytes += mesh.mesh.getSize();
+            }
+            // Packed meshes share one index buffer, so only their vertices count.
+            packedBytes += mesher.meshPacked(world, chunk, section).getSize();
+            // A naive mesher emits the twelve triangles of every solid voxel.
+            auto min = section * world::SECTION_LENGTH;
+            for(uint32 x = min.x; x < min.x + world::SECTION_LENGTH; ++x) {
+                for(uint32 y = min.y; y < min.y + world::SECTION_LENGTH; ++y) {
+                    for(uint32 z = min.z; z < min.z + world::SECTION_LENGTH; ++z) {
+                        naiveTriangles += chunk.get({ x, y, z }) != world::AIR ? 12 : 0;
+                    }
+                }
+            }
+        }
+
+        bench::run("ChunkMesher::mesh (" + name + ")", REPETITIONS, SECTION_VOLUME * sections.size(), [&] {
+            for(auto section : sections) {
+                bench::doNotOptimize(mesher.mesh(world, chunk, section));
+            }
+        });
+        bench::run("ChunkMesher::meshPacked (" + name + ")", REPETITIONS, SECTION_VOLUME * sections.size(), [&] {
+            for(auto section : sections) {
+                bench::doNotOptimize(mesher.meshPacked(world, chunk, section));
+            }
+        });
+        bench::report("ChunkMesher triangles (" + name + ")", static_cast<float64>(triangles), "triangles");
+        bench::report("ChunkMesher mesh size (" + name + ")", bytes / 1024.0, "KiB");
+        bench::report("ChunkMesher packed mesh size (" + name + ")", packedBytes / 1024.0, "KiB");
+        bench::report("ChunkMesher naive / greedy (" + name + ")", static_cast<float64>(naiveTriangles) / std::max<uint64>(triangles, 1), "x");
+    }
+
+    /**
+     * @brief Meshes the whole chunk at every level of detail and reports the time and the vertex count.
+     */
+    void runLevels(const world::World& world, const world::Chunk& chunk) {
+        auto mesher = world::ChunkMesher();
+        for(uint32 level = 0; level <= world::MAX_LEVEL_OF_DETAIL; ++level) {
+            auto nodesPerAxis = world::SECTIONS_PER_AXIS >> level;
+            size_t vertices = 0;
+            bench::run("ChunkMesher chunk at level " + std::to_string(level), REPETITIONS, SECTION_VOLUME * world::SECTIONS_PER_AXIS * world::SECTIONS_PER_AXIS * world::SECTIONS_PER_AXIS, [&] {
+                vertices = 0;
+                for(uint32 x = 0; x < nodesPerAxis; ++x) {
+                    for(uint32 y = 0; y < nodesPerAxis; ++y) {
+                        for(uint32 z = 0; z < nodesPerAxis; ++z) {
+                            auto mesh = level == 0 ? mesher.meshPacked(world, chunk, { x, y, z }) : mesher.meshPackedLevel(chunk, { x, y, z }, level);
+                            vertices += mesh.vertices.size();
+                            bench::doNotOptimize(mesh);
+                        }
+                    }
+                }
+            });
+            bench::report("ChunkMesher chunk vertices at level " + std::to_string(level), static_cast<float64>(vertices), "vertices");
+        }
+    }
+
+    /**
+     * @brief Runs updates until the remesher has swapped in every dirty section.
+     */
+    void remeshAll(world::Remesher& remesher, const voxels::CameraDescriptor& camera) {
+        do {
+            remesher.update(camera);
+            remesher.wait();
+        } while(!remesher.isIdle());
+    }
+
+    /**
+     * @brief Toggles the voxel and measures the time until its sections are remeshed and swapped in.
+     *
+     * @note The update that submits the batch is what a frame pays, it is reported separately.
+     */
+    void runEdit(const std::string& name, world::World& world, world::Remesher& remesher, glm::ivec3 position) {
+        auto camera = voxels::CameraDescriptor(glm::vec3(position), glm::vec3(0.0f, 0.0f, -1.0f), 1.0f);
+        bool solid = false;
+        size_t processed = 0;
+        std::vector<float64> submits;
+        bench::run("Remesher edit to swap (" + name + ")", REPETITIONS * 20, 0, [&] {
+            solid = !solid;
+            world.setVoxel(position, solid ? world::Stone : world::AIR);
+            auto start = std::chrono::steady_clock::now();
+            remesher.update(camera);
+            submits.push_back(std::chrono::duration<float64, std::milli>(std::chrono::steady_clock::now() - start).count());
+            remesher.wait();
+            remesher.update(camera);
+            processed = remesher.getProcessedCount();
+        });
+        std::ranges::sort(submits);
+        bench::report("Remesher::update submit (" + name + ")", submits[submits.size() / 2], "ms");
+        bench::report("Remesher sections per edit (" + name + ")", static_cast<float64>(processed), "sections");
+    }
+}
+
+void bench::runChunkMesherBenchmarks() {
+    auto world = world::World();
+
+    // Typical terrain, the sections of a surface chunk that hold the surface.
+    auto& terrain = world.loadChunk({ 0, 0, 0 });
+    world::generateTerrain(terrain);
+    world::generateTerrain(world.loadChunk({ 0, -1, 0 }));
+    std::vector<glm::uvec3> surface;
+    for(uint32 x = 0; x < world::SECTIONS_PER_AXIS; ++x) {
+        for(uint32 z = 0; z < world::SECTIONS_PER_AXIS; ++z) {
+            surface.emplace_back(x, 0, z);
+        }
+    }
+    runSections("terrain", world, terrain, surface);
+    runLevels(world, terrain);
+
+    // The worst case, every other voxel is solid so no face can be culled or merged.
+    auto& checkerboard = world.loadChunk({ 4, 0, 0 });
+    for(uint32 x = 0; x < world::SECTION_LENGTH; ++x) {
+        for(uint32 y = 0; y < world::SECTION_LENGTH; ++y) {
+            for(uint32 z = 0; z < world::SECTION_LENGTH; ++z) {
+                if((x + y + z) % 2)
+                    checkerboard.set({ x, y, z }, world::Stone + x % 3);
+            }
+        }
+    }
+    runSections("checkerboard", world, checkerboard, { glm::uvec3(0) });
+
+    // Mesh everything once, afterwards an edit only remeshes the sections whose meshes can see the voxel.
+    auto remesher = world::Remesher(world, { .maxSectionsPerUpdate = world.getDirtySectionCount() });
+    bench::run("Remesher full remesh", 1, 0, [&] { remeshAll(remesher, voxels::CameraDescriptor(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 1.0f)); });
+    runEdit("interior edit", world, remesher, glm::ivec3(world::SECTION_LENGTH / 2));
+    runEdit("corner edit", world, remesher, glm::ivec3(world::SECTION_LENGTH, 0, world::SECTION_LENGTH));
+}
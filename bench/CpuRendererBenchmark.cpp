@@ -0,0 +1,65 @@
+/**
+ * @file CpuRendererBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the CPU ray marcher throughput benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Renderer/Cpu/Renderer.hpp"
+#include "World/TerrainGenerator.hpp"
+#include "geometric.hpp"
+#include "trigonometric.hpp"
+#include <string>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The width and height of the rendered frames.
+    constexpr uint32 FRAME_LENGTH = 256;
+    /// @brief The number of rays per frame.
+    constexpr uint64 RAY_COUNT = static_cast<uint64>(FRAME_LENGTH) * FRAME_LENGTH;
+
+    /// @brief A camera above the terrain looking over the hills, so rays both hit close and travel far.
+    const auto CAMERA = voxels::CameraDescriptor({ 0.0f, 30.0f, 60.0f }, glm::normalize(glm::vec3(0.0f, -0.3f, -1.0f)), 1.0f);
+}
+
+void bench::runCpuRendererBenchmarks() {
+    auto world = world::World();
+    for(int32 x = -1; x <= 0; ++x) {
+        for(int32 y = -1; y <= 0; ++y) {
+            for(int32 z = -1; z <= 0; ++z) {
+                world::generateTerrain(world.loadChunk({ x, y, z }));
+            }
+        }
+    }
+
+    // The same rays the renderer traces, one at a time on a single thread.
+    auto halfHeight = glm::tan(CAMERA.fieldOfView * 0.5f);
+    auto right = glm::normalize(glm::cross(CAMERA.direction, voxels::CameraDescriptor::UP)) * halfHeight;
+    auto up = glm::cross(glm::normalize(right), CAMERA.direction) * halfHeight;
+    bench::run("cpu::Renderer::traceRay single rays", REPETITIONS, RAY_COUNT, [&] {
+        for(uint32 y = 0; y < FRAME_LENGTH; ++y) {
+            for(uint32 x = 0; x < FRAME_LENGTH; ++x) {
+                auto ndcX = 2.0f * (static_cast<float32>(x) + 0.5f) / FRAME_LENGTH - 1.0f;
+                auto ndcY = 1.0f - 2.0f * (static_cast<float32>(y) + 0.5f) / FRAME_LENGTH;
+                auto direction = glm::normalize(CAMERA.direction + right * ndcX + up * ndcY);
+                bench::doNotOptimize(renderer::cpu::Renderer::traceRay(world, CAMERA.position, direction, renderer::cpu::RendererDescriptor().maxDistance));
+            }
+        }
+    });
+
+    auto maxWorkers = std::max(std::thread::hardware_concurrency(), 4u);
+    for(uint32 workers = 1; workers <= maxWorkers; workers *= 2) {
+        auto system = jobs::JobSystem(workers);
+        auto packets = renderer::cpu::Renderer(world, FRAME_LENGTH, FRAME_LENGTH, {}, system);
+        auto suffix = " (" + std::to_string(workers) + " workers)";
+        auto name = "cpu::Renderer::render" + suffix;
+
+        auto result = bench::run(name, REPETITIONS, RAY_COUNT, [&] {
+            packets.render(CAMERA);
+        });
+        bench::report("cpu::Renderer rays" + suffix, static_cast<float64>(RAY_COUNT) / result.median / 1'000'000.0, "Mrays/s");
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file CullingBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the section culling benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "CameraDescriptor.hpp"
+#include "Renderer/Culling.hpp"
+#include "ext/matrix_clip_space.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 9;
+    /// @brief The number of culls per repetition.
+    constexpr uint32 FRAMES = 20;
+    /// @brief The number of section columns along the x and z axes of the scene.
+    constexpr int32 SCENE_LENGTH = 128;
+    /// @brief The length of a section.
+    constexpr float32 SECTION_LENGTH = 32.0f;
+
+    /**
+     * @brief Returns the height of the terrain surface in sections, rolling hills.
+     */
+    [[nodiscard]] int32 getSurface(int32 x, int32 z) noexcept {
+        return static_cast<int32>(3.0f + 2.0f * std::sin(static_cast<float32>(x) * 0.3f) + 2.0f * std::cos(static_cast<float32>(z) * 0.2f));
+    }
+
+    [[nodiscard]] renderer::Aabb getBounds(int32 x, int32 y, int32 z) noexcept {
+        auto min = glm::vec3(x, y, z) * SECTION_LENGTH;
+        return { min, min + SECTION_LENGTH };
+    }
+}
+
+void bench::runCullingBenchmarks() {
+    // The two sections below the surface carry the meshes, everything below the surface is solid.
+    std::vector<renderer::Aabb> boxes, occluders;
+    for(int32 x = -SCENE_LENGTH / 2; x < SCENE_LENGTH / 2; ++x) {
+        for(int32 z = -SCENE_LENGTH / 2; z < SCENE_LENGTH / 2; ++z) {
+            auto surface = getSurface(x, z);
+            boxes.push_back(getBounds(x, surface, z));
+            boxes.push_back(getBounds(x, surface - 1, z));
+            for(int32 y = 0; y < surface; ++y) {
+                occluders.push_back(getBounds(x, y, z));
+            }
+        }
+    }
+
+    // The renderer gathers the sections from a hash map, so neighbouring boxes are not next to each other.
+    auto random = std::mt19937(42);
+    std::ranges::shuffle(boxes, random);
+    std::ranges::shuffle(occluders, random);
+
+    // Standing in a valley, looking across the hills.
+    auto camera = voxels::CameraDescriptor({ 0.0f, 4.5f * SECTION_LENGTH, 0.0f }, glm::normalize(glm::vec3(0.3f, -0.05f, -1.0f)), 1.2f);
+    auto projectionView = glm::perspectiveFov(camera.fieldOfView, 16.0f, 9.0f, 0.1f, 4096.0f) * camera.constructViewMatrix();
+    std::vector<uint32> visible;
+
+    auto scalar = renderer::Frustum::fromMatrix(projectionView);
+    bench::run("Frustum::intersects per box", REPETITIONS, FRAMES * boxes.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            visible.clear();
+            for(size_t i = 0; i < boxes.size(); ++i) {
+                if(scalar.intersects(boxes[i]))
+                    visible.push_back(static_cast<uint32>(i));
+            }
+            bench::doNotOptimize(visible.data());
+        }
+    });
+
+    auto frustumCuller = renderer::Culler({ .occlusion = false });
+    bench::run("Culler frustum (structure of arrays)", REPETITIONS, FRAMES * boxes.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            frustumCuller.cull(projectionView, boxes, occluders, visible);
+            bench::doNotOptimize(visible.data());
+        }
+    });
+    const auto& frustum = frustumCuller.getStatistics();
+    bench::report("Culler frustum visible", static_cast<float64>(frustum.visible), "sections");
+    bench::report("Culler frustum culled", static_cast<float64>(frustum.frustumCulled), "sections");
+
+    auto occlusionCuller = renderer::Culler();
+    bench::run("Culler frustum and occlusion", REPETITIONS, FRAMES * boxes.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            occlusionCuller.cull(projectionView, boxes, occluders, visible);
+            bench::doNotOptimize(visible.data());
+        }
+    });
+    const auto& occlusion = occlusionCuller.getStatistics();
+    bench::report("Culler occlusion visible", static_cast<float64>(occlusion.visible), "sections");
+    bench::report("Culler occlusion culled", static_cast<float64>(occlusion.occlusionCulled), "sections");
+    bench::report("Culler occlusion occluders", static_cast<float64>(occlusion.occluders), "boxes");
+    bench::report("Culler occlusion frustum time", occlusion.frustumMilliseconds, "ms");
+    bench::report("Culler occlusion occlusion time", occlusion.occlusionMilliseconds, "ms");
+}
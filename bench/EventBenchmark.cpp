@@ -0,0 +1,73 @@
+/**
+ * @file EventBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the observer dispatch and event parsing benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "Observer.hpp"
+#include "Window/EventParser.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated, enough for a 99th percentile.
+    constexpr uint32 REPETITIONS = 200;
+    /// @brief How many events are emitted or parsed per repetition.
+    constexpr uint32 EVENT_COUNT = 10'000;
+
+    /**
+     * @brief Builds the events of a busy frame, mostly mouse motion with some keys, buttons and scrolling.
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<wnd::IEvent>> createEvents() {
+        std::vector<std::unique_ptr<wnd::IEvent>> events;
+        events.reserve(EVENT_COUNT);
+        for(uint32 i = 0; i < EVENT_COUNT; ++i) {
+            auto state = (i / 16) % 2 == 0 ? wnd::ButtonState::Pressed : wnd::ButtonState::Released;
+            switch(i % 16) {
+                case 0: events.push_back(std::make_unique<wnd::KeyboardEvent>(wnd::Key::KeyW, state)); break;
+                case 1: events.push_back(std::make_unique<wnd::KeyboardEvent>(wnd::Key::LeftShift, state)); break;
+                case 2: events.push_back(std::make_unique<wnd::MouseButtonEvent>(wnd::MouseButtonEvent::Button::Left, state)); break;
+                case 3: events.push_back(std::make_unique<wnd::ScrollEvent>(static_cast<int8>(state == wnd::ButtonState::Pressed ? 1 : -1))); break;
+                case 4: events.push_back(std::make_unique<wnd::FocusEvent>(true)); break;
+                default: events.push_back(std::make_unique<wnd::MouseMotionEvent>(static_cast<int32>(i % 640), static_cast<int32>(i % 480))); break;
+            }
+        }
+        return events;
+    }
+}
+
+void bench::runEventBenchmarks() {
+    // Emitting to more observers shows the cost of the list walk and the std::function calls.
+    for(uint32 observerCount : { 1u, 16u }) {
+        auto emitter = std::make_shared<voxels::Emitter<int32, int32>>();
+        int64 sum = 0;
+        std::vector<std::unique_ptr<voxels::Observer<int32, int32>>> observers;
+        for(uint32 i = 0; i < observerCount; ++i) {
+            observers.push_back(std::make_unique<voxels::Observer<int32, int32>>(emitter, [&sum](int32 x, int32 y) { sum += x - y; }));
+        }
+
+        run("Emitter::emit (" + std::to_string(observerCount) + " observers)", REPETITIONS, EVENT_COUNT, [&] {
+            for(uint32 i = 0; i < EVENT_COUNT; ++i) {
+                emitter->emit(static_cast<int32>(i), 1);
+            }
+            doNotOptimize(sum);
+        });
+    }
+
+    // The parser with the observers the application attaches, the camera listens to the mouse motion.
+    auto events = createEvents();
+    auto parser = wnd::EventParser();
+    int64 moved = 0;
+    auto motionObserver = voxels::Observer<int32, int32>(parser.MouseMoved, [&moved](int32 x, int32 y) { moved += x + y; });
+    auto scrollObserver = voxels::Observer<const wnd::ScrollEvent&>(parser.CursorScrolled, [&moved](const wnd::ScrollEvent& event) { moved += event.getDelta(); });
+    run("EventParser::parseEvent", REPETITIONS, EVENT_COUNT, [&] {
+        for(const auto& event : events) {
+            parser.parseEvent(*event);
+        }
+        parser.onLoopEnded();
+        doNotOptimize(moved);
+    });
+}
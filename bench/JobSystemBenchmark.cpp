@@ -0,0 +1,66 @@
+/**
+ * @file JobSystemBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the job system scaling benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "PaletteStorage.hpp"
+#include "trigonometric.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief How many small chunks are generated per repetition.
+    constexpr uint32 CHUNK_COUNT = 64;
+    /// @brief The length of the generated chunks.
+    constexpr uint32 SMALL_CHUNK_LENGTH = 64;
+    /// @brief How many empty jobs are submitted per repetition.
+    constexpr uint32 EMPTY_JOB_COUNT = 100'000;
+
+    /**
+     * @brief Fills the storage with a height field, a stand in for chunk generation.
+     *
+     * @param storage The storage to fill.
+     * @param seed Offsets the height field.
+     */
+    void generate(voxels::PaletteStorage<uint32, SMALL_CHUNK_LENGTH>& storage, uint32 seed) {
+        for(uint32 x = 0; x < SMALL_CHUNK_LENGTH; ++x) {
+            for(uint32 z = 0; z < SMALL_CHUNK_LENGTH; ++z) {
+                auto height = static_cast<uint32>(SMALL_CHUNK_LENGTH / 2 + 16.0f * glm::sin((x + seed) * 0.1f) * glm::cos(z * 0.07f));
+                storage.fill(1u, { x, 0, z }, { x + 1, height, z + 1 });
+                storage.fill(2u, { x, height, z }, { x + 1, height + 1, z + 1 });
+            }
+        }
+    }
+}
+
+void bench::runJobSystemBenchmarks() {
+    auto maxWorkers = std::max(std::thread::hardware_concurrency(), 4u);
+    for(uint32 workers = 1; workers <= maxWorkers; workers *= 2) {
+        auto system = jobs::JobSystem(workers);
+        auto suffix = " (" + std::to_string(workers) + " workers)";
+
+        run("JobSystem::parallelFor chunk generation" + suffix, REPETITIONS, CHUNK_COUNT, [&] {
+            system.parallelFor(CHUNK_COUNT, 1, [](size_t begin, size_t end) {
+                for(auto i = begin; i < end; ++i) {
+                    auto storage = voxels::PaletteStorage<uint32, SMALL_CHUNK_LENGTH>(0u);
+                    generate(storage, static_cast<uint32>(i));
+                    doNotOptimize(storage);
+                }
+            });
+        });
+
+        run("JobSystem::submit empty jobs" + suffix, REPETITIONS, EMPTY_JOB_COUNT, [&] {
+            jobs::Counter counter;
+            for(uint32 i = 0; i < EMPTY_JOB_COUNT; ++i) {
+                system.submit([] {}, &counter);
+            }
+            system.wait(counter);
+        });
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ * @file MeshArenaBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the draw submission benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "CameraDescriptor.hpp"
+#include "File.hpp"
+#include "OpenGlContext.hpp"
+#include "Renderer/OpenGl/FrameUniforms.hpp"
+#include "Renderer/OpenGl/MeshArena.hpp"
+#include "Renderer/OpenGl/Pipeline.hpp"
+#include "Renderer/OpenGl/StreamBuffer.hpp"
+#include "Renderer/OpenGl/VertexArray.hpp"
+#include "Renderer/OpenGl/VertexBufferAttributes.hpp"
+#include "World/ChunkMesher.hpp"
+#include "World/TerrainGenerator.hpp"
+#include "ext/matrix_clip_space.hpp"
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The number of frames per repetition.
+    constexpr uint32 FRAMES = 20;
+    /// @brief The number of sections along the x and z axes of the scene.
+    constexpr int32 SCENE_LENGTH = 64;
+    /// @brief The width and height of the framebuffer, small so the software rasterizer does not dominate.
+    constexpr GLsizei FRAMEBUFFER_LENGTH = 128;
+    /// @brief The voxel shaders, relative to the repository root.
+    constexpr const char* VERTEX_SHADER = "./assets/shaders/voxel.vert";
+    constexpr const char* FRAGMENT_SHADER = "./assets/shaders/voxel.frag";
+}
+
+void bench::runMeshArenaBenchmarks() {
+    auto context = OpenGlContext();
+    if(!context.isValid()) {
+        bench::report("MeshArena (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+    if(!std::filesystem::exists(VERTEX_SHADER) || !std::filesystem::exists(FRAGMENT_SHADER)) {
+        bench::report("MeshArena (run from the repository root, skipped)", 0.0, "");
+        return;
+    }
+    // Pipelines are not movable, so it is constructed in place.
+    auto pipeline = renderer::opengl::Pipeline::linkShaders(
+        renderer::opengl::Shader::compileFromSource(voxels::openForReading(VERTEX_SHADER).readContent().get(), renderer::ShaderType::Vertex),
+        renderer::opengl::Shader::compileFromSource(voxels::openForReading(FRAGMENT_SHADER).readContent().get(), renderer::ShaderType::Fragment)
+    );
+
+    GLuint framebuffer, renderbuffers[2];
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(2, renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, FRAMEBUFFER_LENGTH, FRAMEBUFFER_LENGTH);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, FRAMEBUFFER_LENGTH, FRAMEBUFFER_LENGTH);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+    glViewport(0, 0, FRAMEBUFFER_LENGTH, FRAMEBUFFER_LENGTH);
+    glEnable(GL_DEPTH_TEST);
+
+    // A wide field of small sections, like scattered blocks, where the per draw cost dominates.
+    auto world = world::World();
+    auto& chunk = world.loadChunk({ 0, 0, 0 });
+    chunk.fill(glm::uvec3(8), glm::uvec3(12), world::Stone);
+    auto mesh = world::ChunkMesher().meshPacked(world, chunk, glm::uvec3(0));
+
+    auto arena = renderer::opengl::MeshArena();
+    std::vector<glm::ivec3> sections;
+    for(int32 x = 0; x < SCENE_LENGTH; ++x) {
+        for(int32 z = 0; z < SCENE_LENGTH; ++z) {
+            sections.emplace_back(x - SCENE_LENGTH / 2, -1, -z);
+            arena.upload(sections.back(), mesh);
+        }
+    }
+
+    // The alternative, a vertex array per section with the origin as a constant attribute.
+    auto indices = voxels::getQuadIndices(static_cast<uint32>(mesh.vertices.size() / 4));
+    std::vector<std::unique_ptr<renderer::opengl::VertexArray>> vertexArrays;
+    for(size_t i = 0; i < sections.size(); ++i) {
+        auto& vertexArray = vertexArrays.emplace_back(std::make_unique<renderer::opengl::VertexArray>(
+            renderer::opengl::VertexBufferAttributes(voxels::PackedVertex::getAttributes())));
+        vertexArray->copyDataIntoVertexBuffer(mesh.vertices.data(), mesh.vertices.size() * sizeof(voxels::PackedVertex));
+        vertexArray->copyDataIntoIndexBuffer(indices.data(), indices.size() * sizeof(uint32));
+    }
+
+    auto camera = voxels::CameraDescriptor({ 0.0f, 40.0f, 40.0f }, glm::normalize(glm::vec3(0.0f, -0.5f, -1.0f)), 1.2f);
+    auto projectionView = glm::perspectiveFov(camera.fieldOfView, 1.0f, 1.0f, 0.1f, 4096.0f) * camera.constructViewMatrix();
+    auto frameUniforms = renderer::opengl::UniformStreamBuffer(1024);
+    auto frame = renderer::opengl::FrameUniforms { projectionView, glm::vec4(camera.position, 1.0f) };
+    auto uploaded = frameUniforms.upload(&frame, sizeof(frame), 256);
+    glBindBufferRange(GL_UNIFORM_BUFFER, renderer::opengl::FRAME_UNIFORMS_BINDING, frameUniforms.getId(), static_cast<GLintptr>(uploaded.offset), sizeof(frame));
+    pipeline.setUniform("model", glm::mat4(1.0f));
+    pipeline.bind();
+
+    size_t submissions = 0;
+    auto perSection = [&] {
+        submissions = 0;
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        for(size_t i = 0; i < sections.size(); ++i) {
+            vertexArrays[i]->bind();
+            auto origin = sections[i] * static_cast<int32>(world::SECTION_LENGTH);
+            glVertexAttribI4i(1, origin.x, origin.y, origin.z, 0);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
+            ++submissions;
+        }
+        glBindVertexArray(0);
+    };
+    auto multiDraw = [&] {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        arena.draw(sections);
+        submissions = arena.getSubmissionCount();
+    };
+
+    // Without rasterization only the submission and the vertex work remain.
+    glEnable(GL_RASTERIZER_DISCARD);
+    bench::run("glDrawElements per section (no raster)", REPETITIONS, FRAMES * sections.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            perSection();
+            glFinish();
+        }
+    });
+    glDisable(GL_RASTERIZER_DISCARD);
+    bench::run("glDrawElements per section (frame)", REPETITIONS, FRAMES * sections.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            perSection();
+            glFinish();
+        }
+    });
+    bench::report("glDrawElements per section submissions", static_cast<float64>(submissions), "calls");
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    bench::run("MeshArena::draw (no raster)", REPETITIONS, FRAMES * sections.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            multiDraw();
+            glFinish();
+        }
+    });
+    glDisable(GL_RASTERIZER_DISCARD);
+    bench::run("MeshArena::draw (frame)", REPETITIONS, FRAMES * sections.size(), [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            multiDraw();
+            glFinish();
+        }
+    });
+    bench::report("MeshArena::draw submissions", static_cast<float64>(submissions), "calls");
+
+    pipeline.unBind();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteRenderbuffers(2, renderbuffers);
+    glDeleteFramebuffers(1, &framebuffer);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file OctTreeBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the oct tree insert and traversal benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "LinearOctTree.hpp"
+#include "OctTree.hpp"
+#include <random>
+
+namespace {
+    /// @brief How many voxels get inserted per repetition.
+    constexpr uint32 INSERT_COUNT = 200'000;
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 7;
+
+    /**
+     * @brief Generates random voxel centers inside a tree centered at the origin.
+     *
+     * @param count The number of positions.
+     * @return std::vector<glm::vec3> The positions.
+     */
+    std::vector<glm::vec3> generatePositions(uint32 count) {
+        std::mt19937 engine(1337);
+        std::uniform_int_distribution<int32> distribution(-static_cast<int32>(CHUNK_LENGTH / 2), CHUNK_LENGTH / 2 - 1);
+
+        std::vector<glm::vec3> positions;
+        positions.reserve(count);
+        for(uint32 i = 0; i < count; ++i) {
+            positions.emplace_back(
+                distribution(engine) + 0.5f,
+                distribution(engine) + 0.5f,
+                distribution(engine) + 0.5f
+            );
+        }
+        return positions;
+    }
+}
+
+void bench::runOctTreeBenchmarks() {
+    auto positions = generatePositions(INSERT_COUNT);
+
+    run("OctTree::insert", REPETITIONS, INSERT_COUNT, [&] {
+        auto tree = voxels::OctTree<uint32>(0u, glm::vec3(0.0f));
+        for(uint32 i = 0; i < positions.size(); ++i) {
+            tree.insert(i + 1, positions[i]);
+        }
+        doNotOptimize(tree);
+    });
+
+    run("LinearOctTree::insert", REPETITIONS, INSERT_COUNT, [&] {
+        auto tree = voxels::LinearOctTree<uint32>(0u, glm::vec3(0.0f));
+        for(uint32 i = 0; i < positions.size(); ++i) {
+            tree.insert(i + 1, positions[i]);
+        }
+        doNotOptimize(tree);
+    });
+
+    auto tree = voxels::OctTree<uint32>(0u, glm::vec3(0.0f));
+    auto linearTree = voxels::LinearOctTree<uint32>(0u, glm::vec3(0.0f));
+    for(uint32 i = 0; i < positions.size(); ++i) {
+        tree.insert(i + 1, positions[i]);
+        linearTree.insert(i + 1, positions[i]);
+    }
+
+    // Every voxel has to read back exactly what was written last, down to the deepest level.
+    std::vector<uint32> expected(CHUNK_LENGTH * CHUNK_LENGTH * CHUNK_LENGTH, 0);
+    for(uint32 i = 0; i < positions.size(); ++i) {
+        auto voxel = tree.toVoxel(positions[i]);
+        expected[(voxel.x * CHUNK_LENGTH + voxel.y) * CHUNK_LENGTH + voxel.z] = i + 1;
+    }
+    uint64 mismatches = 0;
+    for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+        for(uint32 y = 0; y < CHUNK_LENGTH; ++y) {
+            for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                auto voxel = glm::uvec3(x, y, z);
+                auto value = expected[(x * CHUNK_LENGTH + y) * CHUNK_LENGTH + z];
+                mismatches += tree.get(voxel) != value || linearTree.get(voxel) != value;
+            }
+        }
+    }
+    report("OctTree::get mismatches at max depth", static_cast<float64>(mismatches), "voxels");
+    check("OctTree::get bit-exact lookup", mismatches == 0);
+
+    run("OctTree::get", 1, expected.size(), [&] {
+        uint64 sum = 0;
+        for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+            for(uint32 y = 0; y < CHUNK_LENGTH; ++y) {
+                for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                    sum += tree.get(glm::uvec3(x, y, z));
+                }
+            }
+        }
+        doNotOptimize(sum);
+    });
+
+    uint64 leafCount = 0;
+    tree.getRoot().forEach([&](voxels::OctTreeNode<uint32>&) { ++leafCount; });
+
+    run("OctTree::forEach", REPETITIONS, leafCount, [&] {
+        uint64 sum = 0;
+        tree.getRoot().forEach([&](voxels::OctTreeNode<uint32>& node) {
+            sum += static_cast<voxels::OctTreeLeaf<uint32>&>(node).getData();
+        });
+        doNotOptimize(sum);
+    });
+
+    run("LinearOctTree::forEach", REPETITIONS, linearTree.getLeafCount(), [&] {
+        uint64 sum = 0;
+        linearTree.forEach([&](const uint32& data, uint32, glm::vec3) {
+            sum += data;
+        });
+        doNotOptimize(sum);
+    });
+
+    // Fill the scene with random detail, then edit it back to uniform, the memory should shrink with it.
+    report("OctTree memory (random detail)", tree.getMemoryUsage() / 1024.0, "KiB");
+    run("OctTree::remove", 1, INSERT_COUNT, [&] {
+        for(const auto& position : positions) {
+            tree.remove(position);
+        }
+    });
+    report("OctTree memory (after remove)", tree.getMemoryUsage() / 1024.0, "KiB");
+
+    auto half = CHUNK_LENGTH / 2.0f;
+    run("OctTree::fill", 1, 0, [&] {
+        tree.fill(1u, glm::vec3(-half), glm::vec3(half, 0.0f, half));
+        tree.fill(2u, glm::vec3(-half / 3.0f), glm::vec3(half / 5.0f));
+    });
+    report("OctTree memory (filled regions)", tree.getMemoryUsage() / 1024.0, "KiB");
+    run("OctTree::clear", 1, 0, [&] {
+        tree.clear(glm::vec3(-half), glm::vec3(half));
+    });
+    report("OctTree memory (cleared)", tree.getMemoryUsage() / 1024.0, "KiB");
+
+    // Bulk construction from the same random voxels and from a dense 256x64x256 slab.
+    std::vector<std::pair<glm::uvec3, uint32>> voxels;
+    voxels.reserve(positions.size());
+    for(uint32 i = 0; i < positions.size(); ++i) {
+        voxels.emplace_back(glm::uvec3(positions[i] + CHUNK_LENGTH / 2.0f), i + 1);
+    }
+    run("OctTree::OctTree (bulk, random)", REPETITIONS, voxels.size(), [&] {
+        auto tree = voxels::OctTree<uint32>(0u, glm::vec3(0.0f), voxels);
+        doNotOptimize(tree);
+    });
+
+    std::vector<std::pair<glm::uvec3, uint32>> slab;
+    slab.reserve(CHUNK_LENGTH * CHUNK_LENGTH * 64);
+    for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+        for(uint32 y = 0; y < 64; ++y) {
+            for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                slab.emplace_back(glm::uvec3(x, y, z), y < 60 ? 1u : 2u);
+            }
+        }
+    }
+    run("OctTree::OctTree (bulk, dense slab)", REPETITIONS, slab.size(), [&] {
+        auto tree = voxels::OctTree<uint32>(0u, glm::vec3(0.0f), slab);
+        doNotOptimize(tree);
+    });
+}
@@ -0,0 +1,99 @@
+/**
+ * @file OctTreeDagBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the sparse voxel DAG compression benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "OctTree.hpp"
+#include "OctTreeDag.hpp"
+#include "geometric.hpp"
+#include "gtc/constants.hpp"
+#include "trigonometric.hpp"
+#include <random>
+
+namespace {
+    /// @brief How many random queries are made per repetition.
+    constexpr uint32 QUERY_COUNT = 1'000'000;
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+
+    enum Material : uint32 { Air = 0, Stone = 1, Dirt = 2, Grass = 3 };
+
+    /**
+     * @brief Fills the tree with a repetitive terrain, a tiled height field with stone, dirt and grass layers.
+     *
+     * @param tree The tree to fill.
+     */
+    void generateTerrain(voxels::OctTree<uint32>& tree) {
+        auto half = static_cast<int32>(CHUNK_LENGTH / 2);
+        for(int32 x = -half; x < half; ++x) {
+            for(int32 z = -half; z < half; ++z) {
+                // The height field repeats every 32 voxels.
+                auto height = static_cast<int32>(8.0f * glm::sin(x * glm::two_pi<float32>() / 32.0f) * glm::cos(z * glm::two_pi<float32>() / 32.0f));
+                auto column = [&](uint32 material, int32 bottom, int32 top) {
+                    tree.fill(material, glm::vec3(x, bottom, z), glm::vec3(x + 1, top, z + 1));
+                };
+                column(Stone, -half, height - 3);
+                column(Dirt, height - 3, height);
+                column(Grass, height, height + 1);
+            }
+        }
+    }
+}
+
+void bench::runOctTreeDagBenchmarks() {
+    auto tree = voxels::OctTree<uint32>(Air, glm::vec3(0.0f));
+    generateTerrain(tree);
+
+    std::optional<voxels::OctTreeDag<uint32>> dag;
+    run("OctTreeDag::OctTreeDag", REPETITIONS, tree.getNodeCount(), [&] {
+        dag.emplace(tree);
+    });
+
+    report("OctTree nodes", tree.getNodeCount(), "nodes");
+    report("OctTree memory", tree.getMemoryUsage() / 1024.0, "KiB");
+    report("OctTreeDag nodes", dag->getNodeCount(), "nodes");
+    report("OctTreeDag memory", dag->getMemoryUsage() / 1024.0, "KiB");
+    report("OctTreeDag compression", static_cast<float64>(tree.getMemoryUsage()) / dag->getMemoryUsage(), "x");
+
+    std::mt19937 engine(1337);
+    std::uniform_real_distribution<float32> distribution(-(CHUNK_LENGTH / 2.0f), CHUNK_LENGTH / 2.0f);
+    std::vector<glm::vec3> positions(QUERY_COUNT);
+    for(auto& position : positions) {
+        position = { distribution(engine), distribution(engine), distribution(engine) };
+    }
+
+    run("OctTreeDag::get", REPETITIONS, QUERY_COUNT, [&] {
+        uint64 sum = 0;
+        for(const auto& position : positions) {
+            sum += dag->get(position);
+        }
+        doNotOptimize(sum);
+    });
+
+    run("OctTreeDag::forEach", REPETITIONS, 0, [&] {
+        uint64 sum = 0;
+        dag->forEach([&](const uint32& data, uint32, glm::vec3) {
+            sum += data;
+        });
+        doNotOptimize(sum);
+    });
+
+    // Rays start above the terrain and point down at random angles.
+    constexpr uint32 RAY_COUNT = QUERY_COUNT / 10;
+    std::vector<std::pair<glm::vec3, glm::vec3>> rays(RAY_COUNT);
+    for(auto& [origin, direction] : rays) {
+        origin = { distribution(engine), CHUNK_LENGTH / 2.0f - 1.0f, distribution(engine) };
+        direction = glm::normalize(glm::vec3(distribution(engine), -CHUNK_LENGTH / 2.0f, distribution(engine)));
+    }
+
+    run("OctTreeDag::castRay", REPETITIONS, RAY_COUNT, [&] {
+        uint32 hits = 0;
+        for(const auto& [origin, direction] : rays) {
+            hits += dag->castRay(origin, direction, [](uint32 data) { return data != Air; }).has_value();
+        }
+        doNotOptimize(hits);
+    });
+}
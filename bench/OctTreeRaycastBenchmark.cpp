@@ -0,0 +1,150 @@
+/**
+ * @file OctTreeRaycastBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the oct tree ray cast benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "OctTree.hpp"
+#include "ext/vector_int3.hpp"
+#include "geometric.hpp"
+#include "trigonometric.hpp"
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief How many rays are cast per repetition.
+    constexpr uint32 RAY_COUNT = 20'000;
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+
+    using Tree = voxels::OctTree<uint32>;
+
+    /**
+     * @brief A ray with its origin inside the tree.
+     */
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+
+    /**
+     * @brief Generates random rays starting inside a tree centered at the origin.
+     */
+    std::vector<Ray> generateRays(uint32 count) {
+        std::mt19937 engine(1337);
+        std::uniform_real_distribution<float32> position(-static_cast<float32>(CHUNK_LENGTH / 2), CHUNK_LENGTH / 2.0f);
+        std::uniform_real_distribution<float32> direction(-1.0f, 1.0f);
+
+        std::vector<Ray> rays;
+        rays.reserve(count);
+        for(uint32 i = 0; i < count; ++i) {
+            rays.push_back({
+                { position(engine), position(engine), position(engine) },
+                glm::normalize(glm::vec3(direction(engine), direction(engine), direction(engine)))
+            });
+        }
+        return rays;
+    }
+
+    /**
+     * @brief Fills the tree with a terrain like scene, the lower half is solid under a rolling surface.
+     */
+    void generateDenseScene(Tree& tree) {
+        for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+            for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                auto height = static_cast<uint32>(CHUNK_LENGTH / 2 + 24.0f * glm::sin(x * 0.05f) * glm::cos(z * 0.04f));
+                tree.fill(1u, glm::uvec3(x, 0, z), glm::uvec3(x + 1, height, z + 1));
+            }
+        }
+    }
+
+    /**
+     * @brief Fills the tree with a mostly empty scene, a few small boxes float in it.
+     */
+    void generateSparseScene(Tree& tree) {
+        std::mt19937 engine(42);
+        std::uniform_int_distribution<uint32> corner(0, CHUNK_LENGTH - 8);
+        for(uint32 i = 0; i < 64; ++i) {
+            auto min = glm::uvec3(corner(engine), corner(engine), corner(engine));
+            tree.fill(1u, min, min + 8u);
+        }
+    }
+
+    /**
+     * @brief Walks the ray voxel by voxel through the tree, the traversal the ray cast replaces.
+     *
+     * @return std::optional<float32> The distance to the first solid voxel.
+     */
+    std::optional<float32> traceVoxels(const Tree& tree, const Ray& ray) {
+        auto local = ray.origin - tree.getMinCorner();
+        auto voxel = glm::ivec3(glm::floor(local));
+        glm::ivec3 step;
+        glm::vec3 tMax, tDelta;
+        for(glm::length_t axis = 0; axis < 3; ++axis) {
+            step[axis] = ray.direction[axis] > 0.0f ? 1 : -1;
+            tDelta[axis] = ray.direction[axis] != 0.0f ? glm::abs(1.0f / ray.direction[axis]) : std::numeric_limits<float32>::infinity();
+            tMax[axis] = ray.direction[axis] != 0.0f
+                ? (static_cast<float32>(voxel[axis] + (step[axis] > 0)) - local[axis]) / ray.direction[axis]
+                : std::numeric_limits<float32>::infinity();
+        }
+
+        float32 distance = 0.0f;
+        while(glm::all(glm::greaterThanEqual(voxel, glm::ivec3(0))) && glm::all(glm::lessThan(voxel, glm::ivec3(CHUNK_LENGTH)))) {
+            if(tree.get(glm::uvec3(voxel)) != 0u)
+                return distance;
+            glm::length_t axis = tMax.x < tMax.y && tMax.x < tMax.z ? 0 : tMax.y < tMax.z ? 1 : 2;
+            voxel[axis] += step[axis];
+            distance = tMax[axis];
+            tMax[axis] += tDelta[axis];
+        }
+        return std::nullopt;
+    }
+
+    void runScene(const std::string& scene, const Tree& tree, const std::vector<Ray>& rays) {
+        // The ray cast has to find what the voxel traversal finds, the distances only differ by rounding.
+        constexpr float32 TOLERANCE = 1e-3f;
+        uint32 mismatches = 0;
+        for(const auto& ray : rays) {
+            auto hit = tree.raycast(ray.origin, ray.direction);
+            auto expected = traceVoxels(tree, ray);
+            if(hit.has_value() != expected.has_value())
+                ++mismatches;
+            else if(hit && glm::abs(hit->distance - *expected) > TOLERANCE * glm::max(1.0f, *expected))
+                ++mismatches;
+        }
+        bench::report("OctTree::raycast mismatches (" + scene + ")", static_cast<float64>(mismatches), "rays");
+        bench::check("OctTree::raycast matches traversal (" + scene + ")", mismatches == 0);
+
+        uint32 hits = 0;
+        auto raycast = bench::run("OctTree::raycast (" + scene + ")", REPETITIONS, RAY_COUNT, [&] {
+            hits = 0;
+            for(const auto& ray : rays) {
+                hits += tree.raycast(ray.origin, ray.direction).has_value();
+            }
+        });
+        auto voxels = bench::run("OctTree voxel traversal (" + scene + ")", REPETITIONS, RAY_COUNT, [&] {
+            for(const auto& ray : rays) {
+                bench::doNotOptimize(traceVoxels(tree, ray));
+            }
+        });
+        bench::report("OctTree::raycast hit rate (" + scene + ")", 100.0 * hits / RAY_COUNT, "%");
+        bench::report("OctTree::raycast speedup (" + scene + ")", voxels.median / raycast.median, "x");
+    }
+}
+
+void bench::runOctTreeRaycastBenchmarks() {
+    auto rays = generateRays(RAY_COUNT);
+
+    auto dense = Tree(0u, glm::vec3(0.0f));
+    generateDenseScene(dense);
+    runScene("dense", dense, rays);
+
+    auto sparse = Tree(0u, glm::vec3(0.0f));
+    generateSparseScene(sparse);
+    runScene("sparse", sparse, rays);
+}
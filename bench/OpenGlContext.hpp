@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Exception.hpp"
+#include "Renderer/OpenGl/EglSurface.hpp"
+#include <memory> // For the surface.
+
+namespace bench {
+    /**
+     * @brief A headless OpenGl context for the benchmarks, the context of a small EglSurface so no display server is needed.
+     *
+     * @note The context is current on the constructing thread until it is destroyed, the benchmarks draw into the
+     * framebuffer of the surface unless they bind their own.
+     */
+    class OpenGlContext {
+    public:
+        explicit OpenGlContext() {
+            try {
+                m_surface = std::make_unique<renderer::opengl::EglSurface>(1, 1);
+                m_surface->bind();
+            } catch(const voxels::Exception&) {
+                m_surface.reset();
+            }
+        }
+        ~OpenGlContext() {
+            if(m_surface)
+                m_surface->unBind();
+        }
+
+        OpenGlContext(const OpenGlContext&) = delete;
+        OpenGlContext& operator=(const OpenGlContext&) = delete;
+
+        /**
+         * @brief Returns whether the context is current and OpenGl was loaded.
+         */
+        [[nodiscard]] inline bool isValid() const noexcept { return m_surface != nullptr; }
+
+    private:
+        std::unique_ptr<renderer::opengl::EglSurface> m_surface; //< The surface that owns the context.
+    };
+}
@@ -0,0 +1,114 @@
+/**
+ * @file PaletteStorageBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the palette storage benchmarks against a dense array.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "PaletteStorage.hpp"
+#include "gtc/constants.hpp"
+#include "trigonometric.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief How many random accesses are made per repetition.
+    constexpr uint32 ACCESS_COUNT = 1'000'000;
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+
+    enum Material : uint32 { Air = 0, Stone = 1, Dirt = 2, Grass = 3, Ore = 4 };
+
+    /**
+     * @brief A plain array of one uint32 per voxel with the same interface as the palette storage.
+     */
+    class DenseStorage {
+    public:
+        explicit DenseStorage(uint32 data) : m_voxels(voxels::PaletteStorage<uint32>::VOLUME, data) {  }
+
+        [[nodiscard]] inline uint32 get(glm::uvec3 voxel) const noexcept { return m_voxels[getIndex(voxel)]; }
+        inline void insert(uint32 data, glm::uvec3 voxel) noexcept { m_voxels[getIndex(voxel)] = data; }
+        void fill(uint32 data, glm::uvec3 min, glm::uvec3 max) noexcept {
+            for(uint32 x = min.x; x < max.x; ++x) {
+                for(uint32 y = min.y; y < max.y; ++y) {
+                    std::fill(m_voxels.begin() + getIndex({ x, y, min.z }), m_voxels.begin() + getIndex({ x, y, max.z }), data);
+                }
+            }
+        }
+        [[nodiscard]] inline size_t getMemoryUsage() const noexcept { return sizeof(*this) + m_voxels.capacity() * sizeof(uint32); }
+
+    private:
+        [[nodiscard]] static inline size_t getIndex(glm::uvec3 voxel) noexcept {
+            return voxels::PaletteStorage<uint32>::getLinearIndex(voxel);
+        }
+
+        std::vector<uint32> m_voxels;
+    };
+
+    /**
+     * @brief Fills the storage with a height field terrain of stone, dirt and grass layers.
+     *
+     * @param storage The storage to fill.
+     */
+    template<typename S>
+    void generateTerrain(S& storage) {
+        for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+            for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                auto height = static_cast<uint32>(CHUNK_LENGTH / 2 + 24.0f * glm::sin(x * glm::two_pi<float32>() / 97.0f) * glm::cos(z * glm::two_pi<float32>() / 61.0f));
+                storage.fill(Stone, glm::uvec3(x, 0, z), glm::uvec3(x + 1, height - 3, z + 1));
+                storage.fill(Dirt, glm::uvec3(x, height - 3, z), glm::uvec3(x + 1, height, z + 1));
+                storage.fill(Grass, glm::uvec3(x, height, z), glm::uvec3(x + 1, height + 1, z + 1));
+            }
+        }
+    }
+
+    template<typename S>
+    void runStorageBenchmarks(std::string_view name, const std::vector<glm::uvec3>& positions) {
+        auto storage = S(Air);
+        bench::run(std::string(name) + "::fill (terrain)", REPETITIONS, CHUNK_LENGTH * CHUNK_LENGTH, [&] {
+            generateTerrain(storage);
+        });
+        bench::report(std::string(name) + " memory", storage.getMemoryUsage() / 1024.0, "KiB");
+
+        bench::run(std::string(name) + "::get (sequential)", REPETITIONS, voxels::PaletteStorage<uint32>::VOLUME, [&] {
+            uint64 sum = 0;
+            for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+                for(uint32 y = 0; y < CHUNK_LENGTH; ++y) {
+                    for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                        sum += storage.get({ x, y, z });
+                    }
+                }
+            }
+            bench::doNotOptimize(sum);
+        });
+
+        bench::run(std::string(name) + "::get (random)", REPETITIONS, positions.size(), [&] {
+            uint64 sum = 0;
+            for(const auto& position : positions) {
+                sum += storage.get(position);
+            }
+            bench::doNotOptimize(sum);
+        });
+
+        bench::run(std::string(name) + "::insert (random)", REPETITIONS, positions.size(), [&] {
+            for(uint32 i = 0; i < positions.size(); ++i) {
+                storage.insert(i & 1 ? Ore : Air, positions[i]);
+            }
+        });
+        bench::report(std::string(name) + " memory (after edits)", storage.getMemoryUsage() / 1024.0, "KiB");
+    }
+}
+
+void bench::runPaletteStorageBenchmarks() {
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<uint32> distribution(0, CHUNK_LENGTH - 1);
+    std::vector<glm::uvec3> positions(ACCESS_COUNT);
+    for(auto& position : positions) {
+        position = { distribution(engine), distribution(engine), distribution(engine) };
+    }
+
+    runStorageBenchmarks<DenseStorage>("DenseStorage", positions);
+    runStorageBenchmarks<voxels::PaletteStorage<uint32>>("PaletteStorage", positions);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file PipelineBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the uniform upload benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "OpenGlContext.hpp"
+#include "Renderer/OpenGl/FrameUniforms.hpp"
+#include "Renderer/OpenGl/Pipeline.hpp"
+#include "Renderer/OpenGl/StreamBuffer.hpp"
+#include "gtc/type_ptr.hpp"
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The number of frames per repetition.
+    constexpr uint32 FRAMES = 10000;
+    /// @brief The number of pipelines the renderer updates every frame.
+    constexpr uint32 PIPELINES = 3;
+
+    constexpr const char* VERTEX_SHADER = R"(#version 450 core
+        layout(location = 0) in vec3 inPos;
+        uniform mat4 model;
+        uniform mat4 projectionView;
+        uniform vec3 cameraWorldPos;
+        void main() { gl_Position = projectionView * model * vec4(inPos + cameraWorldPos, 1.0f); }
+    )";
+    constexpr const char* BLOCK_VERTEX_SHADER = R"(#version 450 core
+        layout(location = 0) in vec3 inPos;
+        uniform mat4 model;
+        layout(std140, binding = 0) uniform Frame { mat4 projectionView; vec3 cameraWorldPos; };
+        void main() { gl_Position = projectionView * model * vec4(inPos + cameraWorldPos, 1.0f); }
+    )";
+    constexpr const char* FRAGMENT_SHADER = R"(#version 450 core
+        uniform usampler2D uTexture;
+        out vec4 outColor;
+        void main() { outColor = vec4(texelFetch(uTexture, ivec2(0), 0)); }
+    )";
+
+    [[nodiscard]] renderer::opengl::Shader compile(const char* source, renderer::ShaderType type) {
+        return renderer::opengl::Shader::compileFromSource(source, type);
+    }
+}
+
+void bench::runPipelineBenchmarks() {
+    auto context = OpenGlContext();
+    if(!context.isValid()) {
+        bench::report("Pipeline (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+
+    using renderer::ShaderType;
+    using renderer::opengl::Pipeline;
+    // Pipelines are not movable, so they are constructed in place.
+    Pipeline pipelines[PIPELINES] = {
+        Pipeline::linkShaders(compile(VERTEX_SHADER, ShaderType::Vertex), compile(FRAGMENT_SHADER, ShaderType::Fragment)),
+        Pipeline::linkShaders(compile(VERTEX_SHADER, ShaderType::Vertex), compile(FRAGMENT_SHADER, ShaderType::Fragment)),
+        Pipeline::linkShaders(compile(VERTEX_SHADER, ShaderType::Vertex), compile(FRAGMENT_SHADER, ShaderType::Fragment)),
+    };
+    Pipeline blockPipelines[PIPELINES] = {
+        Pipeline::linkShaders(compile(BLOCK_VERTEX_SHADER, ShaderType::Vertex), compile(FRAGMENT_SHADER, ShaderType::Fragment)),
+        Pipeline::linkShaders(compile(BLOCK_VERTEX_SHADER, ShaderType::Vertex), compile(FRAGMENT_SHADER, ShaderType::Fragment)),
+        Pipeline::linkShaders(compile(BLOCK_VERTEX_SHADER, ShaderType::Vertex), compile(FRAGMENT_SHADER, ShaderType::Fragment)),
+    };
+    auto model = glm::mat4(1.0f), projectionView = glm::mat4(2.0f);
+    auto camera = glm::vec3(1.0f, 2.0f, 3.0f);
+
+    // What setUniform did before, bind, look the location up by its name, upload and unbind for every uniform.
+    bench::run("Uniforms by name with glUseProgram", REPETITIONS, FRAMES, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            for(const auto& pipeline : pipelines) {
+                auto program = pipeline.getId();
+                glUseProgram(program);
+                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+                glUseProgram(0);
+                glUseProgram(program);
+                glUniformMatrix4fv(glGetUniformLocation(program, "projectionView"), 1, GL_FALSE, glm::value_ptr(projectionView));
+                glUseProgram(0);
+                glUseProgram(program);
+                glUniform3fv(glGetUniformLocation(program, "cameraWorldPos"), 1, glm::value_ptr(camera));
+                glUseProgram(0);
+                glUseProgram(program);
+                glUniform1i(glGetUniformLocation(program, "uTexture"), 0);
+                glUseProgram(0);
+            }
+        }
+        glFinish();
+    });
+
+    bench::run("Pipeline::setUniform with cached locations", REPETITIONS, FRAMES, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            for(const auto& pipeline : pipelines) {
+                pipeline.setUniform("model", model);
+                pipeline.setUniform("projectionView", projectionView);
+                pipeline.setUniform("cameraWorldPos", camera);
+                pipeline.setUniform("uTexture", 0);
+            }
+        }
+        glFinish();
+    });
+
+    // The per frame data is written once for every pipeline, only the per pipeline uniforms remain.
+    GLint alignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    auto frameUniforms = renderer::opengl::UniformStreamBuffer(16 * 1024);
+    bench::run("Frame uniform buffer and cached locations", REPETITIONS, FRAMES, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            auto data = renderer::opengl::FrameUniforms { projectionView, glm::vec4(camera, 1.0f) };
+            auto uploaded = frameUniforms.upload(&data, sizeof(data), static_cast<size_t>(alignment));
+            glBindBufferRange(GL_UNIFORM_BUFFER, renderer::opengl::FRAME_UNIFORMS_BINDING, frameUniforms.getId(),
+                static_cast<GLintptr>(uploaded.offset), sizeof(data));
+            for(const auto& pipeline : blockPipelines) {
+                pipeline.setUniform("model", model);
+                pipeline.setUniform("uTexture", 0);
+            }
+            frameUniforms.fence();
+        }
+        glFinish();
+    });
+    bench::report("Frame uniform buffer stalls", static_cast<float64>(frameUniforms.getStallCount()), "waits");
+}
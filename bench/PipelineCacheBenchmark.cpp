@@ -0,0 +1,87 @@
+/**
+ * @file PipelineCacheBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the pipeline building benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "File.hpp"
+#include "OpenGlContext.hpp"
+#include "Renderer/OpenGl/Pipeline.hpp"
+#include "Renderer/OpenGl/PipelineCache.hpp"
+#include <array>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The shaders of the pipelines the renderer builds.
+    constexpr std::array<std::pair<const char*, const char*>, 3> PIPELINES = {{
+        { "./assets/shaders/basic.vert", "./assets/shaders/basic.frag" },
+        { "./assets/shaders/voxelMarcher.vert", "./assets/shaders/voxelMarcher.frag" },
+        { "./assets/shaders/voxel.vert", "./assets/shaders/voxel.frag" },
+    }};
+
+    /**
+     * @brief Builds every pipeline with the cache and waits for them and their binaries.
+     */
+    [[nodiscard]] renderer::opengl::PipelineCacheStatistics buildWithCache(const std::filesystem::path& directory) {
+        auto cache = renderer::opengl::PipelineCache(directory);
+        for(auto [vertex, fragment] : PIPELINES) {
+            static_cast<void>(cache.request(vertex, fragment));
+        }
+        cache.wait();
+        cache.flush();
+        return cache.getStatistics();
+    }
+}
+
+void bench::runPipelineCacheBenchmarks() {
+    if(!std::filesystem::exists(PIPELINES[0].first)) {
+        bench::report("PipelineCache (no ./assets, skipped)", 0.0, "");
+        return;
+    }
+    auto context = OpenGlContext();
+    if(!context.isValid()) {
+        bench::report("PipelineCache (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+
+    using renderer::ShaderType;
+    using renderer::opengl::Pipeline;
+    using renderer::opengl::Shader;
+    // What the first frame did before, read each source, compile and link one pipeline after another.
+    bench::run("Pipelines read and compiled in order", REPETITIONS, PIPELINES.size(), [&] {
+        for(auto [vertex, fragment] : PIPELINES) {
+            auto pipeline = Pipeline::linkShaders(
+                Shader::compileFromSource(voxels::openForReading(vertex).readContent().get(), ShaderType::Vertex),
+                Shader::compileFromSource(voxels::openForReading(fragment).readContent().get(), ShaderType::Fragment)
+            );
+            bench::doNotOptimize(pipeline.getId());
+        }
+    });
+
+    // The driver may keep its own shader cache, so this is the compile cost of a run without program binaries and not of a clean machine.
+    auto directory = std::filesystem::temp_directory_path() / "voxels_bench_pipelines";
+    auto statistics = renderer::opengl::PipelineCacheStatistics();
+    bench::run("PipelineCache without binaries", REPETITIONS, PIPELINES.size(), [&] {
+        std::filesystem::remove_all(directory);
+        statistics = buildWithCache(directory);
+    });
+    bench::report("PipelineCache compiled pipelines", static_cast<float64>(statistics.compiled), "pipelines");
+    bench::report("PipelineCache stored binaries", static_cast<float64>(statistics.stored), "binaries");
+
+    bench::run("PipelineCache with binaries", REPETITIONS, PIPELINES.size(), [&] {
+        statistics = buildWithCache(directory);
+    });
+    bench::report("PipelineCache loaded binaries", static_cast<float64>(statistics.loaded), "pipelines");
+    bench::report("PipelineCache rejected binaries", static_cast<float64>(statistics.rejected), "binaries");
+    std::filesystem::remove_all(directory);
+
+    auto cache = renderer::opengl::PipelineCache(directory);
+    bench::report("PipelineCache parallel compile", cache.hasParallelCompile() ? 1.0 : 0.0, "");
+    bench::report("PipelineCache program binaries", cache.hasProgramBinaries() ? 1.0 : 0.0, "");
+}
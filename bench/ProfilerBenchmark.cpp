@@ -0,0 +1,102 @@
+/**
+ * @file ProfilerBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the frame profiler benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "OpenGlContext.hpp"
+#include "Profiling/Profiler.hpp"
+#include "Renderer/OpenGl/GpuTimer.hpp"
+#include <filesystem>
+#include <string>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The number of zones per frame, far more than the application records.
+    constexpr uint32 ZONES_PER_FRAME = 1000;
+    /// @brief The number of frames per repetition.
+    constexpr uint32 FRAMES = 1000;
+    /// @brief The number of frames in the trace.
+    constexpr uint32 CAPTURED_FRAMES = 100;
+    /// @brief The number of frames the GPU passes are timed for.
+    constexpr uint32 GPU_FRAMES = 500;
+
+    /**
+     * @brief Records the zones like PROFILE_SCOPE does, which compiles to nothing in the benchmarks.
+     */
+    inline void recordZones(uint32 count) {
+        for(uint32 i = 0; i < count; ++i) {
+            const profiling::Zone zone("zone");
+            bench::doNotOptimize(i);
+        }
+    }
+}
+
+void bench::runProfilerBenchmarks() {
+    auto& profiler = profiling::getProfiler();
+    profiler.endFrame();
+
+    auto single = run("Profiler zones (1 thread)", REPETITIONS, uint64(FRAMES) * ZONES_PER_FRAME, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            recordZones(ZONES_PER_FRAME);
+            profiler.endFrame();
+        }
+    });
+    report("Profiler cost per zone (1 thread)", single.median / (FRAMES * ZONES_PER_FRAME) * 1e9, "ns");
+    report("Profiler dropped zones", static_cast<float64>(profiler.getLastFrame().dropped), "zones/frame");
+
+    auto workers = std::max(std::thread::hardware_concurrency(), 4u);
+    auto system = jobs::JobSystem(workers);
+    auto suffix = " (" + std::to_string(workers) + " workers)";
+    auto parallel = run("Profiler zones" + suffix, REPETITIONS, uint64(FRAMES) * ZONES_PER_FRAME, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            system.parallelFor(workers, 1, [&](size_t begin, size_t end) {
+                recordZones(static_cast<uint32>((end - begin) * ZONES_PER_FRAME / workers));
+            });
+            profiler.endFrame();
+        }
+    });
+    report("Profiler cost per zone" + suffix, parallel.median / (FRAMES * ZONES_PER_FRAME) * 1e9, "ns");
+
+    auto path = (std::filesystem::temp_directory_path() / "voxels_bench_trace.json").string();
+    run("Profiler Chrome trace", REPETITIONS, uint64(CAPTURED_FRAMES) * ZONES_PER_FRAME, [&] {
+        profiler.startCapture(CAPTURED_FRAMES);
+        for(uint32 frame = 0; frame < CAPTURED_FRAMES; ++frame) {
+            recordZones(ZONES_PER_FRAME);
+            profiler.endFrame();
+        }
+        profiler.writeChromeTrace(path);
+    });
+    report("Profiler trace size", static_cast<float64>(std::filesystem::file_size(path)) / (1024.0 * 1024.0), "MiB");
+    std::filesystem::remove(path);
+
+    auto context = OpenGlContext();
+    if(!context.isValid()) {
+        report("GpuTimer (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+
+    // Three passes a frame like the renderer, the results are collected without waiting.
+    auto timer = renderer::opengl::GpuTimer();
+    size_t collected = 0;
+    run("GpuTimer three passes per frame", REPETITIONS, GPU_FRAMES, [&] {
+        for(uint32 frame = 0; frame < GPU_FRAMES; ++frame) {
+            for(const auto* name : { "world", "marcher", "wireframe" }) {
+                const renderer::opengl::GpuZone zone(timer, name);
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            timer.collect(profiler);
+            profiler.endFrame();
+            for(const auto& pass : profiler.getLastFrame().gpu) {
+                collected += pass.calls;
+            }
+        }
+        glFinish();
+    });
+    report("GpuTimer passes collected", static_cast<float64>(collected) / (REPETITIONS * GPU_FRAMES), "passes/frame");
+    report("GpuTimer passes in flight", static_cast<float64>(timer.getPassesInFlight()), "passes");
+}
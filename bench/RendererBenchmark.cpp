@@ -0,0 +1,89 @@
+/**
+ * @file RendererBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the headless OpenGl renderer frame time benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "CameraDescriptor.hpp"
+#include "Exception.hpp"
+#include "Renderer/OpenGl/EglSurface.hpp"
+#include "Renderer/OpenGl/Renderer.hpp"
+#include "World/Remesher.hpp"
+#include "World/TerrainGenerator.hpp"
+#include "World/World.hpp"
+#include "trigonometric.hpp"
+#include <filesystem>
+#include <memory>
+
+namespace {
+    /// @brief How many frames are rendered, every frame is one sample.
+    constexpr uint32 FRAMES = 40;
+    /// @brief The size of the framebuffer.
+    constexpr uint32 WIDTH = 1280, HEIGHT = 720;
+    /// @brief The radius of the generated chunks around the origin in chunks.
+    constexpr int32 RADIUS = 3;
+
+    /**
+     * @brief Returns the camera of the frame, it circles the origin above the terrain.
+     */
+    [[nodiscard]] voxels::CameraDescriptor getCamera(uint32 frame) {
+        auto angle = static_cast<float32>(frame) * 0.02f;
+        auto direction = glm::normalize(glm::vec3(glm::cos(angle), -0.35f, glm::sin(angle)));
+        return { glm::vec3(0.0f, 40.0f, 0.0f), direction, 1.2f };
+    }
+}
+
+void bench::runRendererBenchmarks() {
+    // The renderer loads its shaders relative to the working directory.
+    if(!std::filesystem::exists("./assets/shaders/voxel.vert")) {
+        report("Renderer (no ./assets, skipped)", 0.0, "");
+        return;
+    }
+    std::shared_ptr<renderer::opengl::EglSurface> surface;
+    try {
+        surface = std::make_shared<renderer::opengl::EglSurface>(WIDTH, HEIGHT);
+    } catch(const voxels::Exception&) {
+        report("Renderer (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+    auto renderer = renderer::opengl::Renderer(surface);
+
+    auto world = world::World();
+    for(int32 x = -RADIUS; x < RADIUS; ++x) {
+        for(int32 y = -1; y <= 0; ++y) {
+            for(int32 z = -RADIUS; z < RADIUS; ++z) {
+                world::generateTerrain(world.loadChunk({ x, y, z }));
+            }
+        }
+    }
+    auto remesher = world::Remesher(world);
+    // The batches are meshed in the background, each is swapped in by the update after it finished.
+    do {
+        remesher.update(getCamera(0));
+        renderer.updateMeshes(remesher);
+        remesher.wait();
+    } while(!remesher.isIdle());
+
+    // The pipelines build in the background, the first frame creates the cube and its texture.
+    renderer.waitForPipelines();
+    renderer.render(getCamera(0));
+    uint32 frame = 0;
+    auto result = run("Renderer::render (1280x720, headless)", FRAMES, 0, [&] {
+        renderer.render(getCamera(++frame));
+    });
+    report("Renderer frame rate", 1.0 / result.median, "frames/s");
+    report("Renderer sections", static_cast<float64>(renderer.getCuller().getStatistics().tested), "sections");
+    report("Renderer visible sections", static_cast<float64>(renderer.getCuller().getStatistics().visible), "sections");
+
+    auto pixels = std::vector<uint8>();
+    run("EglSurface::readPixels (1280x720)", 20, uint64(WIDTH) * HEIGHT, [&] {
+        pixels = surface->readPixels();
+    });
+    size_t covered = 0;
+    for(size_t i = 0; i < pixels.size(); i += 4) {
+        covered += pixels[i] != 0 || pixels[i + 1] != 0 || pixels[i + 2] != 0;
+    }
+    report("Renderer covered pixels", 100.0 * static_cast<float64>(covered) / (WIDTH * HEIGHT), "%");
+}
@@ -0,0 +1,125 @@
+/**
+ * @file StateCacheBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the OpenGl state cache benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "OpenGlContext.hpp"
+#include "Renderer/OpenGl/Buffer.hpp"
+#include "Renderer/OpenGl/Pipeline.hpp"
+#include "Renderer/OpenGl/StateCache.hpp"
+#include "Renderer/OpenGl/VertexArray.hpp"
+#include "Renderer/OpenGl/VertexBufferAttributes.hpp"
+#include "gtc/type_ptr.hpp"
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The number of frames per repetition.
+    constexpr uint32 FRAMES = 2000;
+    /// @brief The number of buffer uploads per frame, like the meshes of the remeshed sections.
+    constexpr uint32 UPLOADS = 32;
+    /// @brief The size of an upload.
+    constexpr size_t UPLOAD_SIZE = 1024;
+    /// @brief The number of pipelines used per frame.
+    constexpr uint32 PIPELINES = 3;
+
+    constexpr const char* VERTEX_SHADER = R"(#version 450 core
+        layout(location = 0) in vec3 inPos;
+        uniform mat4 model;
+        void main() { gl_Position = model * vec4(inPos, 1.0f); }
+    )";
+    constexpr const char* FRAGMENT_SHADER = R"(#version 450 core
+        out vec4 outColor;
+        void main() { outColor = vec4(1.0f); }
+    )";
+
+    [[nodiscard]] renderer::opengl::Pipeline link() {
+        using renderer::opengl::Shader;
+        return renderer::opengl::Pipeline::linkShaders(
+            Shader::compileFromSource(VERTEX_SHADER, renderer::ShaderType::Vertex),
+            Shader::compileFromSource(FRAGMENT_SHADER, renderer::ShaderType::Fragment)
+        );
+    }
+}
+
+void bench::runStateCacheBenchmarks() {
+    auto context = OpenGlContext();
+    if(!context.isValid()) {
+        bench::report("StateCache (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+
+    // Pipelines are not movable, so they are constructed in place.
+    renderer::opengl::Pipeline pipelines[PIPELINES] = { link(), link(), link() };
+    auto vertexArray = renderer::opengl::VertexArray(renderer::opengl::VertexBufferAttributes({ { renderer::AttributeType::Float32, 3 } }));
+    std::vector<renderer::opengl::VertexBuffer> buffers(UPLOADS);
+    std::vector<uint8> data(UPLOAD_SIZE, 0x5A);
+    for(auto& buffer : buffers) {
+        buffer.copyDataIntoBuffer(data.data(), UPLOAD_SIZE, GL_DYNAMIC_DRAW);
+    }
+    auto model = glm::mat4(1.0f);
+
+    // What a frame did before, every wrapper bound its object, used it and unbound it again.
+    size_t legacyCalls = 0;
+    bench::run("Bind and unbind around every use", REPETITIONS, FRAMES, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            legacyCalls = 0;
+            for(const auto& buffer : buffers) {
+                glBindBuffer(GL_ARRAY_BUFFER, buffer.getId());
+                glBufferSubData(GL_ARRAY_BUFFER, 0, UPLOAD_SIZE, data.data());
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                legacyCalls += 2;
+            }
+            glEnable(GL_DEPTH_TEST);
+            for(const auto& pipeline : pipelines) {
+                glUseProgram(pipeline.getId());
+                glUniformMatrix4fv(glGetUniformLocation(pipeline.getId(), "model"), 1, GL_FALSE, glm::value_ptr(model));
+                glUseProgram(0);
+                legacyCalls += 2;
+            }
+            for(const auto& pipeline : pipelines) {
+                glBindVertexArray(vertexArray.getId());
+                glUseProgram(pipeline.getId());
+                glEnable(GL_DEPTH_TEST);
+                glBindVertexArray(0);
+                glUseProgram(0);
+                legacyCalls += 5;
+            }
+            glDisable(GL_DEPTH_TEST);
+            legacyCalls += 2;
+        }
+        glFinish();
+    });
+    bench::report("Bind and unbind state calls", static_cast<float64>(legacyCalls), "calls/frame");
+
+    // The raw calls above went around the cache.
+    auto& state = renderer::opengl::getStateCache();
+    state.invalidate();
+    bench::run("StateCache and direct state access", REPETITIONS, FRAMES, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            for(auto& buffer : buffers) {
+                buffer.copySubDataIntoBuffer(data.data(), 0, UPLOAD_SIZE);
+            }
+            state.setEnabled(GL_DEPTH_TEST, true);
+            for(const auto& pipeline : pipelines) {
+                pipeline.setUniform("model", model);
+            }
+            for(const auto& pipeline : pipelines) {
+                vertexArray.bind();
+                pipeline.bind();
+                state.setEnabled(GL_DEPTH_TEST, true);
+            }
+            state.setEnabled(GL_DEPTH_TEST, false);
+            state.endFrame();
+        }
+        glFinish();
+    });
+    const auto& statistics = state.getLastFrameStatistics();
+    bench::report("StateCache issued state calls", static_cast<float64>(statistics.issued), "calls/frame");
+    bench::report("StateCache skipped state calls", static_cast<float64>(statistics.skipped), "calls/frame");
+    bench::report("StateCache direct state access", renderer::opengl::StateCache::hasDirectStateAccess() ? 1.0 : 0.0, "");
+}
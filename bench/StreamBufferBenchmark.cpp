@@ -0,0 +1,72 @@
+/**
+ * @file StreamBufferBenchmark.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the mesh upload benchmarks.
+ */
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include "OpenGlContext.hpp"
+#include "Renderer/OpenGl/Buffer.hpp"
+#include "Renderer/OpenGl/StreamBuffer.hpp"
+#include <vector>
+
+namespace {
+    /// @brief How many times each benchmark is repeated.
+    constexpr uint32 REPETITIONS = 5;
+    /// @brief The number of simulated frames per repetition.
+    constexpr uint32 FRAMES = 60;
+    /// @brief The number of meshes uploaded per frame.
+    constexpr uint32 MESHES_PER_FRAME = 16;
+    /// @brief The size of a mesh, about a packed surface section.
+    constexpr size_t MESH_SIZE = size_t(64) << 10;
+    /// @brief The number of bytes uploaded per repetition.
+    constexpr uint64 BYTES = static_cast<uint64>(FRAMES) * MESHES_PER_FRAME * MESH_SIZE;
+}
+
+void bench::runStreamBufferBenchmarks() {
+    auto context = OpenGlContext();
+    if(!context.isValid()) {
+        bench::report("StreamBuffer (no OpenGl context, skipped)", 0.0, "");
+        return;
+    }
+
+    std::vector<uint8> mesh(MESH_SIZE, 0x5A);
+    // Every upload is read by the GPU once, like a draw would, by copying it into a buffer that stays resident.
+    auto target = renderer::opengl::Buffer<GL_COPY_WRITE_BUFFER>();
+    target.copyDataIntoBuffer(nullptr, MESH_SIZE, GL_STATIC_DRAW);
+    target.bind();
+
+    {
+        std::vector<renderer::opengl::VertexBuffer> buffers(MESHES_PER_FRAME);
+        bench::run("Buffer::copyDataIntoBuffer", REPETITIONS, BYTES, [&] {
+            for(uint32 frame = 0; frame < FRAMES; ++frame) {
+                for(auto& buffer : buffers) {
+                    buffer.copyDataIntoBuffer(mesh.data(), MESH_SIZE);
+                    buffer.bind();
+                    glCopyBufferSubData(GL_ARRAY_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, MESH_SIZE);
+                }
+                glFlush();
+            }
+            glFinish();
+        });
+    }
+
+    // Three frames in flight.
+    auto ring = renderer::opengl::VertexStreamBuffer(3 * MESHES_PER_FRAME * MESH_SIZE);
+    ring.bind();
+    bench::run("StreamBuffer::upload", REPETITIONS, BYTES, [&] {
+        for(uint32 frame = 0; frame < FRAMES; ++frame) {
+            for(uint32 i = 0; i < MESHES_PER_FRAME; ++i) {
+                auto allocation = ring.upload(mesh.data(), MESH_SIZE);
+                glCopyBufferSubData(GL_ARRAY_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.offset), 0, MESH_SIZE);
+            }
+            ring.fence();
+            glFlush();
+        }
+        glFinish();
+    });
+    ring.unBind();
+    target.unBind();
+    bench::report("StreamBuffer stalls", static_cast<float64>(ring.getStallCount()), "waits");
+}
@@ -0,0 +1,54 @@
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+#include <cstring> // For the arguments.
+#include <fstream> // For the JSON file.
+#include <iostream> // For the usage.
+
+/*
+    voxels_bench [--json <path>]
+    Prints the results as a table, --json also writes them to the file so runs can be compared.
+    Exits with 1 if a correctness check of a benchmark failed.
+*/
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--json <path>]\n";
+            return 1;
+        }
+    }
+
+    bench::runOctTreeBenchmarks();
+    bench::runOctTreeRaycastBenchmarks();
+    bench::runOctTreeDagBenchmarks();
+    bench::runPaletteStorageBenchmarks();
+    bench::runJobSystemBenchmarks();
+    bench::runChunkMesherBenchmarks();
+    bench::runCpuRendererBenchmarks();
+    bench::runStreamBufferBenchmarks();
+    bench::runMeshArenaBenchmarks();
+    bench::runCullingBenchmarks();
+    bench::runPipelineBenchmarks();
+    bench::runPipelineCacheBenchmarks();
+    bench::runStateCacheBenchmarks();
+    bench::runProfilerBenchmarks();
+    bench::runEventBenchmarks();
+    bench::runAssetBenchmarks();
+    bench::runRendererBenchmarks();
+
+    if(jsonPath) {
+        auto json = std::ofstream(jsonPath);
+        bench::writeJson(json, bench::getResults());
+        if(!json) {
+            std::cerr << "Could not write " << jsonPath << '\n';
+            return 1;
+        }
+    }
+
+    for(const auto& failure : bench::getResults().failures) {
+        std::cerr << "Failed: " << failure << '\n';
+    }
+    return bench::getResults().failures.empty() ? 0 : 1;
+}
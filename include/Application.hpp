@@ -6,6 +6,10 @@
 #include "Scripts/CameraController.hpp"
 #include "Window/WindowBuilder.hpp"
 #include "Window/WindowManager.hpp"
+#include "World/ChunkStreamer.hpp"
+#include "World/Remesher.hpp"
+#include "World/TerrainGenerator.hpp"
+#include "World/World.hpp"
 #include <memory>
 
 namespace voxels {
@@ -23,7 +27,9 @@ namespace voxels {
             , m_cameraController(
                 world::Camera(glm::vec3{ 0.0f, 0.0f, 5.0f}),
                 m_windowManager.getEventParser()
-            ) {  }
+            )
+            , m_chunkStreamer(m_world, [](world::Chunk& chunk) { world::generateTerrain(chunk); })
+            , m_remesher(m_world) {  }
 
         void start() noexcept;
 
@@ -32,5 +38,9 @@ namespace voxels {
         std::unique_ptr<renderer::IRenderer> m_renderer; //< The renderer of the application.
         voxels::Observer<const wnd::ResizeEvent&> m_wndResizeObserver; //< Observer for the window resize event.
         scripts::CameraController m_cameraController; //< The camera of the application.
+        world::World m_world; //< The loaded chunks.
+        world::ChunkStreamer m_chunkStreamer; //< Streams the chunks around the camera into the world.
+        world::Remesher m_remesher; //< Keeps the meshes of the edited sections up to date.
+        glm::vec3 m_previousCameraPosition; //< The camera position before the last simulation step.
     };
 }
\ No newline at end of file
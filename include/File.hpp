@@ -34,7 +34,7 @@ namespace voxels {
     public:
         using File::File;
         /**
-         * @brief Asyncronously reads the content of the file.
+         * @brief Asyncronously reads the content of the file on the shared job system.
          * 
          * @return std::future<std::string> A future containing the file contents as a string.
          */
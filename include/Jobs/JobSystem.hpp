@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Global.hpp"
+#include <algorithm> // For std::min.
+#include <atomic> // For the counters.
+#include <concepts> // For constraining the parallel for callback.
+#include <condition_variable> // For putting idle workers to sleep.
+#include <cstddef> // For size_t.
+#include <deque> // For the work stealing queues.
+#include <functional> // For std::move_only_function.
+#include <memory> // For std::unique_ptr.
+#include <mutex> // For guarding the queues.
+#include <stop_token> // For stopping the workers.
+#include <thread> // For the workers.
+#include <utility> // For std::pair.
+#include <vector> // For the queues and the workers.
+
+namespace jobs {
+    /// @brief A unit of work.
+    using Job = std::move_only_function<void()>;
+
+    class JobSystem;
+
+    /**
+     * @brief Counts the unfinished jobs that were submitted with it.
+     *
+     * @note Jobs can be scheduled to run once a counter reaches zero, which is how dependencies are expressed.
+     * A counter must only be destroyed after JobSystem::wait returned for it and must not be reused while it still has continuations attached.
+     */
+    class Counter {
+    public:
+        Counter() noexcept = default;
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        /**
+         * @brief Returns true if every job submitted with the counter has finished and none of them uses the counter anymore.
+         */
+        [[nodiscard]] inline bool isDone() const noexcept {
+            // The jobs announce themselves before they decrement, so the second load sees every job that took part in reaching zero.
+            return m_count.load(std::memory_order_acquire) == 0 && m_finishing.load(std::memory_order_acquire) == 0;
+        }
+        /**
+         * @brief Returns the number of unfinished jobs.
+         */
+        [[nodiscard]] inline uint32 getValue() const noexcept { return m_count.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32> m_count = 0; //< The number of unfinished jobs.
+        std::atomic<uint32> m_finishing = 0; //< The number of jobs that decrement the count right now and may still use the counter.
+        mutable std::mutex m_mutex; //< Guards the continuations.
+        std::vector<std::pair<Job, Counter*>> m_continuations; //< The jobs that run once the count reaches zero and their counters.
+    };
+
+    /**
+     * @brief A fixed pool of workers that execute jobs from per worker work stealing queues.
+     *
+     * @note Workers push and pop jobs at the back of their own queue and steal from the front of the others,
+     * jobs submitted from other threads are distributed round robin. Threads that wait for a counter
+     * execute its jobs in the meantime, so the pool has one worker less than there are hardware threads.
+     */
+    class JobSystem {
+    public:
+        /**
+         * @brief Constructs a new job system and starts its workers.
+         *
+         * @param workerCount The number of workers, zero uses one less than the number of hardware threads.
+         */
+        explicit JobSystem(uint32 workerCount = 0);
+        /**
+         * @brief Finishes every queued job and stops the workers.
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Queues the job.
+         *
+         * @param job The job.
+         * @param counter The counter that tracks the job, it is incremented now and decremented once the job has finished.
+         */
+        void submit(Job&& job, Counter* counter = nullptr);
+
+        /**
+         * @brief Queues the job once the dependency has reached zero.
+         *
+         * @param dependency The counter to wait for.
+         * @param job The job.
+         * @param counter The counter that tracks the job, it is incremented now and decremented once the job has finished.
+         */
+        void submitAfter(Counter& dependency, Job&& job, Counter* counter = nullptr);
+
+        /**
+         * @brief Executes the queued jobs of the counter until it reaches zero.
+         *
+         * @param counter The counter to wait for.
+         *
+         * @note Jobs of other counters are left to the workers, so waiting never takes on unrelated work like chunk generation or file reads.
+         */
+        void wait(const Counter& counter);
+
+        /**
+         * @brief Splits the range [0, count) into batches, runs them on the workers and waits for all of them.
+         *
+         * @param count The number of items.
+         * @param batchSize The number of items per job, zero splits the range into four jobs per thread.
+         * @param function The function which receives the beginning and the end of a batch.
+         */
+        template<std::invocable<size_t, size_t> F>
+        void parallelFor(size_t count, size_t batchSize, F&& function) {
+            if(count == 0)
+                return;
+            if(batchSize == 0)
+                batchSize = std::max<size_t>(count / ((getWorkerCount() + 1) * 4), 1);
+
+            Counter counter;
+            for(size_t begin = 0; begin < count; begin += batchSize) {
+                submit([&function, begin, end = std::min(begin + batchSize, count)] { function(begin, end); }, &counter);
+            }
+            wait(counter);
+        }
+
+        [[nodiscard]] inline uint32 getWorkerCount() const noexcept { return static_cast<uint32>(m_workers.size()); }
+
+    private:
+        /**
+         * @brief A queued job.
+         */
+        struct Task {
+            Job job; //< The job.
+            Counter* counter; //< The counter to decrement once the job has finished.
+        };
+
+        /**
+         * @brief The queue of a single worker.
+         */
+        struct Queue {
+            std::mutex mutex; //< Guards the tasks.
+            std::deque<Task> tasks; //< The tasks.
+        };
+
+        void push(Task&& task);
+        /**
+         * @brief Runs a single job, preferring the queue of the current worker.
+         *
+         * @param counter Only a job tracked by the counter is run, nullptr runs any job.
+         * @return true If a job was run.
+         * @return false If no queue held a matching job.
+         */
+        bool tryRun(const Counter* counter = nullptr);
+        void finish(Counter* counter);
+        void work(std::stop_token stopToken, uint32 index);
+
+        std::vector<std::unique_ptr<Queue>> m_queues; //< One queue per worker.
+        std::atomic<uint32> m_nextQueue = 0; //< The queue that receives the next job from a thread outside of the pool.
+        std::atomic<size_t> m_queuedCount = 0; //< The number of queued jobs.
+        std::mutex m_sleepMutex; //< Guards sleeping.
+        std::condition_variable_any m_sleepCondition; //< Signaled when jobs are queued.
+        std::vector<std::jthread> m_workers; //< The workers, declared last so that they stop before the queues are destroyed.
+    };
+
+    /**
+     * @brief Returns the job system shared by the engine, it is created on first use.
+     */
+    [[nodiscard]] JobSystem& getJobSystem();
+}
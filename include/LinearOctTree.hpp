@@ -0,0 +1,243 @@
+#pragma once
+
+#include "Global.hpp"
+#include "OctTreeHelpers.hpp"
+#include "common.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_uint3.hpp"
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <vector> // For the node and leaf storage.
+
+namespace voxels {
+    /**
+     * @brief Pointer-free oct tree that stores all of its nodes in one contiguous array.
+     *
+     * @tparam T The leaf data type.
+     *
+     * @note Branches reference a block of 8 consecutive child nodes and leaves reference a slot in a separate payload array,
+     * so a traversal only ever touches two flat arrays and there is no allocation per node.
+     * Node centers are not stored, they are derived from the root center while descending.
+     */
+    template<typename T>
+    class LinearOctTree {
+    public:
+        /// @brief Index of a node in the node array.
+        using NodeIndex = uint32;
+
+        /**
+         * @brief A single 4 byte node.
+         */
+        struct Node {
+            static constexpr uint32 LEAF_FLAG = 1u << 31; //< Set if the node is a leaf.
+
+            uint32 value; //< Index of the first child if this is a branch, index of the payload if this is a leaf.
+
+            [[nodiscard]] inline bool isLeaf() const noexcept { return value & LEAF_FLAG; }
+            [[nodiscard]] inline uint32 getIndex() const noexcept { return value & ~LEAF_FLAG; }
+
+            [[nodiscard]] static inline Node leaf(uint32 payloadIndex) noexcept { return { payloadIndex | LEAF_FLAG }; }
+            [[nodiscard]] static inline Node branch(NodeIndex firstChild) noexcept { return { firstChild }; }
+        };
+
+        /// @brief The root is always the first node.
+        static constexpr NodeIndex ROOT = 0;
+
+        /**
+         * @brief Constructs a new tree whose root branch has 8 leaves that hold the provided data.
+         *
+         * @param data The data of the initial leaves.
+         * @param center The center of the tree.
+         */
+        explicit LinearOctTree(T&& data, glm::vec3 center) : m_center(center) {
+            m_nodes.reserve(9);
+            m_leaves.reserve(8);
+            m_nodes.push_back(Node::branch(1));
+            for(uint32 i = 0; i < 8; ++i) {
+                m_nodes.push_back(Node::leaf(i));
+                m_leaves.push_back(data);
+            }
+        }
+
+        /**
+         * @brief Inserts the data at the provided voxel, splitting leaves on the way down.
+         *
+         * @param data The data to insert.
+         * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+         */
+        void insert(T&& data, glm::uvec3 voxel) {
+            NodeIndex node = ROOT;
+            for(uint32 depth = 0;; ++depth) {
+                auto child = m_nodes[node].getIndex() + getChildIndex(voxel, depth);
+
+                // Children of the last branch level are always leaves.
+                if(depth == MAX_OCT_TREE_DEPTH - 1) {
+                    m_leaves[m_nodes[child].getIndex()] = std::move(data);
+                    return;
+                }
+
+                if(m_nodes[child].isLeaf()) {
+                    split(child);
+                }
+                node = child;
+            }
+        }
+
+        /**
+         * @brief Inserts the data into the voxel containing the position, splitting leaves on the way down.
+         *
+         * @param data The data to insert.
+         * @param position The position to insert at.
+         */
+        inline void insert(T&& data, glm::vec3 position) { insert(std::move(data), toVoxel(position)); }
+
+        /**
+         * @brief Looks up the data of the voxel.
+         *
+         * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+         * @return const T& The data of the leaf containing the voxel.
+         */
+        [[nodiscard]] const T& get(glm::uvec3 voxel) const noexcept {
+            auto node = m_nodes[ROOT];
+            for(uint32 depth = 0; !node.isLeaf(); ++depth) {
+                node = m_nodes[node.getIndex() + getChildIndex(voxel, depth)];
+            }
+            return m_leaves[node.getIndex()];
+        }
+
+        /**
+         * @brief Converts a position to the coordinates of the voxel containing it.
+         *
+         * @param position The position, positions outside of the tree are clamped to the closest voxel.
+         * @return glm::uvec3 The voxel coordinates relative to the minimum corner of the tree.
+         */
+        [[nodiscard]] inline glm::uvec3 toVoxel(glm::vec3 position) const noexcept {
+            auto minCorner = m_center - static_cast<float32>(CHUNK_LENGTH) / 2.0f;
+            return glm::uvec3(glm::clamp(glm::floor(position - minCorner), 0.0f, static_cast<float32>(CHUNK_LENGTH - 1)));
+        }
+
+        /**
+         * @brief Calls the callback for every leaf in the same order as OctTreeBranch::forEach.
+         *
+         * @param callback The callback which receives the leaf data, the leaf depth and the leaf center.
+         */
+        template<std::invocable<T&, uint32, glm::vec3> F>
+        void forEach(F&& callback) {
+            forEachLeaf(ROOT, 0, m_center, callback);
+        }
+
+        /**
+         * @brief Calls the callback for every leaf in the same order as OctTreeBranch::forEach.
+         *
+         * @param callback The callback which receives the leaf data, the leaf depth and the leaf center.
+         */
+        template<std::invocable<const T&, uint32, glm::vec3> F>
+        void forEach(F&& callback) const {
+            forEachLeaf(ROOT, 0, m_center, callback);
+        }
+
+        /**
+         * @brief Compares the tree with the same semantics as OctTreeNode::equal.
+         *
+         * @param other The tree to compare with.
+         * @return true If both trees are uniform and hold the same data.
+         * @return false Otherwise.
+         */
+        [[nodiscard]] bool equal(const LinearOctTree& other) const noexcept {
+            return nodesEqual(ROOT, other, ROOT);
+        }
+
+        /**
+         * @brief Returns whether all of the node's children are equal.
+         *
+         * @param node The branch node to check.
+         */
+        [[nodiscard]] bool childrenAreEqual(NodeIndex node) const noexcept {
+            auto first = m_nodes[node].getIndex();
+            for(uint32 i = 1; i < 8; ++i) {
+                if(!nodesEqual(first, *this, first + i))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns the length of a node at the provided depth.
+         *
+         * @param depth The depth of the node.
+         * @return uint32 The length.
+         */
+        [[nodiscard]] static inline uint32 getLength(uint32 depth) noexcept {
+            return 1 << (MAX_OCT_TREE_DEPTH - depth);
+        }
+
+        [[nodiscard]] inline glm::vec3 getCenter() const noexcept { return m_center; }
+        [[nodiscard]] inline size_t getNodeCount() const noexcept { return m_nodes.size(); }
+        [[nodiscard]] inline size_t getLeafCount() const noexcept { return m_leaves.size(); }
+        [[nodiscard]] inline const std::vector<Node>& getNodes() const noexcept { return m_nodes; }
+        [[nodiscard]] inline const std::vector<T>& getLeaves() const noexcept { return m_leaves; }
+
+    private:
+        /**
+         * @brief Turns a leaf into a branch whose 8 children hold the leaf's data.
+         *
+         * @param node The leaf node to split.
+         *
+         * @note The first child reuses the payload slot of the split leaf.
+         */
+        void split(NodeIndex node) {
+            auto payload = m_nodes[node].getIndex();
+            auto firstChild = static_cast<NodeIndex>(m_nodes.size());
+
+            m_nodes.push_back(Node::leaf(payload));
+            for(uint32 i = 1; i < 8; ++i) {
+                m_nodes.push_back(Node::leaf(static_cast<uint32>(m_leaves.size())));
+                m_leaves.push_back(m_leaves[payload]);
+            }
+            m_nodes[node] = Node::branch(firstChild);
+        }
+
+        template<typename F>
+        void forEachLeaf(NodeIndex node, uint32 depth, glm::vec3 center, F& callback) {
+            auto current = m_nodes[node];
+            if(current.isLeaf()) {
+                callback(m_leaves[current.getIndex()], depth, center);
+                return;
+            }
+            auto quarter = getLength(depth) / 4.0f;
+            for(uint8 i = 0; i < 8; ++i) {
+                forEachLeaf(current.getIndex() + i, depth + 1, center + convertToOctantDirection(i) * quarter, callback);
+            }
+        }
+
+        template<typename F>
+        void forEachLeaf(NodeIndex node, uint32 depth, glm::vec3 center, F& callback) const {
+            auto current = m_nodes[node];
+            if(current.isLeaf()) {
+                callback(m_leaves[current.getIndex()], depth, center);
+                return;
+            }
+            auto quarter = getLength(depth) / 4.0f;
+            for(uint8 i = 0; i < 8; ++i) {
+                forEachLeaf(current.getIndex() + i, depth + 1, center + convertToOctantDirection(i) * quarter, callback);
+            }
+        }
+
+        [[nodiscard]] bool nodesEqual(NodeIndex node, const LinearOctTree& otherTree, NodeIndex otherNode) const noexcept {
+            auto current = m_nodes[node];
+            auto other = otherTree.m_nodes[otherNode];
+            if(current.isLeaf() && other.isLeaf()) {
+                return m_leaves[current.getIndex()] == otherTree.m_leaves[other.getIndex()];
+            }
+            if(!current.isLeaf() && !other.isLeaf()) {
+                return childrenAreEqual(node) && otherTree.childrenAreEqual(otherNode)
+                    && nodesEqual(current.getIndex(), otherTree, other.getIndex());
+            }
+            return false;
+        }
+
+        std::vector<Node> m_nodes; //< All of the nodes, the first one is the root.
+        std::vector<T> m_leaves; //< The leaf payloads.
+        glm::vec3 m_center; //< The center of the tree.
+    };
+}
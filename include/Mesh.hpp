@@ -1,14 +1,45 @@
 #pragma once
 
 #include "Global.hpp"
+#include "PackedVertex.hpp"
 #include "Vertex.hpp"
 #include <vector>
 
 namespace voxels {
-    struct Mesh {
-        std::vector<Vertex> vertices;
+    template<typename V>
+    struct BasicMesh {
+        std::vector<V> vertices;
         std::vector<uint32> indices;
 
         [[nodiscard]] inline uint32 getIndexCount() const noexcept { return indices.size(); }
+        /**
+         * @brief Returns the number of bytes of the vertices and indices.
+         */
+        [[nodiscard]] inline size_t getSize() const noexcept { return vertices.size() * sizeof(V) + indices.size() * sizeof(uint32); }
     };
+
+    /// @brief A mesh of floating point vertices, as loaded from model files.
+    using Mesh = BasicMesh<Vertex>;
+    /**
+     * @brief A mesh of voxel quads with bit packed vertices.
+     *
+     * @note Every four vertices form a quad whose triangles are the same for all quads, so the indices are left empty
+     * and every packed mesh is drawn with the single index buffer from getQuadIndices.
+     */
+    using PackedMesh = BasicMesh<PackedVertex>;
+
+    /**
+     * @brief Returns the indices of the quads of packed meshes.
+     *
+     * @param quadCount The number of quads.
+     * @return std::vector<uint32> Two triangles per quad, ( 0, 1, 2 ) and ( 0, 2, 3 ) of its four vertices.
+     */
+    [[nodiscard]] inline std::vector<uint32> getQuadIndices(uint32 quadCount) {
+        std::vector<uint32> indices;
+        indices.reserve(static_cast<size_t>(quadCount) * 6);
+        for(uint32 base = 0; base < quadCount * 4; base += 4) {
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+        return indices;
+    }
 }
\ No newline at end of file
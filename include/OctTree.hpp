@@ -1,19 +1,383 @@
 #pragma once
 
 #include "OctTreeNode.hpp"
+#include "OctTreeHelpers.hpp"
+#include "common.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_uint3.hpp"
+#include <algorithm> // For checking if the pending children are uniform.
+#include <concepts> // For constraining the ray cast predicate.
+#include <limits> // For the unbounded ray distance.
+#include <optional> // For the pending leaf data and the ray cast result.
+#include <span> // For the bulk construction input.
+#include <utility> // For std::pair.
+#include <vector> // For the sorted voxels.
 
 namespace voxels {
+    /**
+     * @brief The first leaf hit by a ray.
+     */
+    template<typename T>
+    struct OctTreeHit {
+        const OctTreeLeaf<T>* leaf; //< The hit leaf.
+        float32 distance; //< The distance along the ray to the entry point of the leaf, zero if the ray starts inside it.
+        glm::vec3 normal; //< The normal of the entered face.
+        glm::uvec3 origin; //< The minimum voxel of the leaf.
+        uint32 length; //< The length of the leaf in voxels.
+    };
 
     template<typename T>
     class OctTree {
     public:
+        /**
+         * @brief Constructs a new oct tree.
+         * 
+         * @param data The data the tree is initially filled with, removed voxels are reset to it.
+         * @param center The center of the tree.
+         */
         explicit OctTree(T&& data, glm::vec3 center) noexcept
-            : m_root(OctTreeBranch<T>(std::move(data), 0, center)) {  }
+            : m_root(data, 0)
+            , m_emptyData(std::move(data))
+            , m_center(center) {  }
+
+        /**
+         * @brief Constructs a new oct tree from a set of voxels in one bottom-up pass.
+         * 
+         * @param data The data of every voxel that is not provided, removed voxels are reset to it.
+         * @param center The center of the tree.
+         * @param voxels The voxel coordinates relative to the minimum corner of the tree and their data.
+         *
+         * @note The voxels are radix sorted by their Morton keys so the tree can be built without ever walking from the root,
+         * if a voxel is provided more than once the last occurrence wins. Uniform subtrees are merged while building.
+         */
+        explicit OctTree(T&& data, glm::vec3 center, std::span<const std::pair<glm::uvec3, T>> voxels)
+            : m_root(buildChildren(data, voxels), 0)
+            , m_emptyData(std::move(data))
+            , m_center(center) {  }
+
+        /**
+         * @brief Inserts the data at the provided voxel and merges subtrees that became uniform.
+         * 
+         * @param data The data to insert.
+         * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+         */
+        inline void insert(T&& data, glm::uvec3 voxel) { m_root.insert(std::move(data), voxel); }
+        /**
+         * @brief Inserts the data into the voxel containing the position and merges subtrees that became uniform.
+         * 
+         * @param data The data to insert.
+         * @param position The position to insert at.
+         */
+        inline void insert(T&& data, glm::vec3 position) { insert(std::move(data), toVoxel(position)); }
+        /**
+         * @brief Resets the voxel to the data the tree was created with.
+         * 
+         * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+         */
+        inline void remove(glm::uvec3 voxel) { m_root.insert(T(m_emptyData), voxel); }
+        /**
+         * @brief Resets the voxel containing the position to the data the tree was created with.
+         * 
+         * @param position The position of the voxel.
+         */
+        inline void remove(glm::vec3 position) { remove(toVoxel(position)); }
+        /**
+         * @brief Sets every voxel inside the region to the provided data.
+         * 
+         * @param data The data to fill with.
+         * @param min The minimum voxel of the region.
+         * @param max The maximum voxel of the region ( exclusive ).
+         */
+        inline void fill(const T& data, glm::uvec3 min, glm::uvec3 max) { m_root.fill(data, glm::uvec3(0), min, max); }
+        /**
+         * @brief Sets every voxel whose center lies inside the region to the provided data.
+         * 
+         * @param data The data to fill with.
+         * @param min The minimum corner of the region.
+         * @param max The maximum corner of the region ( exclusive ).
+         */
+        inline void fill(const T& data, glm::vec3 min, glm::vec3 max) { fill(data, toFirstVoxel(min), toFirstVoxel(max)); }
+        /**
+         * @brief Resets every voxel inside the region to the data the tree was created with.
+         * 
+         * @param min The minimum voxel of the region.
+         * @param max The maximum voxel of the region ( exclusive ).
+         */
+        inline void clear(glm::uvec3 min, glm::uvec3 max) { fill(m_emptyData, min, max); }
+        /**
+         * @brief Resets every voxel whose center lies inside the region to the data the tree was created with.
+         * 
+         * @param min The minimum corner of the region.
+         * @param max The maximum corner of the region ( exclusive ).
+         */
+        inline void clear(glm::vec3 min, glm::vec3 max) { fill(m_emptyData, min, max); }
+
+        /**
+         * @brief Looks up the data of the voxel.
+         * 
+         * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+         * @return const T& The data of the leaf containing the voxel.
+         */
+        [[nodiscard]] inline const T& get(glm::uvec3 voxel) const noexcept { return m_root.get(voxel); }
+        /**
+         * @brief Looks up the data of the voxel containing the position.
+         * 
+         * @param position The position.
+         * @return const T& The data of the leaf containing the position.
+         */
+        [[nodiscard]] inline const T& get(glm::vec3 position) const noexcept { return get(toVoxel(position)); }
+
+        /**
+         * @brief Finds the first leaf along the ray whose data differs from the data the tree was created with.
+         * 
+         * @param origin The ray origin.
+         * @param direction The ray direction, it does not have to be normalized but distances are measured in its length.
+         * @param maxDistance Leaves entered after this distance are not hit.
+         * @return std::optional<OctTreeHit<T>> The hit or nothing if the ray does not hit anything.
+         */
+        [[nodiscard]] inline std::optional<OctTreeHit<T>> raycast(glm::vec3 origin, glm::vec3 direction,
+            float32 maxDistance = std::numeric_limits<float32>::max()) const noexcept {
+                return raycast(origin, direction, maxDistance, [this](const T& data) { return !(data == m_emptyData); });
+        }
+
+        /**
+         * @brief Finds the first leaf along the ray that satisfies the predicate.
+         * 
+         * @param origin The ray origin.
+         * @param direction The ray direction, it does not have to be normalized but distances are measured in its length.
+         * @param maxDistance Leaves entered after this distance are not hit.
+         * @param isSolid Returns whether the ray stops at a leaf with the data.
+         * @return std::optional<OctTreeHit<T>> The hit or nothing if the ray does not hit anything.
+         *
+         * @note Uses the parametric traversal by Revelles et al. The ray parameters at which the ray crosses the
+         * planes of a node are split in half for its children, so the children are visited front to back with
+         * a few comparisons each and a uniform leaf of any size is stepped over at once. The cost therefore
+         * grows with the number of nodes along the ray and not with the distance travelled.
+         */
+        template<std::predicate<const T&> P>
+        [[nodiscard]] std::optional<OctTreeHit<T>> raycast(glm::vec3 origin, glm::vec3 direction, float32 maxDistance, P&& isSolid) const noexcept {
+            constexpr auto LENGTH = static_cast<float32>(CHUNK_LENGTH);
+            // Parallel rays get a tiny direction instead, this keeps every ray parameter finite.
+            constexpr float32 MIN_DIRECTION = 1e-20f;
+
+            // Mirror the ray so that every direction component is positive, the mirrored octants are remembered in a mask.
+            auto local = origin - getMinCorner();
+            uint8 mirror = 0;
+            for(glm::length_t axis = 0; axis < 3; ++axis) {
+                if(direction[axis] < 0.0f) {
+                    local[axis] = LENGTH - local[axis];
+                    direction[axis] = -direction[axis];
+                    mirror |= 0b100 >> axis;
+                }
+                direction[axis] = std::max(direction[axis], MIN_DIRECTION);
+            }
+
+            auto t0 = -local / direction;
+            auto t1 = (LENGTH - local) / direction;
+            if(std::max({ t0.x, t0.y, t0.z }) >= std::min({ t1.x, t1.y, t1.z }))
+                return std::nullopt;
+
+            auto traversal = Traversal<P> { isSolid, mirror, maxDistance };
+            auto hit = traversal.visit(m_root, t0, t1, glm::uvec3(0));
+            if(hit) {
+                // Mirrored faces point the other way.
+                for(glm::length_t axis = 0; axis < 3; ++axis) {
+                    if(mirror & (0b100 >> axis))
+                        hit->normal[axis] = -hit->normal[axis];
+                }
+            }
+            return hit;
+        }
+
+        /**
+         * @brief Converts a position to the coordinates of the voxel containing it.
+         * 
+         * @param position The position, positions outside of the tree are clamped to the closest voxel.
+         * @return glm::uvec3 The voxel coordinates relative to the minimum corner of the tree.
+         */
+        [[nodiscard]] inline glm::uvec3 toVoxel(glm::vec3 position) const noexcept {
+            return glm::uvec3(glm::clamp(glm::floor(position - getMinCorner()), 0.0f, static_cast<float32>(CHUNK_LENGTH - 1)));
+        }
+
+        /**
+         * @brief Returns the number of bytes used by all of the nodes of the tree.
+         */
+        [[nodiscard]] inline size_t getMemoryUsage() const noexcept { return m_root.getMemoryUsage(); }
+        /**
+         * @brief Returns the number of nodes in the tree.
+         */
+        [[nodiscard]] inline size_t getNodeCount() const noexcept { return m_root.getNodeCount(); }
 
         [[nodiscard]] inline OctTreeBranch<T>& getRoot() noexcept { return m_root; }
         [[nodiscard]] inline const OctTreeBranch<T>& getRoot() const noexcept { return m_root; }
+        [[nodiscard]] inline const T& getEmptyData() const noexcept { return m_emptyData; }
+        [[nodiscard]] inline glm::vec3 getCenter() const noexcept { return m_center; }
+        [[nodiscard]] inline glm::vec3 getMinCorner() const noexcept { return m_center - static_cast<float32>(CHUNK_LENGTH) / 2.0f; }
 
     private:
+        using ChildNode = typename OctTreeBranch<T>::ChildNode;
+        using Children = std::array<ChildNode, 8>;
+
+        /**
+         * @brief The state of a single ray cast in the mirrored space where the ray direction is positive.
+         */
+        template<typename P>
+        struct Traversal {
+            P& isSolid; //< Returns whether the ray stops at a leaf.
+            uint8 mirror; //< The octant bits of the mirrored axes.
+            float32 maxDistance; //< The maximum entry distance.
+
+            /**
+             * @brief Returns the first child of a branch that the ray enters.
+             *
+             * @note The child is found from the plane the ray entered the branch through and from which midplanes it crossed before.
+             */
+            [[nodiscard]] static inline uint8 getFirstOctant(glm::vec3 t0, glm::vec3 tm) noexcept {
+                uint8 octant = 0;
+                if(t0.x > t0.y && t0.x > t0.z) {
+                    octant |= (tm.y < t0.x) << 1 | (tm.z < t0.x);
+                } else if(t0.y > t0.z) {
+                    octant |= (tm.x < t0.y) << 2 | (tm.z < t0.y);
+                } else {
+                    octant |= (tm.x < t0.z) << 2 | (tm.y < t0.z) << 1;
+                }
+                return octant;
+            }
+
+            /**
+             * @brief Returns the child the ray enters after leaving the child with the exit parameters, 8 if it leaves the branch.
+             */
+            [[nodiscard]] static inline uint8 getNextOctant(uint8 octant, glm::vec3 t1) noexcept {
+                uint8 bit = t1.x < t1.y && t1.x < t1.z ? 0b100 : t1.y < t1.z ? 0b010 : 0b001;
+                return octant & bit ? 8 : octant | bit;
+            }
+
+            /**
+             * @brief Visits the node the ray crosses between the parameters t0 and t1.
+             *
+             * @param node The node.
+             * @param t0 The parameters at which the ray crosses the minimum planes of the node.
+             * @param t1 The parameters at which the ray crosses the maximum planes of the node.
+             * @param origin The minimum voxel of the node.
+             */
+            [[nodiscard]] std::optional<OctTreeHit<T>> visit(const OctTreeNode<T>& node, glm::vec3 t0, glm::vec3 t1, glm::uvec3 origin) const noexcept {
+                auto entry = std::max({ t0.x, t0.y, t0.z });
+                if(std::min({ t1.x, t1.y, t1.z }) < 0.0f || entry > maxDistance)
+                    return std::nullopt;
+
+                if(auto leaf = dynamic_cast<const OctTreeLeaf<T>*>(&node)) {
+                    if(!isSolid(leaf->getData()))
+                        return std::nullopt;
+                    auto normal = glm::vec3(0.0f);
+                    normal[t0.x >= t0.y && t0.x >= t0.z ? 0 : t0.y >= t0.z ? 1 : 2] = -1.0f;
+                    return OctTreeHit<T> { leaf, std::max(entry, 0.0f), normal, origin, leaf->getLength() };
+                }
+
+                auto& branch = static_cast<const OctTreeBranch<T>&>(node);
+                auto tm = (t0 + t1) * 0.5f;
+                for(auto octant = getFirstOctant(t0, tm); octant < 8;) {
+                    auto childT0 = glm::vec3(octant & 0b100 ? tm.x : t0.x, octant & 0b010 ? tm.y : t0.y, octant & 0b001 ? tm.z : t0.z);
+                    auto childT1 = glm::vec3(octant & 0b100 ? t1.x : tm.x, octant & 0b010 ? t1.y : tm.y, octant & 0b001 ? t1.z : tm.z);
+
+                    auto index = convertOctantToScalarIndex(octant ^ mirror);
+                    if(auto hit = visit(*branch.getChildren()[index], childT0, childT1, getChildOrigin(origin, index, node.depth)))
+                        return hit;
+
+                    octant = getNextOctant(octant, childT1);
+                }
+                return std::nullopt;
+            }
+        };
+
+        /**
+         * @brief Returns the first voxel whose center is not below the position on any axis, clamped to the tree.
+         */
+        [[nodiscard]] inline glm::uvec3 toFirstVoxel(glm::vec3 position) const noexcept {
+            return glm::uvec3(glm::clamp(glm::ceil(position - getMinCorner() - 0.5f), 0.0f, static_cast<float32>(CHUNK_LENGTH)));
+        }
+
+        /**
+         * @brief Builds the children of the root from the voxels.
+         * 
+         * @param empty The data of the voxels that are not provided.
+         * @param voxels The voxels.
+         * @return Children The children of the root.
+         */
+        [[nodiscard]] static Children buildChildren(const T& empty, std::span<const std::pair<glm::uvec3, T>> voxels) {
+            std::vector<std::pair<MortonKey, uint32>> keys;
+            keys.reserve(voxels.size());
+            for(uint32 i = 0; i < voxels.size(); ++i) {
+                keys.emplace_back(encodeMorton(voxels[i].first), i);
+            }
+            radixSortByKey(keys, 3 * MAX_OCT_TREE_DEPTH);
+
+            /**
+             * @brief A child of a branch that is still being built.
+             *
+             * @note Uniform subtrees stay plain data until their parent turns out not to be uniform,
+             * so dense regions never allocate nodes. A slot without a node or data is empty.
+             */
+            struct PendingChild {
+                ChildNode node;
+                std::optional<T> data;
+            };
+            // pending[depth] holds the children of the branch at that depth that is currently being built.
+            std::array<std::array<PendingChild, 8>, MAX_OCT_TREE_DEPTH> pending;
+
+            // Turns the pending children of the branch at the depth into nodes.
+            auto materialize = [&](uint32 depth) {
+                Children children;
+                for(uint8 i = 0; i < 8; ++i) {
+                    auto& child = pending[depth][i];
+                    children[i] = child.node
+                        ? std::move(child.node)
+                        : std::make_unique<OctTreeLeaf<T>>(child.data ? std::move(*child.data) : T(empty), depth + 1);
+                    child = {};
+                }
+                return children;
+            };
+
+            // Moves the branch at the depth into its parent, as plain data if all of its children are the same data.
+            auto finalize = [&](MortonKey key, uint32 depth) {
+                auto& children = pending[depth];
+                auto& parent = pending[depth - 1][convertOctantToScalarIndex(getMortonOctant(key, depth - 1))];
+
+                const T& first = children[0].data ? *children[0].data : empty;
+                bool uniform = std::ranges::all_of(children, [&](const PendingChild& child) {
+                    return !child.node && (child.data ? *child.data : empty) == first;
+                });
+                if(uniform) {
+                    parent.data = first;
+                    children = {};
+                    return;
+                }
+
+                parent.node = std::make_unique<OctTreeBranch<T>>(materialize(depth), depth);
+            };
+
+            for(size_t i = 0; i < keys.size(); ++i) {
+                auto key = keys[i].first;
+                // Duplicates are sorted stably, only the last one is kept.
+                if(i + 1 < keys.size() && keys[i + 1].first == key)
+                    continue;
+
+                pending[MAX_OCT_TREE_DEPTH - 1][convertOctantToScalarIndex(getMortonOctant(key, MAX_OCT_TREE_DEPTH - 1))].data = voxels[keys[i].second].second;
+
+                // Finalize every branch that the next voxel does not share with this one, deepest first.
+                auto next = i + 1 < keys.size() ? keys[i + 1].first : ~key;
+                for(uint32 depth = MAX_OCT_TREE_DEPTH - 1; depth > 0; --depth) {
+                    auto shift = 3 * (MAX_OCT_TREE_DEPTH - depth);
+                    if((key >> shift) == (next >> shift))
+                        break;
+                    finalize(key, depth);
+                }
+            }
+
+            return materialize(0);
+        }
+
         OctTreeBranch<T> m_root;
+        T m_emptyData; //< The data the tree was created with.
+        glm::vec3 m_center; //< The center of the tree, only used to convert positions to voxels.
     };
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Global.hpp"
+#include "OctTree.hpp"
+#include "OctTreeHelpers.hpp"
+#include "common.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_uint3.hpp"
+#include <algorithm> // For sorting the children by distance.
+#include <array> // For the child references.
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <functional> // For std::hash.
+#include <optional> // For the ray hit.
+#include <unordered_map> // For hash consing the nodes.
+#include <utility> // For std::pair.
+#include <vector> // For the node storage.
+
+namespace voxels {
+    /**
+     * @brief Read only sparse voxel directed acyclic graph built from an oct tree.
+     *
+     * @tparam T The leaf data type, it has to be hashable with std::hash.
+     *
+     * @note Identical subtrees are stored only once. Two leaves are identical when their data compares equal
+     * and two branches are identical when they are at the same depth and their children are identical,
+     * which is the same notion of equality as OctTreeNode::equal.
+     */
+    template<typename T>
+    class OctTreeDag {
+    public:
+        /// @brief A reference to either a branch or a leaf.
+        using NodeRef = uint32;
+        /// @brief Set on references that point into the leaf array.
+        static constexpr NodeRef LEAF_FLAG = 1u << 31;
+
+        /**
+         * @brief The first leaf a ray hits.
+         */
+        struct RayHit {
+            const T* data; //< The data of the hit leaf.
+            float32 distance; //< The distance along the ray at which the leaf was entered.
+            glm::vec3 normal; //< The normal of the face through which the leaf was entered, zero if the ray started inside it.
+        };
+
+        /**
+         * @brief Builds the graph from the oct tree.
+         *
+         * @param tree The tree to compress.
+         */
+        explicit OctTreeDag(const OctTree<T>& tree) : m_center(tree.getCenter()) {
+            Builder builder { *this };
+            m_root = builder.add(tree.getRoot());
+        }
+
+        /**
+         * @brief Looks up the data of the voxel.
+         *
+         * @param voxel The voxel coordinates relative to the minimum corner of the graph.
+         * @return const T& The data of the leaf containing the voxel.
+         */
+        [[nodiscard]] const T& get(glm::uvec3 voxel) const noexcept {
+            auto node = m_root;
+            for(uint32 depth = 0; !(node & LEAF_FLAG); ++depth) {
+                node = m_branches[node][getChildIndex(voxel, depth)];
+            }
+            return m_leaves[node & ~LEAF_FLAG];
+        }
+
+        /**
+         * @brief Looks up the data of the voxel containing the position.
+         *
+         * @param position The position, positions outside of the graph are clamped to the closest voxel.
+         * @return const T& The data of the leaf containing the position.
+         */
+        [[nodiscard]] inline const T& get(glm::vec3 position) const noexcept {
+            auto minCorner = m_center - static_cast<float32>(CHUNK_LENGTH) / 2.0f;
+            return get(glm::uvec3(glm::clamp(glm::floor(position - minCorner), 0.0f, static_cast<float32>(CHUNK_LENGTH - 1))));
+        }
+
+        /**
+         * @brief Calls the callback for every leaf of the uncompressed tree, shared subtrees are visited once per occurrence.
+         *
+         * @param callback The callback which receives the leaf data, the leaf depth and the leaf center.
+         */
+        template<std::invocable<const T&, uint32, glm::vec3> F>
+        void forEach(F&& callback) const {
+            forEachLeaf(m_root, 0, m_center, callback);
+        }
+
+        /**
+         * @brief Finds the first leaf along the ray for which the predicate returns true.
+         *
+         * @param origin The ray origin.
+         * @param direction The ray direction, it does not need to be normalized but distances are measured in its length.
+         * @param isSolid Returns true for leaf data that should stop the ray.
+         * @return std::optional<RayHit> The hit, if any.
+         *
+         * @note Children are visited front to back and empty subtrees are skipped as a whole.
+         */
+        template<std::predicate<const T&> P>
+        [[nodiscard]] std::optional<RayHit> castRay(glm::vec3 origin, glm::vec3 direction, P&& isSolid) const {
+            auto inverseDirection = 1.0f / direction;
+            auto half = getLength(0) / 2.0f;
+            auto [entry, exit] = intersect(origin, inverseDirection, m_center - half, m_center + half);
+            if(entry > exit || exit < 0.0f)
+                return {};
+            return castRay(m_root, 0, m_center, origin, inverseDirection, isSolid);
+        }
+
+        [[nodiscard]] inline size_t getBranchCount() const noexcept { return m_branches.size(); }
+        [[nodiscard]] inline size_t getLeafCount() const noexcept { return m_leaves.size(); }
+        [[nodiscard]] inline size_t getNodeCount() const noexcept { return m_branches.size() + m_leaves.size(); }
+        /**
+         * @brief Returns the number of bytes used by the nodes of the graph.
+         */
+        [[nodiscard]] inline size_t getMemoryUsage() const noexcept {
+            return m_branches.size() * sizeof(std::array<NodeRef, 8>) + m_leaves.size() * sizeof(T);
+        }
+
+        [[nodiscard]] static inline uint32 getLength(uint32 depth) noexcept {
+            return 1 << (MAX_OCT_TREE_DEPTH - depth);
+        }
+
+    private:
+        /**
+         * @brief Hash conses the oct tree nodes into the graph.
+         */
+        struct Builder {
+            struct BranchKey {
+                std::array<NodeRef, 8> children;
+                uint32 depth;
+
+                [[nodiscard]] bool operator==(const BranchKey&) const noexcept = default;
+            };
+            struct BranchKeyHash {
+                [[nodiscard]] size_t operator()(const BranchKey& key) const noexcept {
+                    size_t hash = key.depth;
+                    for(auto child : key.children) {
+                        hash ^= std::hash<NodeRef>()(child) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+                    }
+                    return hash;
+                }
+            };
+
+            NodeRef add(const OctTreeNode<T>& node) {
+                if(auto leaf = dynamic_cast<const OctTreeLeaf<T>*>(&node)) {
+                    auto [it, inserted] = leaves.try_emplace(leaf->getData(), static_cast<NodeRef>(dag.m_leaves.size()) | LEAF_FLAG);
+                    if(inserted)
+                        dag.m_leaves.push_back(leaf->getData());
+                    return it->second;
+                }
+
+                auto& branch = static_cast<const OctTreeBranch<T>&>(node);
+                BranchKey key { {}, node.depth };
+                for(uint8 i = 0; i < 8; ++i) {
+                    key.children[i] = add(*branch.getChildren()[i]);
+                }
+
+                // A branch whose children are all the same leaf is that leaf.
+                if((key.children[0] & LEAF_FLAG) && std::ranges::all_of(key.children, [&](NodeRef child) { return child == key.children[0]; }))
+                    return key.children[0];
+
+                auto [it, inserted] = branches.try_emplace(key, static_cast<NodeRef>(dag.m_branches.size()));
+                if(inserted)
+                    dag.m_branches.push_back(key.children);
+                return it->second;
+            }
+
+            OctTreeDag& dag;
+            std::unordered_map<T, NodeRef> leaves = {};
+            std::unordered_map<BranchKey, NodeRef, BranchKeyHash> branches = {};
+        };
+
+        /**
+         * @brief Intersects the ray with an axis aligned box.
+         *
+         * @return std::pair<float32, float32> The entry and exit distances, the ray misses if entry > exit.
+         */
+        [[nodiscard]] static inline std::pair<float32, float32> intersect(glm::vec3 origin, glm::vec3 inverseDirection, glm::vec3 min, glm::vec3 max) noexcept {
+            auto t0 = (min - origin) * inverseDirection;
+            auto t1 = (max - origin) * inverseDirection;
+            auto near = glm::min(t0, t1);
+            auto far = glm::max(t0, t1);
+            return {
+                glm::max(glm::max(near.x, near.y), near.z),
+                glm::min(glm::min(far.x, far.y), far.z)
+            };
+        }
+
+        template<typename P>
+        [[nodiscard]] std::optional<RayHit> castRay(NodeRef node, uint32 depth, glm::vec3 center, glm::vec3 origin, glm::vec3 inverseDirection, P& isSolid) const {
+            auto half = getLength(depth) / 2.0f;
+
+            if(node & LEAF_FLAG) {
+                const auto& data = m_leaves[node & ~LEAF_FLAG];
+                if(!isSolid(data))
+                    return {};
+
+                auto t0 = (center - half - origin) * inverseDirection;
+                auto t1 = (center + half - origin) * inverseDirection;
+                auto near = glm::min(t0, t1);
+                auto entry = glm::max(glm::max(near.x, near.y), near.z);
+                if(entry <= 0.0f)
+                    return RayHit { &data, 0.0f, glm::vec3(0.0f) };
+
+                // The entry face is on the axis that was entered last.
+                auto axis = near.x == entry ? 0 : near.y == entry ? 1 : 2;
+                auto normal = glm::vec3(0.0f);
+                normal[axis] = inverseDirection[axis] > 0.0f ? -1.0f : 1.0f;
+                return RayHit { &data, entry, normal };
+            }
+
+            // Sort the intersected children front to back.
+            struct Candidate { float32 entry; uint8 index; };
+            std::array<Candidate, 8> candidates;
+            uint32 count = 0;
+            auto quarter = half / 2.0f;
+            for(uint8 i = 0; i < 8; ++i) {
+                auto childCenter = center + convertToOctantDirection(i) * quarter;
+                auto [entry, exit] = intersect(origin, inverseDirection, childCenter - quarter, childCenter + quarter);
+                if(entry <= exit && exit >= 0.0f)
+                    candidates[count++] = { entry, i };
+            }
+            std::sort(candidates.begin(), candidates.begin() + count, [](const Candidate& a, const Candidate& b) { return a.entry < b.entry; });
+
+            for(uint32 i = 0; i < count; ++i) {
+                auto index = candidates[i].index;
+                auto childCenter = center + convertToOctantDirection(index) * quarter;
+                if(auto hit = castRay(m_branches[node][index], depth + 1, childCenter, origin, inverseDirection, isSolid))
+                    return hit;
+            }
+            return {};
+        }
+
+        template<typename F>
+        void forEachLeaf(NodeRef node, uint32 depth, glm::vec3 center, F& callback) const {
+            if(node & LEAF_FLAG) {
+                callback(m_leaves[node & ~LEAF_FLAG], depth, center);
+                return;
+            }
+            auto quarter = getLength(depth) / 4.0f;
+            for(uint8 i = 0; i < 8; ++i) {
+                forEachLeaf(m_branches[node][i], depth + 1, center + convertToOctantDirection(i) * quarter, callback);
+            }
+        }
+
+        std::vector<std::array<NodeRef, 8>> m_branches; //< The unique branches.
+        std::vector<T> m_leaves; //< The unique leaf data.
+        NodeRef m_root = 0; //< The root reference.
+        glm::vec3 m_center; //< The center of the graph.
+    };
+}
@@ -3,6 +3,10 @@
 #include "Global.hpp"
 #include "ext/vector_bool3.hpp"
 #include "ext/vector_float3.hpp"
+#include "ext/vector_uint3.hpp"
+#include <array> // For the radix sort histogram.
+#include <utility> // For std::pair.
+#include <vector> // For the radix sort buffer.
 
 namespace voxels {
     /**
@@ -28,4 +32,189 @@ namespace voxels {
     static uint8 convertToScalarIndex(const glm::bvec3& index) noexcept {
         return (index.x << 2) | (index.y << 1) | index.z; // Magic formula ai gave me.
     }
+
+    /**
+     * @brief Converts a scalar index to the direction of its octant relative to the parent's center.
+     * 
+     * @param index The scalar index.
+     * @return glm::vec3 A vector whose components are either 1 or -1.
+     *
+     * @note This is the inverse of convertToScalarIndex(convertToNormalizedIndex(delta)) up to scale.
+     */
+    static glm::vec3 convertToOctantDirection(uint8 index) noexcept {
+        return {
+            index & 0b100 ? 1.0f : -1.0f,
+            index & 0b010 ? -1.0f : 1.0f,
+            index & 0b001 ? 1.0f : -1.0f,
+        };
+    }
+
+    /// @brief A Morton ( Z-order ) key, the bits of the x, y and z coordinates interleaved from the most significant bit.
+    using MortonKey = uint64;
+    /// @brief The number of bits per axis that fit into a Morton key.
+    static constexpr const uint32 MORTON_AXIS_BITS = 21;
+
+    static_assert(MAX_OCT_TREE_DEPTH <= MORTON_AXIS_BITS, "The oct tree is too deep for 64 bit Morton keys.");
+
+    /**
+     * @brief Spreads the lower 21 bits of the value so that there are two zero bits between each of them.
+     * 
+     * @param value The value to spread.
+     * @return MortonKey The spread bits.
+     */
+    [[nodiscard]] static constexpr MortonKey spreadBits(uint32 value) noexcept {
+        MortonKey bits = value & 0x1FFFFF;
+        bits = (bits | bits << 32) & 0x1F00000000FFFF;
+        bits = (bits | bits << 16) & 0x1F0000FF0000FF;
+        bits = (bits | bits << 8) & 0x100F00F00F00F00F;
+        bits = (bits | bits << 4) & 0x10C30C30C30C30C3;
+        bits = (bits | bits << 2) & 0x1249249249249249;
+        return bits;
+    }
+
+    /**
+     * @brief The inverse of spreadBits, gathers every third bit into the lower 21 bits.
+     * 
+     * @param bits The spread bits.
+     * @return uint32 The compacted value.
+     */
+    [[nodiscard]] static constexpr uint32 compactBits(MortonKey bits) noexcept {
+        bits &= 0x1249249249249249;
+        bits = (bits ^ (bits >> 2)) & 0x10C30C30C30C30C3;
+        bits = (bits ^ (bits >> 4)) & 0x100F00F00F00F00F;
+        bits = (bits ^ (bits >> 8)) & 0x1F0000FF0000FF;
+        bits = (bits ^ (bits >> 16)) & 0x1F00000000FFFF;
+        bits = (bits ^ (bits >> 32)) & 0x1FFFFF;
+        return static_cast<uint32>(bits);
+    }
+
+    /**
+     * @brief Encodes integer voxel coordinates into a Morton key.
+     * 
+     * @param voxel The voxel coordinates, each component has to fit into 21 bits.
+     * @return MortonKey The Morton key.
+     */
+    [[nodiscard]] static constexpr MortonKey encodeMorton(glm::uvec3 voxel) noexcept {
+        return (spreadBits(voxel.x) << 2) | (spreadBits(voxel.y) << 1) | spreadBits(voxel.z);
+    }
+
+    /**
+     * @brief Decodes a Morton key into integer voxel coordinates.
+     * 
+     * @param key The Morton key.
+     * @return glm::uvec3 The voxel coordinates.
+     */
+    [[nodiscard]] static constexpr glm::uvec3 decodeMorton(MortonKey key) noexcept {
+        return { compactBits(key >> 2), compactBits(key >> 1), compactBits(key) };
+    }
+
+    /**
+     * @brief Gets the octant that a node at the provided depth descends into for the key.
+     * 
+     * @param key The Morton key of a voxel in an oct tree of MAX_OCT_TREE_DEPTH.
+     * @param depth The depth of the node.
+     * @return uint8 The octant, x in the highest and z in the lowest bit.
+     */
+    [[nodiscard]] static constexpr uint8 getMortonOctant(MortonKey key, uint32 depth) noexcept {
+        return (key >> (3 * (MAX_OCT_TREE_DEPTH - 1 - depth))) & 0b111;
+    }
+
+    /**
+     * @brief Converts a Morton octant to the scalar index used by the oct tree nodes.
+     * 
+     * @param octant The octant.
+     * @return uint8 The scalar index.
+     *
+     * @note The scalar index has the y bit set for the lower half while voxel coordinates grow upwards.
+     */
+    [[nodiscard]] static constexpr uint8 convertOctantToScalarIndex(uint8 octant) noexcept {
+        return octant ^ 0b010;
+    }
+
+    /**
+     * @brief Gets the scalar index of the child that a branch at the provided depth descends into for the voxel.
+     *
+     * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+     * @param depth The depth of the branch.
+     * @return uint8 The scalar index.
+     */
+    [[nodiscard]] static constexpr uint8 getChildIndex(glm::uvec3 voxel, uint32 depth) noexcept {
+        auto shift = MAX_OCT_TREE_DEPTH - 1 - depth;
+        auto octant = ((voxel.x >> shift) & 1) << 2 | ((voxel.y >> shift) & 1) << 1 | ((voxel.z >> shift) & 1);
+        return convertOctantToScalarIndex(static_cast<uint8>(octant));
+    }
+
+    /**
+     * @brief Gets the minimum corner of a branch's child.
+     *
+     * @param origin The minimum corner of the branch.
+     * @param index The scalar index of the child.
+     * @param depth The depth of the branch.
+     * @return glm::uvec3 The minimum corner of the child.
+     */
+    [[nodiscard]] static constexpr glm::uvec3 getChildOrigin(glm::uvec3 origin, uint8 index, uint32 depth) noexcept {
+        // The conversion flips a single bit so it is its own inverse.
+        auto octant = convertOctantToScalarIndex(index);
+        auto shift = MAX_OCT_TREE_DEPTH - 1 - depth;
+        return {
+            origin.x | ((octant >> 2) & 1u) << shift,
+            origin.y | ((octant >> 1) & 1u) << shift,
+            origin.z | (octant & 1u) << shift,
+        };
+    }
+
+    /**
+     * @brief Walks from the root to the deepest level using only the child indices and returns the reached origin.
+     *
+     * @note Used to check at compile time that every voxel at the maximum depth is addressed exactly.
+     */
+    [[nodiscard]] static constexpr glm::uvec3 descendToVoxel(glm::uvec3 voxel) noexcept {
+        glm::uvec3 origin(0);
+        for(uint32 depth = 0; depth < MAX_OCT_TREE_DEPTH; ++depth) {
+            origin = getChildOrigin(origin, getChildIndex(voxel, depth), depth);
+        }
+        return origin;
+    }
+
+    static_assert(descendToVoxel({ 0, 0, 0 }) == glm::uvec3(0, 0, 0));
+    static_assert(descendToVoxel({ CHUNK_LENGTH - 1, CHUNK_LENGTH - 1, CHUNK_LENGTH - 1 }) == glm::uvec3(CHUNK_LENGTH - 1));
+    static_assert(descendToVoxel({ CHUNK_LENGTH / 2 - 1, CHUNK_LENGTH / 2, 1 }) == glm::uvec3(CHUNK_LENGTH / 2 - 1, CHUNK_LENGTH / 2, 1));
+    static_assert(descendToVoxel({ 0b10101010 % CHUNK_LENGTH, 0b01010101 % CHUNK_LENGTH, CHUNK_LENGTH - 2 }) == glm::uvec3(0b10101010 % CHUNK_LENGTH, 0b01010101 % CHUNK_LENGTH, CHUNK_LENGTH - 2));
+    static_assert(getChildIndex({ CHUNK_LENGTH - 1, 0, 0 }, 0) == convertOctantToScalarIndex(getMortonOctant(encodeMorton({ CHUNK_LENGTH - 1, 0, 0 }), 0)));
+
+    static_assert(decodeMorton(encodeMorton({ 0x1FFFFF, 0, 0x15555 })) == glm::uvec3(0x1FFFFF, 0, 0x15555));
+    static_assert(encodeMorton({ 1, 0, 0 }) == 0b100 && encodeMorton({ 0, 1, 0 }) == 0b010 && encodeMorton({ 0, 0, 1 }) == 0b001);
+    static_assert(getMortonOctant(encodeMorton({ CHUNK_LENGTH - 1, 0, 0 }), 0) == 0b100);
+
+    /**
+     * @brief Stable least significant digit radix sort of ( key, value ) pairs by key.
+     * 
+     * @param pairs The pairs to sort.
+     * @param keyBits How many of the lower key bits are significant.
+     */
+    template<typename T>
+    static void radixSortByKey(std::vector<std::pair<MortonKey, T>>& pairs, uint32 keyBits) {
+        constexpr uint32 RADIX_BITS = 8;
+        constexpr uint32 BUCKET_COUNT = 1 << RADIX_BITS;
+
+        std::vector<std::pair<MortonKey, T>> buffer(pairs.size());
+        for(uint32 shift = 0; shift < keyBits; shift += RADIX_BITS) {
+            std::array<size_t, BUCKET_COUNT> offsets = {};
+            for(const auto& pair : pairs) {
+                ++offsets[(pair.first >> shift) & (BUCKET_COUNT - 1)];
+            }
+
+            size_t total = 0;
+            for(auto& offset : offsets) {
+                auto count = offset;
+                offset = total;
+                total += count;
+            }
+
+            for(auto& pair : pairs) {
+                buffer[offsets[(pair.first >> shift) & (BUCKET_COUNT - 1)]++] = std::move(pair);
+            }
+            pairs.swap(buffer);
+        }
+    }
 }
\ No newline at end of file
@@ -2,30 +2,51 @@
 
 #include "Global.hpp"
 #include "OctTreeHelpers.hpp"
-#include "ext/vector_float3.hpp"
+#include "ext/vector_uint3.hpp"
+#include "vector_relational.hpp"
 #include <array>
+#include <cstddef>
 #include <functional>
 #include <memory>
 
 namespace voxels {
+    /**
+     * @brief Base class of the oct tree nodes.
+     *
+     * @note Nodes do not store their position, it is derived from the depth and the path taken from the root,
+     * every position a node receives is an integer voxel coordinate relative to the minimum corner of the tree.
+     * This keeps inserts and lookups exact at any depth up to MORTON_AXIS_BITS.
+     */
     template<typename T>
     class OctTreeNode {
     public:
-        explicit OctTreeNode(uint32 depth, glm::vec3 center) noexcept
-            : depth(depth)
-            , center(center) {  }
+        explicit OctTreeNode(uint32 depth) noexcept
+            : depth(static_cast<uint8>(depth)) {  }
         virtual ~OctTreeNode() = default;
 
         virtual void forEach(std::function<void(OctTreeNode<T>&)> callback) = 0;
-        virtual void insert(T&& data, glm::vec3 position) = 0;
+        virtual void insert(T&& data, glm::uvec3 voxel) = 0;
+        /**
+         * @brief Returns the data of the leaf containing the voxel.
+         *
+         * @param voxel The voxel coordinates relative to the minimum corner of the tree.
+         */
+        [[nodiscard]] virtual const T& get(glm::uvec3 voxel) const noexcept = 0;
         [[nodiscard]] virtual bool equal(const OctTreeNode<T>& other) const noexcept = 0;
+        /**
+         * @brief Returns the number of bytes used by this node and all of its descendants.
+         */
+        [[nodiscard]] virtual size_t getMemoryUsage() const noexcept = 0;
+        /**
+         * @brief Returns the number of nodes in this subtree including this node.
+         */
+        [[nodiscard]] virtual size_t getNodeCount() const noexcept = 0;
 
         [[nodiscard]] virtual uint32 getLength() const noexcept {
             return 1 << (MAX_OCT_TREE_DEPTH - depth);
         }
 
-        const uint32 depth;
-        const glm::vec3 center;
+        const uint8 depth;
     };
 
     template<typename T>
@@ -33,17 +54,19 @@ namespace voxels {
     public:
         using OctTreeNode<T>::depth;
 
-        OctTreeLeaf(T&& data, uint32 depth, glm::vec3 center) noexcept : data(std::move(data)), OctTreeNode<T>(depth, center) {  }
+        OctTreeLeaf(T&& data, uint32 depth) noexcept : data(std::move(data)), OctTreeNode<T>(depth) {  }
         virtual ~OctTreeLeaf() override = default;
 
         virtual void forEach(std::function<void(OctTreeNode<T>&)> callback) override {
             callback(*this);
         }
 
-        virtual void insert(T&& data, glm::vec3) override {
-            data = std::move(data);
+        virtual void insert(T&& newData, glm::uvec3) override {
+            data = std::move(newData);
         }
 
+        [[nodiscard]] virtual const T& get(glm::uvec3) const noexcept override { return data; }
+
         [[nodiscard]] virtual bool equal(const OctTreeNode<T>& other) const noexcept override {
             if(depth == other.depth) {
                 if(auto leaf = dynamic_cast<const OctTreeLeaf<T>*>(&other)) {
@@ -53,6 +76,9 @@ namespace voxels {
             return false;
         }
 
+        [[nodiscard]] virtual size_t getMemoryUsage() const noexcept override { return sizeof(*this); }
+        [[nodiscard]] virtual size_t getNodeCount() const noexcept override { return 1; }
+
         [[nodiscard]] inline const T& getData() const noexcept { return data; }
         [[nodiscard]] inline T& getData() noexcept { return data; }
 
@@ -63,28 +89,22 @@ namespace voxels {
     template<typename T>
     class OctTreeBranch: public OctTreeNode<T> {
     public:
-        using OctTreeNode<T>::depth, OctTreeNode<T>::center, OctTreeNode<T>::getLength;
+        using OctTreeNode<T>::depth, OctTreeNode<T>::getLength;
         using ChildNode = std::unique_ptr<OctTreeNode<T>>;
 
         OctTreeBranch() noexcept = delete;
-        explicit OctTreeBranch(std::array<ChildNode, 8>&& children, uint32 depth, glm::vec3 center) noexcept
+        explicit OctTreeBranch(std::array<ChildNode, 8>&& children, uint32 depth) noexcept
             : m_children(std::move(children))
-            , OctTreeNode<T>(depth, center) {  }
-        explicit OctTreeBranch(T& data, uint32 depth, glm::vec3 center) noexcept 
-            : voxels::OctTreeNode<T>(depth, center)
+            , OctTreeNode<T>(depth) {  }
+        explicit OctTreeBranch(T& data, uint32 depth) noexcept
+            : voxels::OctTreeNode<T>(depth)
             , m_children([&] -> std::array<ChildNode, 8> {
-                // The half of the childs length is the quarter of this length.
-                float half = getLength() / 4;
-                return {
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ -half, half, -half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ -half, half, half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ -half, -half, -half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ -half, -half, half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ half, half, -half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ half, half, half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ half, -half, -half }),
-                    std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, center + glm::vec3{ half, -half, half }),
-                };
+                // Every child gets its own copy, moving the same data eight times would leave seven children empty.
+                std::array<ChildNode, 8> children;
+                for(auto& child : children) {
+                    child = std::make_unique<OctTreeLeaf<T>>(T(data), depth + 1);
+                }
+                return children;
             }()) {  }
 
         virtual ~OctTreeBranch() override = default;
@@ -96,32 +116,93 @@ namespace voxels {
             }
         }
 
-        virtual void insert(T&& data, glm::vec3 position) override {
-
-            auto delta = position - center;
-            auto nIndex = convertToNormalizedIndex(delta);
-            auto index = convertToScalarIndex(nIndex);
+        virtual void insert(T&& data, glm::uvec3 voxel) override {
+            auto index = getChildIndex(voxel, depth);
 
             if(depth == MAX_OCT_TREE_DEPTH - 1) {
-                auto newCenter = center + glm::vec3{
-                    static_cast<int>(nIndex.x) * (getLength() / 2),
-                    static_cast<int>(nIndex.y) * (getLength() / 2),
-                    static_cast<int>(nIndex.z) * (getLength() / 2)  
-                };
-                m_children[index] = std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1, newCenter);
+                if(auto leaf = dynamic_cast<OctTreeLeaf<T>*>(m_children[index].get())) {
+                    leaf->insert(std::move(data), voxel);
+                } else {
+                    m_children[index] = std::make_unique<OctTreeLeaf<T>>(std::move(data), depth + 1);
+                }
                 return;
             }
 
             if(auto branch = dynamic_cast<OctTreeBranch<T>*>(m_children[index].get())) {
-                branch->insert(std::move(data), position);
+                branch->insert(std::move(data), voxel);
             } else if(auto leaf = dynamic_cast<OctTreeLeaf<T>*>(m_children[index].get())) {
-                auto leafCenter = leaf->center;
-                auto delta = position - leafCenter;
-                auto nIndex = convertToNormalizedIndex(delta);
-                auto index = convertToScalarIndex(nIndex);
-                m_children[index] = std::make_unique<OctTreeBranch<T>>(leaf->getData(), leaf->depth, leafCenter);
-                m_children[index]->insert(std::move(data), position);
+                // Nothing changes if the leaf already holds the data.
+                if(leaf->getData() == data)
+                    return;
+                // Split the leaf into a branch that covers the same octant and insert into it.
+                m_children[index] = std::make_unique<OctTreeBranch<T>>(leaf->getData(), leaf->depth);
+                m_children[index]->insert(std::move(data), voxel);
             }
+
+            collapseChild(index);
+        }
+
+        [[nodiscard]] virtual const T& get(glm::uvec3 voxel) const noexcept override {
+            return m_children[getChildIndex(voxel, depth)]->get(voxel);
+        }
+
+        /**
+         * @brief Sets every voxel inside the region to the provided data.
+         *
+         * @param data The data to fill the region with.
+         * @param origin The minimum corner of this branch.
+         * @param min The minimum voxel of the region.
+         * @param max The maximum voxel of the region ( exclusive ).
+         *
+         * @note Children that end up uniform get merged back into a single leaf.
+         */
+        void fill(const T& data, glm::uvec3 origin, glm::uvec3 min, glm::uvec3 max) {
+            auto childLength = getLength() / 2;
+            for(uint8 index = 0; index < 8; ++index) {
+                auto childMin = getChildOrigin(origin, index, depth);
+                auto childMax = childMin + childLength;
+
+                bool overlaps = glm::all(glm::lessThan(childMin, max)) && glm::all(glm::greaterThan(childMax, min));
+                if(!overlaps)
+                    continue;
+
+                bool contained = glm::all(glm::greaterThanEqual(childMin, min)) && glm::all(glm::lessThanEqual(childMax, max));
+                if(contained) {
+                    m_children[index] = std::make_unique<OctTreeLeaf<T>>(T(data), depth + 1);
+                    continue;
+                }
+
+                // Only children longer than one voxel can be partially covered.
+                auto branch = dynamic_cast<OctTreeBranch<T>*>(m_children[index].get());
+                if(!branch) {
+                    auto& leaf = static_cast<OctTreeLeaf<T>&>(*m_children[index]);
+                    if(leaf.getData() == data)
+                        continue;
+                    auto split = std::make_unique<OctTreeBranch<T>>(leaf.getData(), depth + 1);
+                    branch = split.get();
+                    m_children[index] = std::move(split);
+                }
+                branch->fill(data, childMin, min, max);
+                collapseChild(index);
+            }
+        }
+
+        [[nodiscard]] virtual size_t getMemoryUsage() const noexcept override {
+            size_t usage = sizeof(*this);
+            for(const auto& child : m_children) {
+                if(child)
+                    usage += child->getMemoryUsage();
+            }
+            return usage;
+        }
+
+        [[nodiscard]] virtual size_t getNodeCount() const noexcept override {
+            size_t count = 1;
+            for(const auto& child : m_children) {
+                if(child)
+                    count += child->getNodeCount();
+            }
+            return count;
         }
 
         [[nodiscard]] virtual bool equal(const OctTreeNode<T>& other) const noexcept override {
@@ -135,6 +216,8 @@ namespace voxels {
             return false;
         }
 
+        [[nodiscard]] inline const std::array<ChildNode, 8>& getChildren() const noexcept { return m_children; }
+
         [[nodiscard]] bool childrenAreEqual() const noexcept {
             for(int i = 1; i < 8; ++i) {
                 if(!m_children[0]->equal(*m_children[i]))
@@ -144,6 +227,25 @@ namespace voxels {
         }
 
     private:
+        /**
+         * @brief Replaces the child with a single leaf if it is a branch whose children are all equal leaves.
+         *
+         * @param index The scalar index of the child.
+         *
+         * @note Mutations collapse bottom-up so a uniform branch can only ever have leaf children.
+         */
+        void collapseChild(uint8 index) {
+            auto branch = dynamic_cast<OctTreeBranch<T>*>(m_children[index].get());
+            if(!branch || !branch->childrenAreEqual())
+                return;
+
+            auto leaf = dynamic_cast<OctTreeLeaf<T>*>(branch->m_children.front().get());
+            if(!leaf)
+                return;
+
+            m_children[index] = std::make_unique<OctTreeLeaf<T>>(std::move(leaf->getData()), depth + 1);
+        }
+
         std::array<ChildNode, 8> m_children;
     };
-}
\ No newline at end of file
+}
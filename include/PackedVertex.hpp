@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Renderer/AttributeDescriptor.hpp"
+#include "ext/vector_uint3.hpp"
+#include <array>
+
+namespace voxels {
+    /**
+     * @brief An 8 byte vertex of a voxel face, the position is local to a section of at most 32 voxels.
+     *
+     * @note The first word holds the position with 6 bits per axis, the face normal index and the ambient occlusion,
+     * the second word holds the material. The shader reads both as a uvec2 and unpacks them with the same layout,
+     * see assets/shaders/voxel.vert. Texture coordinates are derived from the position and the normal.
+     */
+    struct PackedVertex {
+        static constexpr uint32 POSITION_BITS = 6; //< The bits per position axis, positions go from 0 to 32 inclusive.
+        static constexpr uint32 NORMAL_SHIFT = 3 * POSITION_BITS; //< The offset of the 3 normal bits.
+        static constexpr uint32 OCCLUSION_SHIFT = NORMAL_SHIFT + 3; //< The offset of the 2 ambient occlusion bits.
+
+        uint32 data; //< The position, normal and ambient occlusion.
+        uint32 material; //< The material.
+
+        /**
+         * @brief Packs the vertex.
+         *
+         * @param position The position relative to the section, each component at most 63.
+         * @param normal The normal index, the axis times two plus one for faces pointing towards the negative end.
+         * @param occlusion The ambient occlusion from 0 for fully occluded to 3 for unoccluded.
+         * @param material The material.
+         */
+        [[nodiscard]] static constexpr PackedVertex pack(glm::uvec3 position, uint32 normal, uint32 occlusion, uint32 material) noexcept {
+            constexpr uint32 MASK = (1 << POSITION_BITS) - 1;
+            return {
+                (position.x & MASK)
+                    | (position.y & MASK) << POSITION_BITS
+                    | (position.z & MASK) << 2 * POSITION_BITS
+                    | (normal & 0b111) << NORMAL_SHIFT
+                    | (occlusion & 0b11) << OCCLUSION_SHIFT,
+                material
+            };
+        }
+
+        [[nodiscard]] constexpr glm::uvec3 getPosition() const noexcept {
+            constexpr uint32 MASK = (1 << POSITION_BITS) - 1;
+            return { data & MASK, (data >> POSITION_BITS) & MASK, (data >> 2 * POSITION_BITS) & MASK };
+        }
+        [[nodiscard]] constexpr uint32 getNormal() const noexcept { return (data >> NORMAL_SHIFT) & 0b111; }
+        [[nodiscard]] constexpr uint32 getOcclusion() const noexcept { return (data >> OCCLUSION_SHIFT) & 0b11; }
+
+        [[nodiscard]] static constexpr auto getAttributes() noexcept {
+            return std::array {
+                renderer::AttributeDescriptor{ renderer::AttributeType::UnsignedInteger32, 2, false, true },
+            };
+        }
+    };
+
+    static_assert(sizeof(PackedVertex) == 8);
+    static_assert(PackedVertex::pack({ 32, 0, 17 }, 5, 2, 0xDEADBEEF).getPosition() == glm::uvec3(32, 0, 17));
+    static_assert(PackedVertex::pack({ 32, 0, 17 }, 5, 2, 0xDEADBEEF).getNormal() == 5);
+    static_assert(PackedVertex::pack({ 32, 0, 17 }, 5, 2, 0xDEADBEEF).getOcclusion() == 2);
+}
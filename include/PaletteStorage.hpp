@@ -0,0 +1,244 @@
+#pragma once
+
+#include "Global.hpp"
+#include "common.hpp"
+#include "ext/vector_uint3.hpp"
+#include <algorithm> // For std::max.
+#include <cstddef> // For size_t.
+#include <vector> // For the palette and the packed indices.
+
+namespace voxels {
+    /**
+     * @brief Dense voxel storage that packs an index into a local palette per voxel.
+     *
+     * @tparam T The voxel data type.
+     * @tparam Length The length of the stored cube.
+     *
+     * @note The indices are 0, 1, 2, 4, 8 or 16 bits wide depending on how many distinct values are used,
+     * with a 32 bit fallback so storing arbitrary data can never fail. The widths are powers of two
+     * so an index never straddles two words. A uniform cube needs no indices at all.
+     * Unused palette entries are only reclaimed when the palette runs full, so edits never pay for bookkeeping.
+     * The palette is searched linearly, which is fast for the handful of values a chunk usually holds.
+     */
+    template<typename T, uint32 Length = CHUNK_LENGTH>
+    class PaletteStorage {
+    public:
+        /// @brief The number of stored voxels.
+        static constexpr size_t VOLUME = static_cast<size_t>(Length) * Length * Length;
+
+        static_assert((Length & (Length - 1)) == 0, "The length has to be a power of two.");
+
+        /**
+         * @brief Constructs a new storage where every voxel holds the provided data.
+         *
+         * @param data The data of every voxel.
+         */
+        explicit PaletteStorage(T&& data) : m_palette { std::move(data) } {  }
+
+        /**
+         * @brief Gets the data of the voxel.
+         *
+         * @param voxel The voxel coordinates.
+         * @return const T& The data.
+         */
+        [[nodiscard]] inline const T& get(glm::uvec3 voxel) const noexcept {
+            return m_palette[readIndex(getLinearIndex(voxel))];
+        }
+
+        /**
+         * @brief Sets the data of the voxel.
+         *
+         * @param data The new data.
+         * @param voxel The voxel coordinates.
+         */
+        void insert(T&& data, glm::uvec3 voxel) {
+            auto index = findOrAdd(data);
+            if(m_bits != 0)
+                writeIndex(getLinearIndex(voxel), index);
+        }
+
+        /**
+         * @brief Sets every voxel inside the region to the provided data.
+         *
+         * @param data The data to fill with.
+         * @param min The minimum voxel of the region.
+         * @param max The maximum voxel of the region ( exclusive ).
+         *
+         * @note Whole words are written at once and filling the whole cube drops the indices altogether.
+         */
+        void fill(const T& data, glm::uvec3 min, glm::uvec3 max) {
+            min = glm::min(min, glm::uvec3(Length));
+            max = glm::min(max, glm::uvec3(Length));
+            if(min.x >= max.x || min.y >= max.y || min.z >= max.z)
+                return;
+
+            if(min == glm::uvec3(0) && max == glm::uvec3(Length)) {
+                m_palette = { data };
+                m_words = {};
+                m_bits = 0;
+                return;
+            }
+
+            auto index = findOrAdd(data);
+            if(m_bits == 0)
+                return;
+
+            // Rows are contiguous along z, full rows are contiguous along y and full slices along x.
+            bool fullRows = min.z == 0 && max.z == Length;
+            bool fullSlices = fullRows && min.y == 0 && max.y == Length;
+            if(fullSlices) {
+                writeRange(getLinearIndex({ min.x, 0, 0 }), getLinearIndex({ max.x, 0, 0 }), index);
+                return;
+            }
+            for(uint32 x = min.x; x < max.x; ++x) {
+                if(fullRows) {
+                    writeRange(getLinearIndex({ x, min.y, 0 }), getLinearIndex({ x, max.y, 0 }), index);
+                    continue;
+                }
+                for(uint32 y = min.y; y < max.y; ++y) {
+                    writeRange(getLinearIndex({ x, y, min.z }), getLinearIndex({ x, y, max.z }), index);
+                }
+            }
+        }
+
+        /**
+         * @brief Drops unused palette entries and packs the indices with the smallest possible width.
+         */
+        void shrink() {
+            compact(0);
+        }
+
+        [[nodiscard]] inline const std::vector<T>& getPalette() const noexcept { return m_palette; }
+        /**
+         * @brief Returns the width of a packed palette index.
+         */
+        [[nodiscard]] inline uint32 getBitsPerVoxel() const noexcept { return m_bits; }
+        /**
+         * @brief Returns the number of bytes used by the storage.
+         */
+        [[nodiscard]] inline size_t getMemoryUsage() const noexcept {
+            return sizeof(*this) + m_palette.capacity() * sizeof(T) + m_words.capacity() * sizeof(uint64);
+        }
+
+        [[nodiscard]] static constexpr size_t getLinearIndex(glm::uvec3 voxel) noexcept {
+            return (static_cast<size_t>(voxel.x) * Length + voxel.y) * Length + voxel.z;
+        }
+
+    private:
+        /**
+         * @brief Returns the smallest supported index width that can address the number of entries.
+         */
+        [[nodiscard]] static constexpr uint32 getBitsFor(size_t entries) noexcept {
+            for(uint32 bits : { 0u, 1u, 2u, 4u, 8u, 16u }) {
+                if(entries <= (size_t(1) << bits))
+                    return bits;
+            }
+            return 32;
+        }
+
+        [[nodiscard]] static inline size_t getWordCount(uint32 bits) noexcept {
+            return (VOLUME * bits + 63) / 64;
+        }
+
+        [[nodiscard]] inline uint32 readIndex(size_t voxel) const noexcept {
+            if(m_bits == 0)
+                return 0;
+            auto bit = voxel * m_bits;
+            return static_cast<uint32>(m_words[bit >> 6] >> (bit & 63)) & getMask();
+        }
+
+        inline void writeIndex(size_t voxel, uint32 index) noexcept {
+            auto bit = voxel * m_bits;
+            auto& word = m_words[bit >> 6];
+            word = (word & ~(static_cast<uint64>(getMask()) << (bit & 63))) | (static_cast<uint64>(index) << (bit & 63));
+        }
+
+        [[nodiscard]] inline uint32 getMask() const noexcept {
+            return static_cast<uint32>((uint64(1) << m_bits) - 1);
+        }
+
+        /**
+         * @brief Writes the index into every voxel of the linear range [begin, end).
+         */
+        void writeRange(size_t begin, size_t end, uint32 index) noexcept {
+            auto perWord = 64 / m_bits;
+            for(; begin < end && (begin & (perWord - 1)) != 0; ++begin) {
+                writeIndex(begin, index);
+            }
+
+            if(begin + perWord <= end) {
+                // Replicate the index across a whole word by doubling it up.
+                uint64 pattern = index;
+                for(auto bits = m_bits; bits < 64; bits *= 2) {
+                    pattern |= pattern << bits;
+                }
+                for(; begin + perWord <= end; begin += perWord) {
+                    m_words[begin * m_bits >> 6] = pattern;
+                }
+            }
+
+            for(; begin < end; ++begin) {
+                writeIndex(begin, index);
+            }
+        }
+
+        /**
+         * @brief Returns the palette index of the data, adding it to the palette if needed.
+         */
+        uint32 findOrAdd(const T& data) {
+            for(uint32 i = 0; i < m_palette.size(); ++i) {
+                if(m_palette[i] == data)
+                    return i;
+            }
+
+            if(m_bits < 32 && m_palette.size() >= (size_t(1) << m_bits)) {
+                // Leave room for as many new entries as are in use so the palette does not have to be compacted on every add.
+                compact(1);
+            }
+            m_palette.push_back(data);
+            return static_cast<uint32>(m_palette.size() - 1);
+        }
+
+        /**
+         * @brief Drops unused palette entries and repacks the indices.
+         *
+         * @param reserve If non zero the width is chosen to hold twice the used entries and at least one more.
+         */
+        void compact(uint32 reserve) {
+            std::vector<uint8> used(m_palette.size(), 0);
+            if(m_bits == 0) {
+                used[0] = 1;
+            } else {
+                for(size_t voxel = 0; voxel < VOLUME; ++voxel) {
+                    used[readIndex(voxel)] = 1;
+                }
+            }
+
+            std::vector<uint32> remap(m_palette.size(), 0);
+            std::vector<T> palette;
+            for(uint32 i = 0; i < m_palette.size(); ++i) {
+                if(!used[i])
+                    continue;
+                remap[i] = static_cast<uint32>(palette.size());
+                palette.push_back(std::move(m_palette[i]));
+            }
+
+            auto bits = getBitsFor(reserve ? std::max(palette.size() * 2, palette.size() + reserve) : palette.size());
+            std::vector<uint64> words(getWordCount(bits), 0);
+            if(bits != 0) {
+                for(size_t voxel = 0; voxel < VOLUME; ++voxel) {
+                    auto bit = voxel * bits;
+                    words[bit >> 6] |= static_cast<uint64>(remap[readIndex(voxel)]) << (bit & 63);
+                }
+            }
+
+            m_palette = std::move(palette);
+            m_words = std::move(words);
+            m_bits = bits;
+        }
+
+        std::vector<T> m_palette; //< The distinct values, some of them may be unused.
+        std::vector<uint64> m_words; //< The packed palette indices, z is the fastest changing coordinate.
+        uint32 m_bits = 0; //< The width of a packed index.
+    };
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "Global.hpp"
+#include <atomic> // For the ring buffer positions.
+#include <chrono> // For the timestamps.
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <memory> // For the thread buffers.
+#include <mutex> // For registering the threads.
+#include <ostream> // For printing the frames.
+#include <string_view> // For the trace path.
+#include <vector> // For the statistics and the capture.
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef VOXELS_PROFILING
+/// @brief Times the rest of the scope as a zone with the name, which has to be a string literal.
+#define PROFILE_SCOPE(name) const ::profiling::Zone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+/// @brief Profiling is disabled, the zone compiles to nothing.
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace profiling {
+    /**
+     * @brief Returns the current time of the steady clock in nanoseconds.
+     */
+    [[nodiscard]] inline uint64 now() noexcept {
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief A finished zone.
+     */
+    struct ZoneEvent {
+        const char* name; //< The name of the zone, a string literal.
+        uint64 start; //< When the zone started in nanoseconds.
+        uint64 end; //< When the zone ended in nanoseconds.
+    };
+
+    /**
+     * @brief A lock free ring of the zones one thread recorded.
+     *
+     * @note Only the owning thread pushes and only the thread that ends the frames drains, so the positions are the
+     * only shared state. A full ring drops the new zones instead of waiting.
+     */
+    class ThreadBuffer {
+    public:
+        /// @brief How many zones fit into the ring, a power of two.
+        static constexpr size_t CAPACITY = size_t(1) << 14;
+
+        /**
+         * @brief Constructs a new ring.
+         *
+         * @param threadId The index of the thread in the trace.
+         */
+        explicit ThreadBuffer(uint32 threadId)
+            : m_events(std::make_unique<ZoneEvent[]>(CAPACITY))
+            , m_threadId(threadId) {  }
+
+        /**
+         * @brief Appends the zone, called by the owning thread only.
+         *
+         * @return false If the ring was full and the zone was dropped.
+         */
+        bool push(const ZoneEvent& event) noexcept {
+            auto head = m_head.load(std::memory_order_relaxed);
+            if(head - m_tail.load(std::memory_order_acquire) == CAPACITY) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_events[head & (CAPACITY - 1)] = event;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Calls the callback with every zone pushed since the last drain and frees them.
+         */
+        template<std::invocable<const ZoneEvent&> F>
+        void drain(F&& callback) {
+            auto tail = m_tail.load(std::memory_order_relaxed);
+            auto head = m_head.load(std::memory_order_acquire);
+            for(; tail != head; ++tail) {
+                callback(m_events[tail & (CAPACITY - 1)]);
+            }
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        /**
+         * @brief Returns how many zones were dropped and resets the count.
+         */
+        [[nodiscard]] inline size_t takeDroppedCount() noexcept { return m_dropped.exchange(0, std::memory_order_relaxed); }
+        [[nodiscard]] inline uint32 getThreadId() const noexcept { return m_threadId; }
+
+    private:
+        std::unique_ptr<ZoneEvent[]> m_events; //< The ring.
+        alignas(64) std::atomic<uint64> m_head = 0; //< The position of the next push, only written by the owning thread.
+        alignas(64) std::atomic<uint64> m_tail = 0; //< The position of the next drain, only written by the draining thread.
+        std::atomic<size_t> m_dropped = 0; //< How many zones did not fit since the last frame.
+        uint32 m_threadId; //< The index of the thread in the trace.
+    };
+
+    /**
+     * @brief The time spent in all zones of one name in a frame.
+     */
+    struct ZoneStatistics {
+        const char* name; //< The name of the zones.
+        uint32 calls = 0; //< How many zones ended in the frame.
+        float64 milliseconds = 0.0; //< The sum of their durations, nested zones are counted in their parents too.
+        float64 maxMilliseconds = 0.0; //< The longest of them.
+    };
+
+    /**
+     * @brief The aggregates of one frame.
+     */
+    struct FrameProfile {
+        uint64 index = 0; //< The number of the frame.
+        float64 milliseconds = 0.0; //< The time between the ends of the previous frame and this one.
+        std::vector<ZoneStatistics> cpu; //< The CPU zones that ended in the frame in the order their names first appeared.
+        std::vector<ZoneStatistics> gpu; //< The GPU passes whose timer queries became available in the frame, usually from a few frames earlier.
+        size_t dropped = 0; //< How many zones were dropped because a ring was full.
+    };
+
+    /**
+     * @brief Prints the frame time and one line per zone.
+     */
+    std::ostream& operator<<(std::ostream& stream, const FrameProfile& frame);
+
+    /**
+     * @brief Collects the zones of every thread into per frame aggregates and an optional Chrome trace.
+     *
+     * @note Recording a zone is two clock reads and a push into the ring of the thread. endFrame drains the rings on
+     * the thread that drives the frames. The capture keeps every zone of the captured frames until it is written
+     * with writeChromeTrace, the result opens in chrome://tracing or Perfetto.
+     */
+    class Profiler {
+    public:
+        /**
+         * @brief Records a finished CPU zone on the calling thread.
+         */
+        inline void record(const ZoneEvent& event) noexcept {
+            thread_local const Profiler* owner = nullptr;
+            thread_local ThreadBuffer* buffer = nullptr;
+            if(owner != this) {
+                buffer = &registerThread();
+                owner = this;
+            }
+            buffer->push(event);
+        }
+
+        /**
+         * @brief Records a finished GPU pass, called by the thread that ends the frames.
+         *
+         * @param event The pass, its start is when it was submitted and its end the start plus the time the GPU spent on it.
+         */
+        void recordGpu(const ZoneEvent& event);
+
+        /**
+         * @brief Collects the zones of all threads into the aggregates of the frame and starts the next one.
+         */
+        void endFrame();
+
+        /**
+         * @brief Keeps every zone of the next frames for the trace, replacing the previous capture.
+         *
+         * @param frameCount How many frames to capture.
+         */
+        void startCapture(uint32 frameCount);
+
+        /**
+         * @brief Writes the captured zones as Chrome trace event JSON.
+         *
+         * @param path The path of the file, an existing file is overwritten.
+         *
+         * @throws voxels::Exception If the file could not be written.
+         */
+        void writeChromeTrace(std::string_view path) const;
+
+        /**
+         * @brief Returns the aggregates of the last frame that ended.
+         */
+        [[nodiscard]] inline const FrameProfile& getLastFrame() const noexcept { return m_lastFrame; }
+        [[nodiscard]] inline bool isCapturing() const noexcept { return m_captureFramesLeft > 0; }
+        [[nodiscard]] inline size_t getCapturedCount() const noexcept { return m_capture.size(); }
+
+    private:
+        /**
+         * @brief A zone of the capture.
+         */
+        struct CapturedEvent {
+            ZoneEvent event; //< The zone.
+            uint32 threadId; //< The thread that recorded it, GPU_THREAD_ID for GPU passes.
+        };
+
+        /// @brief The thread of the GPU passes in the trace.
+        static constexpr uint32 GPU_THREAD_ID = 1000;
+
+        /**
+         * @brief Creates the ring of the calling thread.
+         */
+        [[nodiscard]] ThreadBuffer& registerThread();
+        /**
+         * @brief Adds the zone to the aggregates of the frame.
+         */
+        static void accumulate(std::vector<ZoneStatistics>& statistics, const ZoneEvent& event);
+
+        mutable std::mutex m_threadsMutex; //< Guards the list of rings, not the rings themselves.
+        std::vector<std::unique_ptr<ThreadBuffer>> m_threads; //< The rings of every thread that recorded a zone.
+        FrameProfile m_frame; //< The aggregates of the current frame.
+        FrameProfile m_lastFrame; //< The aggregates of the last frame.
+        uint64 m_frameStart = now(); //< When the current frame started.
+        uint32 m_captureFramesLeft = 0; //< How many more frames are captured.
+        std::vector<CapturedEvent> m_capture; //< The captured zones.
+    };
+
+    /**
+     * @brief Returns the profiler of the application.
+     */
+    [[nodiscard]] Profiler& getProfiler();
+
+    /**
+     * @brief Records the time between its construction and destruction as a zone, see PROFILE_SCOPE.
+     */
+    class Zone {
+    public:
+        explicit Zone(const char* name) noexcept : m_name(name), m_start(now()) {  }
+        ~Zone() noexcept { getProfiler().record({ m_name, m_start, now() }); }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* m_name; //< The name of the zone.
+        uint64 m_start; //< When the zone started.
+    };
+}
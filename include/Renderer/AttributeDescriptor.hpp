@@ -27,5 +27,6 @@ namespace renderer {
         AttributeType type;         //< The type of the attribute.
         uint8 count;                //< The number of the specified type.
         bool normalized = false;    //< Whether the attribute should be normalized.
+        bool integer = false;       //< Whether the shader reads the attribute as integers, normalized is ignored then.
     };
 }
\ No newline at end of file
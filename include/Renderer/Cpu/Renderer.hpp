@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Jobs/JobSystem.hpp" // For rendering the tiles in parallel.
+#include "Renderer/Cpu/Surface.hpp" // For the surface.
+#include "Renderer/IRenderer.hpp" // For the interface.
+#include "World/World.hpp" // For the voxels.
+#include "ext/vector_float3.hpp"
+#include "ext/vector_int3.hpp"
+#include <array> // For the packet lanes.
+
+namespace renderer::cpu {
+    /**
+     * @brief The settings of the CPU renderer.
+     */
+    struct RendererDescriptor {
+        float32 maxDistance = 512.0f; //< Rays stop after travelling this many voxels.
+        uint32 tileSize = 32; //< The length of the square tiles that are rendered by one job, a multiple of the packet size.
+    };
+
+    /**
+     * @brief The first solid voxel along a ray.
+     */
+    struct RayHit {
+        bool hit = false; //< Whether a solid voxel was hit before the maximum distance.
+        float32 distance = 0.0f; //< The distance along the ray to the entry point of the voxel.
+        world::Voxel voxel = world::AIR; //< The hit voxel.
+        glm::ivec3 position = glm::ivec3(0); //< The world position of the hit voxel.
+        uint8 axis = 0; //< The axis of the entered face, 0 is x, 1 is y and 2 is z.
+    };
+
+    /**
+     * @brief The traversal state of several rays in structure of arrays layout.
+     *
+     * @note The lanes are traversed in lock step. Looking up the chunk and reading the voxel are gathers done lane by lane,
+     * then every lane that stays in its chunk takes its voxel step in one masked std::experimental::simd pass, the closest
+     * boundary is picked without branches and the updates are blended in by mask. Skipping a chunk is rare and stays per lane.
+     */
+    struct RayPacket {
+        static constexpr uint32 SIZE = 8; //< The number of lanes.
+
+        template<typename T>
+        using Lanes = std::array<T, SIZE>;
+
+        Lanes<float32> originX, originY, originZ; //< The ray origins.
+        Lanes<float32> directionX, directionY, directionZ; //< The normalized ray directions.
+        Lanes<int32> voxelX, voxelY, voxelZ; //< The current voxel.
+        Lanes<int32> stepX, stepY, stepZ; //< The direction of a step along each axis, 1 or -1.
+        Lanes<float32> tMaxX, tMaxY, tMaxZ; //< The distance at which the next voxel boundary along each axis is crossed.
+        Lanes<float32> tDeltaX, tDeltaY, tDeltaZ; //< The distance between two voxel boundaries along each axis.
+        Lanes<float32> distance; //< The distance to the entry point of the current voxel.
+        Lanes<int32> axis; //< The axis of the last crossed boundary.
+        Lanes<world::Voxel> voxel; //< The hit voxel, air if nothing was hit.
+        Lanes<const world::Chunk*> chunk; //< The chunk of the current voxel, nullptr if it is not loaded.
+        Lanes<glm::ivec3> chunkCoordinate; //< The coordinate of the cached chunk.
+        Lanes<bool> active; //< Whether the lane still traverses, the mask of the SIMD steps.
+    };
+
+    /**
+     * @brief Renders the world by ray marching it on the CPU into an in memory surface.
+     *
+     * @note Uses the Amanatides and Woo voxel traversal, so every voxel along a ray is visited exactly once
+     * and no voxel can be stepped over. Chunks that are not loaded or are empty are skipped in a single step.
+     * The frame is split into tiles which are rendered in parallel on the job system.
+     */
+    class Renderer: public IRenderer {
+    public:
+        /**
+         * @brief Construct a new CPU renderer.
+         *
+         * @param world The world to render, it has to outlive the renderer and must not change while rendering.
+         * @param width The width of the surface.
+         * @param height The height of the surface.
+         * @param descriptor The renderer settings.
+         * @param jobSystem The job system to render the tiles on.
+         */
+        explicit Renderer(const world::World& world, uint32 width, uint32 height, const RendererDescriptor& descriptor = {},
+            jobs::JobSystem& jobSystem = jobs::getJobSystem());
+
+        [[nodiscard]] virtual inline ISurface& getSurface() noexcept override { return m_surface; }
+        [[nodiscard]] virtual inline const ISurface& getSurface() const noexcept override { return m_surface; }
+        [[nodiscard]] inline const Surface& getCpuSurface() const noexcept { return m_surface; }
+
+        virtual void render(const voxels::CameraDescriptor& cameraDescriptor) override;
+
+        /**
+         * @brief Traces a single ray.
+         *
+         * @param world The world to trace.
+         * @param origin The ray origin in world space.
+         * @param direction The normalized ray direction.
+         * @param maxDistance The distance after which the ray stops.
+         * @return RayHit The first solid voxel.
+         */
+        [[nodiscard]] static RayHit traceRay(const world::World& world, glm::vec3 origin, glm::vec3 direction, float32 maxDistance);
+
+        /**
+         * @brief Traces the active lanes of the packet until each of them hits a voxel or exceeds the maximum distance.
+         *
+         * @param world The world to trace.
+         * @param packet The packet, only the origins, directions and active lanes have to be set.
+         * @param maxDistance The distance after which a ray stops.
+         */
+        static void tracePacket(const world::World& world, RayPacket& packet, float32 maxDistance) noexcept;
+
+    private:
+        /**
+         * @brief Renders the tile into the back buffer.
+         */
+        void renderTile(const voxels::CameraDescriptor& cameraDescriptor, uint32 tileX, uint32 tileY) noexcept;
+
+        const world::World& m_world; //< The rendered world.
+        RendererDescriptor m_descriptor; //< The renderer settings.
+        jobs::JobSystem& m_jobSystem; //< Renders the tiles.
+        Surface m_surface; //< The surface to render to.
+    };
+}
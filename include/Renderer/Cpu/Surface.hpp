@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Renderer/ISurface.hpp" // For the interface.
+#include <algorithm> // For std::max.
+#include <vector> // For the pixels.
+
+namespace renderer::cpu {
+    /**
+     * @brief A double buffered surface in memory, every pixel is packed as 0xAABBGGRR.
+     *
+     * @note The renderer draws into the back buffer, swapBuffers makes it readable through getPixels.
+     */
+    class Surface: public renderer::ISurface {
+    public:
+        explicit Surface(uint32 width, uint32 height) {
+            setViewportSize(width, height);
+        }
+
+        virtual void bind() const noexcept override {  }
+        virtual void unBind() const noexcept override {  }
+        virtual void swapBuffers() override {
+            m_front.swap(m_back);
+        }
+        /**
+         * @brief Resizes both buffers, the content is lost.
+         */
+        virtual void setViewportSize(uint32 width, uint32 height) noexcept override {
+            m_width = std::max(width, 1u);
+            m_height = std::max(height, 1u);
+            m_front.assign(static_cast<size_t>(m_width) * m_height, 0);
+            m_back.assign(static_cast<size_t>(m_width) * m_height, 0);
+        }
+        [[nodiscard]] virtual std::pair<uint32, uint32> getViewportSize() const noexcept override {
+            return { m_width, m_height };
+        }
+
+        /**
+         * @brief Returns the last presented frame, rows are stored from top to bottom.
+         */
+        [[nodiscard]] inline const std::vector<uint32>& getPixels() const noexcept { return m_front; }
+        /**
+         * @brief Returns the frame that is being drawn.
+         */
+        [[nodiscard]] inline std::vector<uint32>& getBackBuffer() noexcept { return m_back; }
+
+    private:
+        uint32 m_width = 1; //< The width in pixels.
+        uint32 m_height = 1; //< The height in pixels.
+        std::vector<uint32> m_front; //< The presented pixels.
+        std::vector<uint32> m_back; //< The pixels being drawn.
+    };
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Global.hpp"
+#include "ext/matrix_float4x4.hpp"
+#include "ext/vector_float2.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_float4.hpp"
+#include <array> // For the planes.
+#include <cstddef> // For size_t.
+#include <span> // For the boxes.
+#include <utility> // For the occluder order.
+#include <vector> // For the depth buffer and the visible boxes.
+
+namespace renderer {
+    /**
+     * @brief An axis aligned bounding box.
+     */
+    struct Aabb {
+        glm::vec3 min; //< The minimum corner.
+        glm::vec3 max; //< The maximum corner.
+    };
+
+    /**
+     * @brief The six planes of a view frustum.
+     */
+    struct Frustum {
+        std::array<glm::vec4, 6> planes; //< The normalized planes, xyz point inwards and a point p is inside if dot(xyz, p) + w >= 0.
+
+        /**
+         * @brief Extracts the planes from a projection view matrix, the Gribb and Hartmann method.
+         *
+         * @param projectionView The projection view matrix with a -1 to 1 clip space depth.
+         * @return Frustum The frustum in world space.
+         */
+        [[nodiscard]] static Frustum fromMatrix(const glm::mat4& projectionView) noexcept;
+
+        /**
+         * @brief Tests whether the box is at least partly inside the frustum.
+         *
+         * @note Conservative, boxes near the corners of the frustum can pass even though they are outside.
+         */
+        [[nodiscard]] bool intersects(const Aabb& box) const noexcept;
+    };
+
+    /**
+     * @brief The settings of the culling.
+     */
+    struct CullingDescriptor {
+        bool occlusion = true; //< Whether the boxes that passed the frustum are tested against the occluders.
+        uint32 depthWidth = 128; //< The width of the software depth buffer.
+        uint32 depthHeight = 64; //< The height of the software depth buffer.
+        size_t maxOccluders = 128; //< How many of the closest occluders in the frustum are rasterized.
+    };
+
+    /**
+     * @brief What the last cull did.
+     */
+    struct CullingStatistics {
+        size_t tested = 0; //< The number of tested boxes.
+        size_t frustumCulled = 0; //< The number of boxes outside the frustum.
+        size_t occlusionCulled = 0; //< The number of boxes in the frustum that are hidden behind occluders.
+        size_t visible = 0; //< The number of boxes that passed.
+        size_t occluders = 0; //< The number of rasterized occluders.
+        float64 frustumMilliseconds = 0.0; //< The time spent on the frustum test.
+        float64 occlusionMilliseconds = 0.0; //< The time spent on rasterizing the occluders and testing the boxes against them.
+    };
+
+    /**
+     * @brief Removes the boxes that can not be seen before they are submitted for drawing.
+     *
+     * @note The frustum test converts the boxes to structure of arrays layout and tests every plane in one straight
+     * loop over them, which the compiler turns into SIMD instructions that test four or eight boxes at once. The
+     * optional occlusion pass rasterizes the closest occluders, boxes that are completely solid, into a small depth
+     * buffer and drops the boxes whose screen rectangle is covered by nearer occluders everywhere. Occluders are
+     * written at their farthest depth and boxes tested at their nearest depth, occluders only cover the pixels their
+     * projection covers completely and boxes are tested on their screen rectangle rounded outwards, so a box peeking
+     * out past an occluder by less than a pixel is never dropped.
+     * Boxes that cross the near plane are always visible and never occlude.
+     */
+    class Culler {
+    public:
+        /**
+         * @brief Construct a new culler.
+         *
+         * @param descriptor The culling settings.
+         */
+        explicit Culler(const CullingDescriptor& descriptor = {});
+
+        /**
+         * @brief Finds the visible boxes.
+         *
+         * @param projectionView The projection view matrix of the camera.
+         * @param boxes The boxes to test.
+         * @param occluders The solid boxes that hide what is behind them.
+         * @param visible Receives the indices of the visible boxes in ascending order, it is cleared first.
+         */
+        void cull(const glm::mat4& projectionView, std::span<const Aabb> boxes, std::span<const Aabb> occluders, std::vector<uint32>& visible);
+
+        /**
+         * @brief Returns the statistics of the last cull.
+         */
+        [[nodiscard]] inline const CullingStatistics& getStatistics() const noexcept { return m_statistics; }
+        [[nodiscard]] inline const CullingDescriptor& getDescriptor() const noexcept { return m_descriptor; }
+        /**
+         * @brief Returns the software depth buffer of the last cull, one over the depth of the nearest occluder per pixel and zero where there is none.
+         */
+        [[nodiscard]] inline const std::vector<float32>& getDepthBuffer() const noexcept { return m_depth; }
+
+    private:
+        /**
+         * @brief The screen rectangle and depth range of a projected box.
+         */
+        struct ScreenBox {
+            float32 minX, minY, maxX, maxY; //< The rectangle in pixels.
+            float32 nearest; //< One over the depth of the nearest corner.
+            float32 farthest; //< One over the depth of the farthest corner.
+        };
+
+        /**
+         * @brief Finds the boxes that intersect the frustum.
+         *
+         * @param inside Receives the indices of the boxes in ascending order.
+         */
+        void testFrustum(const Frustum& frustum, std::span<const Aabb> boxes, std::vector<uint32>& inside);
+        /**
+         * @brief Projects the corners of the box.
+         *
+         * @return false If the box crosses the near plane.
+         */
+        [[nodiscard]] bool project(const glm::mat4& projectionView, const Aabb& box, std::array<glm::vec2, 8>& corners, ScreenBox& screen) const noexcept;
+        /**
+         * @brief Writes the farthest depth of the occluder into every pixel its projection covers completely.
+         */
+        void rasterizeOccluder(const glm::mat4& projectionView, const Aabb& box) noexcept;
+        /**
+         * @brief Tests whether nearer occluders cover the whole screen rectangle of the box.
+         */
+        [[nodiscard]] bool isOccluded(const glm::mat4& projectionView, const Aabb& box) const noexcept;
+
+        const CullingDescriptor m_descriptor; //< The culling settings.
+        CullingStatistics m_statistics; //< The statistics of the last cull.
+        std::vector<float32> m_depth; //< One over the depth of the nearest occluder per pixel, row major.
+        std::vector<float32> m_tiles; //< The smallest value of the depth buffer in every tile, row major.
+        std::vector<float32> m_centerX, m_centerY, m_centerZ; //< The centers of the boxes.
+        std::vector<float32> m_extentX, m_extentY, m_extentZ; //< The half sizes of the boxes.
+        std::vector<float32> m_distance; //< The smallest signed distance of every box to the planes.
+        std::vector<uint32> m_inFrustum; //< The boxes that passed the frustum test.
+        std::vector<uint32> m_occludersInFrustum; //< The occluders that passed the frustum test.
+        std::vector<std::pair<float32, uint32>> m_occluderOrder; //< The occluders in the frustum and their distance.
+    };
+}
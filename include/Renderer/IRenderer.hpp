@@ -3,6 +3,10 @@
 #include "CameraDescriptor.hpp"
 #include "Renderer/ISurface.hpp"
 
+namespace world {
+    class Remesher;
+}
+
 namespace renderer {
     class IRenderer {
     public:
@@ -28,5 +32,14 @@ namespace renderer {
          * @param cameraDescriptor The camera descriptor.
          */
         virtual void render(const voxels::CameraDescriptor& cameraDescriptor) = 0;
+
+        /**
+         * @brief Takes over the section meshes the remesher changed in its last update.
+         *
+         * @param remesher The remesher, has to be passed after every update so no change is missed.
+         *
+         * @note Renderers that do not draw meshes can ignore it.
+         */
+        virtual void updateMeshes(const world::Remesher& /*remesher*/) {  }
     };
 }
\ No newline at end of file
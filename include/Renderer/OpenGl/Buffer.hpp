@@ -2,6 +2,7 @@
 
 #include "Exception.hpp"
 #include "Renderer/IBindable.hpp"
+#include "Renderer/OpenGl/StateCache.hpp"
 #include "glad/gl.h"
 #include <cstddef>
 
@@ -20,12 +21,24 @@ namespace renderer::opengl {
          * @param size The size of the data in bytes.
          */
         virtual void copyDataIntoBuffer(const void* data, size_t size, GLenum usage = GL_STATIC_DRAW) noexcept = 0;
+
+        /**
+         * @brief Copies the given data into a part of the buffer without reallocating it.
+         * 
+         * @param data The data to copy.
+         * @param offset The offset into the buffer in bytes.
+         * @param size The size of the data in bytes, the range has to lie inside the buffer.
+         */
+        virtual void copySubDataIntoBuffer(const void* data, size_t offset, size_t size) noexcept = 0;
     };
 
     /**
      * @brief Generic buffer type.
      * 
      * @tparam Type The OpenGl type of the buffer.
+     *
+     * @note With direct state access the data is copied without binding the buffer, otherwise the buffer is bound
+     * to GL_COPY_WRITE_BUFFER through the state cache, which leaves the bindings of the vertex arrays alone, and left bound.
      */
     template<GLenum Type>
     class Buffer: public IBuffer {
@@ -36,29 +49,48 @@ namespace renderer::opengl {
          * @throws voxels::Exception If the vertex array could not be created.
          */
         explicit Buffer() : m_buffer(0) {
-            glGenBuffers(1, &m_buffer);
+            // Only a created buffer can be used by name, a generated one only exists once it was bound.
+            if(StateCache::hasDirectStateAccess())
+                glCreateBuffers(1, &m_buffer);
+            else
+                glGenBuffers(1, &m_buffer);
             if(m_buffer == 0) {
                 THROW_EXCEPTION("Could not create a buffer.");
             }
         }
         explicit Buffer(GLuint buffer) noexcept : m_buffer(buffer) {  }
         virtual ~Buffer() noexcept {
+            getStateCache().onBufferDeleted(m_buffer);
             glDeleteBuffers(1, &m_buffer);
         }
 
         virtual void bind() const noexcept override {
-            glBindBuffer(Type, m_buffer);
+            getStateCache().bindBuffer(Type, m_buffer);
         }
         virtual void unBind() const noexcept override {
-            glBindBuffer(Type, 0);
+            getStateCache().bindBuffer(Type, 0);
         }
 
         virtual void copyDataIntoBuffer(const void* data, size_t size, GLenum usage = GL_STATIC_DRAW) noexcept override {
-            bind();
-            glBufferData(Type, size, data, usage);
-            unBind();
+            if(StateCache::hasDirectStateAccess()) {
+                glNamedBufferData(m_buffer, static_cast<GLsizeiptr>(size), data, usage);
+                return;
+            }
+            getStateCache().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), data, usage);
         }
 
+        virtual void copySubDataIntoBuffer(const void* data, size_t offset, size_t size) noexcept override {
+            if(StateCache::hasDirectStateAccess()) {
+                glNamedBufferSubData(m_buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+                return;
+            }
+            getStateCache().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        }
+
+        [[nodiscard]] inline GLuint getId() const noexcept { return m_buffer; }
+
     protected:
         GLuint m_buffer; //< The underlying OpenGl buffer.
     };
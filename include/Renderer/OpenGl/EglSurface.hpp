@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Renderer/ISurface.hpp" // For the interface.
+#include "glad/gl.h"
+#include <EGL/egl.h> // For the headless context.
+#include <array> // For the frame fences.
+#include <cstddef> // For size_t.
+#include <vector> // For the read back pixels.
+
+namespace renderer::opengl {
+    /**
+     * @brief A headless OpenGl surface created with EGL, the frames are drawn into an offscreen framebuffer that can be read back.
+     *
+     * @note Prefers Mesa's surfaceless platform, which needs no display server and works on render nodes and with
+     * llvmpipe ( LIBGL_ALWAYS_SOFTWARE=1 ), and falls back to the default display. OpenGl is loaded when the surface
+     * is created. bind makes the offscreen framebuffer current, so everything drawn to the default framebuffer ends up
+     * in it. Nothing is presented, swapBuffers only keeps the CPU at most FRAMES_IN_FLIGHT frames ahead of the GPU.
+     */
+    class EglSurface: public renderer::ISurface {
+    public:
+        /// @brief How many frames the CPU may submit before it waits for the GPU.
+        static constexpr size_t FRAMES_IN_FLIGHT = 2;
+
+        /**
+         * @brief Creates the context and the framebuffer.
+         *
+         * @param width The width of the framebuffer.
+         * @param height The height of the framebuffer.
+         *
+         * @throws voxels::Exception If no EGL display supports an OpenGl 4.5 core context.
+         */
+        EglSurface(uint32 width, uint32 height);
+        ~EglSurface() noexcept;
+
+        EglSurface(const EglSurface&) = delete;
+        EglSurface& operator=(const EglSurface&) = delete;
+
+        virtual void bind() const noexcept override;
+        virtual void unBind() const noexcept override;
+        virtual void swapBuffers() override;
+        virtual void setViewportSize(uint32 width, uint32 height) noexcept override;
+        [[nodiscard]] virtual std::pair<uint32, uint32> getViewportSize() const noexcept override {
+            return m_viewportSize;
+        }
+
+        /**
+         * @brief Reads the colors of the framebuffer, waiting for the GPU to finish the frame.
+         *
+         * @return std::vector<uint8> The RGBA pixels row by row, the bottom row first.
+         */
+        [[nodiscard]] std::vector<uint8> readPixels() const;
+
+        /**
+         * @brief Returns how many frames were swapped.
+         */
+        [[nodiscard]] inline uint64 getFrameCount() const noexcept { return m_frameCount; }
+
+    private:
+        /**
+         * @brief Allocates the color and depth storage of the framebuffer at the viewport size and sets the viewport.
+         */
+        void allocateFramebuffer() noexcept;
+
+        EGLDisplay m_display = EGL_NO_DISPLAY; //< The display, the surfaceless platform if available.
+        EGLContext m_context = EGL_NO_CONTEXT; //< The context.
+        EGLSurface m_pbuffer = EGL_NO_SURFACE; //< A tiny pbuffer for displays that can not make a context current without a surface.
+        GLuint m_framebuffer = 0; //< The offscreen framebuffer.
+        GLuint m_colorBuffer = 0; //< The RGBA color attachment.
+        GLuint m_depthBuffer = 0; //< The depth and stencil attachment.
+        std::array<GLsync, FRAMES_IN_FLIGHT> m_fences = {}; //< The fences of the last frames, indexed by the frame count.
+        uint64 m_frameCount = 0; //< How many frames were swapped.
+        std::pair<uint32, uint32> m_viewportSize; //< The current viewport size.
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Global.hpp"
+#include "ext/matrix_float4x4.hpp"
+#include "ext/vector_float4.hpp"
+#include "glad/gl.h"
+#include <cstddef> // For offsetof.
+
+namespace renderer::opengl {
+    /// @brief The uniform buffer binding of the frame uniforms, matches the binding of the Frame block in the shaders.
+    constexpr GLuint FRAME_UNIFORMS_BINDING = 0;
+
+    /**
+     * @brief The data every pipeline reads in a frame, uploaded once per frame.
+     *
+     * @note Mirrors the std140 Frame block of the shaders:
+     * layout(std140, binding = 0) uniform Frame { mat4 projectionView; vec3 cameraWorldPos; };
+     */
+    struct FrameUniforms {
+        glm::mat4 projectionView; //< The projection view matrix of the camera.
+        glm::vec4 cameraPosition; //< The position of the camera in xyz, a vec3 takes the space of a vec4 in std140.
+    };
+
+    static_assert(offsetof(FrameUniforms, cameraPosition) == 64);
+    static_assert(sizeof(FrameUniforms) == 80);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Profiling/Profiler.hpp"
+#include "glad/gl.h"
+#include <deque> // For the queries in flight.
+#include <vector> // For the free queries.
+
+#ifdef VOXELS_PROFILING
+/// @brief Times the GPU work submitted in the rest of the scope with the timer, passes can not nest.
+#define PROFILE_GPU_SCOPE(timer, name) const ::renderer::opengl::GpuZone PROFILE_CONCAT(profileGpuZone, __LINE__)(timer, name)
+#else
+/// @brief Profiling is disabled, the pass compiles to nothing.
+#define PROFILE_GPU_SCOPE(timer, name) static_cast<void>(0)
+#endif
+
+namespace renderer::opengl {
+    /**
+     * @brief Measures how long the GPU spends on render passes with GL_TIME_ELAPSED queries.
+     *
+     * @note The results arrive a few frames late, collect polls the queries in submission order without waiting and hands
+     * the finished ones to the profiler. Elapsed time queries can not overlap, so only one pass can be timed at once.
+     * The queries are created when they are first needed, the timer can be constructed before OpenGl is loaded.
+     */
+    class GpuTimer {
+    public:
+        /**
+         * @brief Constructs a new timer.
+         *
+         * @param maxPassesInFlight How many passes can wait for their results, further passes are not timed.
+         */
+        explicit GpuTimer(size_t maxPassesInFlight = 64) noexcept : m_maxPassesInFlight(maxPassesInFlight) {  }
+        ~GpuTimer() noexcept;
+
+        GpuTimer(const GpuTimer&) = delete;
+        GpuTimer& operator=(const GpuTimer&) = delete;
+
+        /**
+         * @brief Starts timing a pass.
+         *
+         * @param name The name of the pass, a string literal.
+         */
+        void begin(const char* name);
+        /**
+         * @brief Stops timing the pass.
+         */
+        void end() noexcept;
+
+        /**
+         * @brief Hands the passes whose results are available to the profiler.
+         */
+        void collect(profiling::Profiler& profiler);
+
+        /**
+         * @brief Returns how many passes wait for their results.
+         */
+        [[nodiscard]] inline size_t getPassesInFlight() const noexcept { return m_pending.size(); }
+
+    private:
+        /**
+         * @brief A submitted pass.
+         */
+        struct Pass {
+            GLuint query; //< The elapsed time query.
+            const char* name; //< The name of the pass.
+            uint64 submitted; //< When the pass started on the CPU.
+        };
+
+        const size_t m_maxPassesInFlight; //< How many passes can wait for their results.
+        std::deque<Pass> m_pending; //< The passes in submission order.
+        std::vector<GLuint> m_free; //< The queries that can be reused.
+        bool m_active = false; //< Whether a pass is being timed.
+    };
+
+    /**
+     * @brief Times the GPU work of its scope, see PROFILE_GPU_SCOPE.
+     */
+    class GpuZone {
+    public:
+        GpuZone(GpuTimer& timer, const char* name) : m_timer(timer) { m_timer.begin(name); }
+        ~GpuZone() noexcept { m_timer.end(); }
+
+        GpuZone(const GpuZone&) = delete;
+        GpuZone& operator=(const GpuZone&) = delete;
+
+    private:
+        GpuTimer& m_timer; //< The timer of the pass.
+    };
+}
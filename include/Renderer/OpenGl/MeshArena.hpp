@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Mesh.hpp"
+#include "Renderer/OpenGl/Buffer.hpp"
+#include "Renderer/OpenGl/StreamBuffer.hpp"
+#include "World/ChunkMap.hpp"
+#include "ext/vector_int3.hpp"
+#include "ext/vector_int4.hpp"
+#include "glad/gl.h"
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <memory> // For the buffers.
+#include <span> // For the visible sections.
+#include <vector> // For the free ranges and the commands.
+
+namespace renderer::opengl {
+    /**
+     * @brief The layout of a glMultiDrawElementsIndirect command.
+     */
+    struct DrawElementsIndirectCommand {
+        GLuint count; //< The number of indices.
+        GLuint instanceCount; //< The number of instances.
+        GLuint firstIndex; //< The first index.
+        GLint baseVertex; //< The offset added to every index.
+        GLuint baseInstance; //< The first instance, selects the section origin of the draw.
+    };
+
+    /**
+     * @brief Packs the packed meshes of many sections into one vertex buffer and draws any set of them with a single multi draw call.
+     *
+     * @note Meshes are sub allocated from the vertex buffer with a first fit free list and the buffer doubles when it runs out.
+     * Every mesh is drawn with the same shared quad index buffer offset by its first vertex, and the origin of its section
+     * and its level of detail are an instanced vertex attribute at location 1 that the base instance of the draw command selects.
+     * The commands and origins are rebuilt from the visible sections every frame and streamed through persistent ring buffers,
+     * so the CPU cost of a frame is a loop over the visible sections and one glMultiDrawElementsIndirect call.
+     * Requires OpenGl 4.4.
+     */
+    class MeshArena {
+    public:
+        /**
+         * @brief Constructs a new arena.
+         *
+         * @param vertexCapacity How many vertices the arena can hold before it grows.
+         *
+         * @throws voxels::Exception If the buffers could not be created.
+         */
+        explicit MeshArena(size_t vertexCapacity = size_t(1) << 20);
+        ~MeshArena() noexcept;
+
+        MeshArena(const MeshArena&) = delete;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        /**
+         * @brief Uploads the mesh of the section, replacing the previous one.
+         *
+         * @param section The section coordinate, the minimum section of the node for a coarser level of detail.
+         * @param mesh The mesh, an empty mesh removes the section.
+         * @param level The level of detail of the mesh, its vertex positions are scaled by 2^level.
+         */
+        void upload(glm::ivec3 section, const voxels::PackedMesh& mesh, uint32 level = 0);
+
+        /**
+         * @brief Removes the mesh of the section.
+         *
+         * @param section The section coordinate.
+         * @return true If the section had a mesh.
+         * @return false Otherwise.
+         */
+        bool erase(glm::ivec3 section);
+
+        /**
+         * @brief Draws the meshes of the sections with a single multi draw call, sections without a mesh are skipped.
+         *
+         * @param sections The sections to draw.
+         *
+         * @note The program has to be bound already, the vertex array of the arena stays bound.
+         */
+        void draw(std::span<const glm::ivec3> sections);
+
+        /**
+         * @brief Calls the callback for every section with a mesh in an unspecified order.
+         *
+         * @param callback The callback which receives the section coordinate and the level of detail of its mesh.
+         */
+        template<std::invocable<glm::ivec3, uint32> F>
+        void forEachSection(F&& callback) const {
+            m_allocations.forEach([&](glm::ivec3 section, const Allocation& allocation) { callback(section, allocation.level); });
+        }
+
+        [[nodiscard]] inline size_t getMeshCount() const noexcept { return m_allocations.size(); }
+        [[nodiscard]] inline size_t getVertexCapacity() const noexcept { return m_vertexCapacity; }
+        /**
+         * @brief Returns how many vertices are in use.
+         */
+        [[nodiscard]] inline size_t getVertexCount() const noexcept { return m_vertexCount; }
+        /**
+         * @brief Returns how many meshes the last draw drew.
+         */
+        [[nodiscard]] inline size_t getDrawCount() const noexcept { return m_drawCount; }
+        /**
+         * @brief Returns how many multi draw calls the last draw submitted, one per MAX_DRAWS_PER_CALL meshes.
+         */
+        [[nodiscard]] inline size_t getSubmissionCount() const noexcept { return m_submissionCount; }
+
+    private:
+        /**
+         * @brief A range of vertices.
+         */
+        struct Allocation {
+            uint32 first; //< The first vertex.
+            uint32 count; //< The number of vertices.
+            uint32 level = 0; //< The level of detail of the mesh.
+        };
+
+        /**
+         * @brief Finds a free range for the vertices, growing the vertex buffer if there is none.
+         */
+        [[nodiscard]] Allocation allocate(uint32 count);
+        /**
+         * @brief Returns the range to the free list and merges it with its neighbours.
+         */
+        void free(Allocation allocation);
+        /**
+         * @brief Replaces the vertex buffer with a larger one and copies the meshes over.
+         */
+        void grow(size_t vertexCapacity);
+        /**
+         * @brief Makes sure the shared index buffer covers the number of quads.
+         */
+        void reserveQuads(uint32 quadCount);
+        /**
+         * @brief Points the vertex array to the current vertex and index buffers.
+         */
+        void bindBuffers() const noexcept;
+
+        GLuint m_vertexArray = 0; //< The vertex array.
+        std::unique_ptr<VertexBuffer> m_vertices; //< The vertices of every mesh.
+        IndexBuffer m_indices; //< The shared quad indices.
+        VertexStreamBuffer m_origins; //< The section origins of the draws of the recent frames.
+        StreamBuffer<GL_DRAW_INDIRECT_BUFFER> m_commands; //< The draw commands of the recent frames.
+        size_t m_vertexCapacity; //< How many vertices the vertex buffer holds.
+        size_t m_vertexCount = 0; //< How many vertices are allocated.
+        uint32 m_quadCapacity = 0; //< How many quads the index buffer covers.
+        world::ChunkMap<Allocation> m_allocations; //< The vertices of every section.
+        std::vector<Allocation> m_free; //< The free ranges sorted by their first vertex.
+        std::vector<DrawElementsIndirectCommand> m_commandScratch; //< The commands of the current draw.
+        std::vector<glm::ivec4> m_originScratch; //< The origins and levels of detail of the current draw.
+        size_t m_drawCount = 0; //< How many meshes the last draw drew.
+        size_t m_submissionCount = 0; //< How many draw calls the last draw submitted.
+    };
+}
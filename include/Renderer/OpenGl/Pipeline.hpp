@@ -1,23 +1,34 @@
 #pragma once
 
 #include "Renderer/OpenGl/Shader.hpp" // For the shader.
+#include "Renderer/OpenGl/StateCache.hpp" // For binding the program.
 #include "Renderer/IBindable.hpp" // For the interface.
+#include "Renderer/OpenGl/UniformName.hpp" // For the uniform names.
 #include "gtc/type_ptr.hpp"
-#include <string_view>
+#include <vector> // For the uniform locations.
 
 namespace renderer::opengl {
     /**
      * @brief Holds the OpenGL rendering pipeline ( aka the program ).
+     *
+     * @note The uniform locations are looked up once when the pipeline is created, setting a uniform uses
+     * glProgramUniform so it neither binds the program nor queries the location by its name. Requires OpenGl 4.1.
      */
     class Pipeline : IBindable {
     public:
         explicit Pipeline(GLuint programId, Shader vertexShader, Shader fragmentShader) noexcept
             : m_programId(programId)
             , m_vertexShader(std::move(vertexShader))
-            , m_fragmentShader(std::move(fragmentShader)) {  }
+            , m_fragmentShader(std::move(fragmentShader))
+            , m_uniforms(findUniformLocations(programId)) {  }
+        /**
+         * @brief Takes a program that is linked already, like one loaded from a program binary, which owns no shaders.
+         */
+        explicit Pipeline(GLuint programId) noexcept
+            : Pipeline(programId, Shader(0), Shader(0)) {  }
 
         virtual ~Pipeline() noexcept {
-            unBind();
+            getStateCache().onProgramDeleted(m_programId);
             glDeleteProgram(m_programId);
         }
 
@@ -31,11 +42,11 @@ namespace renderer::opengl {
         [[nodiscard]] static Pipeline linkShaders(Shader vertexShader, Shader fragmentShader);
 
         virtual void bind() const noexcept override {
-            glUseProgram(m_programId);
+            getStateCache().useProgram(m_programId);
         }
 
         virtual void unBind() const noexcept override {
-            glUseProgram(0);   
+            getStateCache().useProgram(0);
         }
 
         /**
@@ -44,12 +55,22 @@ namespace renderer::opengl {
          * @param name The name of the uniform.
          * @param value The value of the uniform.
          *
-         * @note This function unbinds this pipeline after it is done.
+         * @note The pipeline does not have to be bound, uniforms that are not active in the program are ignored.
+         */
+        void setUniform(UniformName name, float value) const noexcept {
+            glProgramUniform1f(m_programId, getUniformLocation(name), value);
+        }
+
+        /**
+         * @brief Sets a uniform in the pipeline.
+         * 
+         * @param name The name of the uniform.
+         * @param value The value of the uniform, also used for samplers.
+         *
+         * @note The pipeline does not have to be bound, uniforms that are not active in the program are ignored.
          */
-        void setUniform(std::string_view name, float value) const noexcept {
-            bind();
-            glUniform1f(glGetUniformLocation(m_programId, name.data()), value);
-            unBind();
+        void setUniform(UniformName name, int32 value) const noexcept {
+            glProgramUniform1i(m_programId, getUniformLocation(name), value);
         }
 
         /**
@@ -58,12 +79,10 @@ namespace renderer::opengl {
          * @param name The name of the uniform.
          * @param value The value of the uniform.
          *
-         * @note This function unbinds this pipeline after it is done.
+         * @note The pipeline does not have to be bound, uniforms that are not active in the program are ignored.
          */
-        void setUniform(std::string_view name, glm::vec3 value) const noexcept {
-            bind();
-            glUniform3fv(glGetUniformLocation(m_programId, name.data()), 1, glm::value_ptr(value));
-            unBind();
+        void setUniform(UniformName name, glm::vec3 value) const noexcept {
+            glProgramUniform3fv(m_programId, getUniformLocation(name), 1, glm::value_ptr(value));
         }
 
         /**
@@ -72,17 +91,45 @@ namespace renderer::opengl {
          * @param name The name of the uniform.
          * @param value The value of the uniform.
          *
-         * @note This function unbinds this pipeline after it is done.
+         * @note The pipeline does not have to be bound, uniforms that are not active in the program are ignored.
          */
-        void setUniform(std::string_view name, glm::mat4 value) const noexcept {
-            bind();
-            glUniformMatrix4fv(glGetUniformLocation(m_programId, name.data()), 1, GL_FALSE, glm::value_ptr(value));
-            unBind();
+        void setUniform(UniformName name, const glm::mat4& value) const noexcept {
+            glProgramUniformMatrix4fv(m_programId, getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
         }
 
+        /**
+         * @brief Returns the location of the uniform from the table built at link time.
+         *
+         * @param name The name of the uniform.
+         * @return GLint The location, -1 if the program has no such active uniform.
+         */
+        [[nodiscard]] GLint getUniformLocation(UniformName name) const noexcept {
+            for(const auto& uniform : m_uniforms) {
+                if(uniform.hash == name.hash)
+                    return uniform.location;
+            }
+            return -1;
+        }
+
+        [[nodiscard]] inline GLuint getId() const noexcept { return m_programId; }
+
     private:
+        /**
+         * @brief The location of an active uniform.
+         */
+        struct UniformLocation {
+            uint64 hash; //< The hash of the name.
+            GLint location; //< The location.
+        };
+
+        /**
+         * @brief Queries the locations of the active uniforms outside of uniform blocks.
+         */
+        [[nodiscard]] static std::vector<UniformLocation> findUniformLocations(GLuint programId);
+
         GLuint m_programId; //< Program ID.
         Shader m_vertexShader; //< Vertex shader.
         Shader m_fragmentShader; //< Fragment shader.
+        std::vector<UniformLocation> m_uniforms; //< The locations of the active uniforms, a handful per program so a linear search is enough.
     };
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "File.hpp" // For reading the sources and binaries.
+#include "Global.hpp"
+#include "Jobs/JobSystem.hpp" // For writing the binaries.
+#include "Renderer/OpenGl/Pipeline.hpp" // For the pipelines.
+#include "Renderer/OpenGl/Shader.hpp" // For the shaders that are compiling.
+#include "glad/gl.h"
+#include <atomic> // For counting the written binaries.
+#include <cstddef> // For size_t.
+#include <filesystem> // For the cache directory.
+#include <future> // For the file contents.
+#include <memory> // For the entries.
+#include <string> // For the sources.
+#include <string_view> // For the paths.
+#include <vector> // For the entries.
+
+namespace renderer::opengl {
+    /// @brief Identifies a pipeline of a PipelineCache, the index of its request.
+    using PipelineId = size_t;
+
+    /**
+     * @brief How the pipelines of a cache were built.
+     */
+    struct PipelineCacheStatistics {
+        size_t loaded = 0; //< The number of pipelines loaded from a program binary.
+        size_t compiled = 0; //< The number of pipelines compiled from source.
+        size_t rejected = 0; //< The number of program binaries the driver did not accept, their pipelines were compiled instead.
+        size_t stored = 0; //< The number of program binaries written.
+        float64 waitMilliseconds = 0.0; //< The time spent blocking in wait.
+    };
+
+    /**
+     * @brief Builds pipelines from shader files in the background and keeps their linked programs on disk.
+     *
+     * @note request reads the sources on the job system, update hands every pipeline whose sources arrived to the
+     * driver without waiting for it. With GL_KHR_parallel_shader_compile the driver compiles and links on its own
+     * threads and update only polls the completion, without it the first update after the submission blocks on the link.
+     * A linked program is written with glGetProgramBinary under a hash of its sources and the driver, so the next run
+     * with the same driver loads it with glProgramBinary instead of compiling. A binary the driver rejects, after an
+     * update for example, is compiled from source again and replaced. Everything but reading and writing the files
+     * happens on the thread the context is current on, the binaries are written on the job system under a unique
+     * temporary name and renamed, so neither a frame nor another run waits on or sees a half written file.
+     */
+    class PipelineCache {
+    public:
+        /**
+         * @brief Construct a new cache, OpenGl has to be loaded and its context current.
+         *
+         * @param directory The directory of the program binaries, created when the first one is written.
+         */
+        explicit PipelineCache(std::filesystem::path directory = getDefaultDirectory());
+        ~PipelineCache() noexcept;
+
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        /**
+         * @brief Starts building a pipeline.
+         *
+         * @param vertexPath The path of the vertex shader source.
+         * @param fragmentPath The path of the fragment shader source.
+         * @return PipelineId The pipeline, get returns it once it is ready.
+         *
+         * @throws voxels::Exception If a source does not exist.
+         */
+        [[nodiscard]] PipelineId request(std::string_view vertexPath, std::string_view fragmentPath);
+
+        /**
+         * @brief Advances every pipeline that is not ready as far as it can without waiting.
+         *
+         * @throws renderer::CompilationException If a shader could not be compiled.
+         * @throws renderer::LinkingException If a program could not be linked.
+         */
+        void update();
+
+        /**
+         * @brief Blocks until every requested pipeline is ready.
+         *
+         * @throws renderer::CompilationException If a shader could not be compiled.
+         * @throws renderer::LinkingException If a program could not be linked.
+         */
+        void wait();
+
+        /**
+         * @brief Blocks until every program binary that is being written is on disk.
+         */
+        void flush();
+
+        /**
+         * @brief Returns the pipeline, nullptr while it is being built or if building it failed.
+         */
+        [[nodiscard]] inline const Pipeline* get(PipelineId id) const noexcept { return m_entries[id]->pipeline.get(); }
+
+        /**
+         * @brief Returns whether every requested pipeline is ready.
+         */
+        [[nodiscard]] inline bool isReady() const noexcept { return m_pending == 0; }
+
+        /**
+         * @brief Returns whether the driver compiles and links on its own threads, GL_KHR_parallel_shader_compile.
+         */
+        [[nodiscard]] inline bool hasParallelCompile() const noexcept { return m_parallelCompile; }
+        /**
+         * @brief Returns whether the driver has a program binary format, otherwise every run compiles.
+         */
+        [[nodiscard]] inline bool hasProgramBinaries() const noexcept { return !m_binaryFormats.empty(); }
+        [[nodiscard]] inline const std::filesystem::path& getDirectory() const noexcept { return m_directory; }
+        /**
+         * @brief Returns how the pipelines were built, the binaries still being written are not stored yet.
+         */
+        [[nodiscard]] inline PipelineCacheStatistics getStatistics() const noexcept {
+            auto statistics = m_statistics;
+            statistics.stored = m_stored.load(std::memory_order_relaxed);
+            return statistics;
+        }
+
+        /**
+         * @brief Returns $XDG_CACHE_HOME/voxels/pipelines, falling back to ~/.cache and then the temporary directory.
+         */
+        [[nodiscard]] static std::filesystem::path getDefaultDirectory();
+
+    private:
+        /**
+         * @brief How far a pipeline got.
+         */
+        enum class Stage : uint8 {
+            ReadingSources, //< The sources are read on the job system.
+            ReadingBinary, //< The program binary of the sources is read on the job system.
+            Compiling, //< The shaders and the program were submitted to the driver.
+            Ready, //< The pipeline can be used.
+            Failed, //< The pipeline could not be built, get keeps returning nullptr.
+        };
+
+        /**
+         * @brief A requested pipeline.
+         */
+        struct Entry {
+            Stage stage = Stage::ReadingSources; //< How far the pipeline got.
+            std::unique_ptr<voxels::FileReader> vertexReader, fragmentReader, binaryReader; //< The files being read, they have to outlive their futures.
+            std::future<std::string> vertexRead, fragmentRead, binaryRead; //< The contents of the files.
+            std::string vertexSource, fragmentSource; //< The sources, kept until the pipeline is ready in case the binary is rejected.
+            uint64 key = 0; //< The hash of the sources and the driver.
+            Shader vertexShader = Shader(0), fragmentShader = Shader(0); //< The shaders while they are compiling.
+            GLuint program = 0; //< The program while it is linking.
+            std::unique_ptr<Pipeline> pipeline; //< The pipeline once it is ready.
+        };
+
+        /**
+         * @brief Moves the entry on if its files were read, submitting it to the driver.
+         */
+        void advanceReading(Entry& entry);
+        /**
+         * @brief Creates the program from the binary.
+         *
+         * @return false If the binary is malformed or the driver rejected it.
+         */
+        [[nodiscard]] bool loadBinary(Entry& entry, std::string_view binary);
+        /**
+         * @brief Submits the shaders and the program of the entry to the driver.
+         */
+        void submitCompile(Entry& entry);
+        /**
+         * @brief Checks the shaders and the program of the entry and writes its binary.
+         */
+        void finishCompile(Entry& entry);
+        /**
+         * @brief Fetches the program binary of the entry and writes it on the job system, a failure only costs the next run a compilation.
+         */
+        void storeBinary(const Entry& entry);
+        /**
+         * @brief Makes the entry ready with its program.
+         */
+        void makeReady(Entry& entry);
+        /**
+         * @brief Deletes what the entry built so far and marks it as failed.
+         */
+        void fail(Entry& entry) noexcept;
+        [[nodiscard]] std::filesystem::path getBinaryPath(uint64 key) const;
+
+        std::filesystem::path m_directory; //< The directory of the program binaries.
+        std::string m_driver; //< The vendor, renderer and version strings, a binary is only valid for the driver that wrote it.
+        bool m_parallelCompile = false; //< Whether the driver supports GL_KHR_parallel_shader_compile.
+        std::vector<GLint> m_binaryFormats; //< The program binary formats of the driver.
+        std::vector<std::unique_ptr<Entry>> m_entries; //< The requested pipelines by their id.
+        size_t m_pending = 0; //< The number of entries that are not ready.
+        PipelineCacheStatistics m_statistics; //< How the pipelines were built, but for the stored binaries.
+        std::atomic<size_t> m_stored = 0; //< The number of program binaries written, counted by the jobs writing them.
+        jobs::Counter m_writes; //< Tracks the jobs writing program binaries.
+    };
+}
@@ -1,9 +1,20 @@
 #pragma once
 
+#include "Renderer/Culling.hpp" // For culling the sections.
 #include "Renderer/IRenderer.hpp" // For interface.
 #include "Renderer/ISurface.hpp" // For the surface
+#include "Renderer/OpenGl/GpuTimer.hpp" // For timing the passes.
+#include "Renderer/OpenGl/MeshArena.hpp" // For the section meshes.
+#include "Renderer/OpenGl/PipelineCache.hpp" // For the pipelines.
+#include "Renderer/OpenGl/StateCache.hpp" // For the state statistics.
+#include "Renderer/OpenGl/StreamBuffer.hpp" // For the frame uniforms.
+#include "Renderer/OpenGl/Texture.hpp" // For the cube texture.
+#include "Renderer/OpenGl/VertexArray.hpp" // For the cube mesh.
+#include "Renderer/OpenGl/WindowVisitor.hpp" // For the surface of the window.
 #include "Window/IWindow.hpp" // For the window
+#include "World/ChunkMap.hpp" // For the occluders.
 #include <memory> // For smart pointers
+#include <vector> // For the visible sections.
 
 namespace renderer::opengl {
     /**
@@ -18,14 +29,68 @@ namespace renderer::opengl {
          *
          * @throws voxels::Exception If the window api is not supported.
          */
-        explicit Renderer(const wnd::IWindow& window);
+        explicit Renderer(const wnd::IWindow& window)
+            : Renderer(std::shared_ptr<ISurface>(window.acceptVisitor(WindowVisitor()))) {  }
+        /**
+         * @brief Construct a new OpenGL renderer that draws to the surface, like an EglSurface without a window.
+         *
+         * @param surface The surface, OpenGl has to be loaded for its context already.
+         *
+         * @note The pipelines start building here, render skips the passes whose pipeline is not ready yet.
+         */
+        explicit Renderer(std::shared_ptr<ISurface> surface);
+        /**
+         * @brief Deletes the OpenGl objects of the renderer with its context current.
+         */
+        virtual ~Renderer() noexcept override;
+
+        Renderer(const Renderer&) = delete;
+        Renderer& operator=(const Renderer&) = delete;
 
         [[nodiscard]] virtual inline ISurface& getSurface() noexcept override { return *m_surface; }
         [[nodiscard]] virtual inline const ISurface& getSurface() const noexcept override { return *m_surface; }
 
         virtual void render(const voxels::CameraDescriptor& cameraDescriptor) override;
+        virtual void updateMeshes(const world::Remesher& remesher) override;
+
+        /**
+         * @brief Blocks until every pipeline is built, so the next frame draws every pass.
+         *
+         * @throws renderer::CompilationException If a shader could not be compiled.
+         * @throws renderer::LinkingException If a program could not be linked.
+         */
+        void waitForPipelines();
+
+        [[nodiscard]] inline const MeshArena& getMeshArena() const noexcept { return *m_meshArena; }
+        [[nodiscard]] inline const PipelineCache& getPipelineCache() const noexcept { return *m_pipelines; }
+        /**
+         * @brief Returns the culler, its statistics describe the last frame.
+         */
+        [[nodiscard]] inline const Culler& getCuller() const noexcept { return m_culler; }
+        /**
+         * @brief Returns how many state changes of the last frame the state cache issued and how many it dropped.
+         */
+        [[nodiscard]] inline const StateCacheStatistics& getStateCacheStatistics() const noexcept { return getStateCache().getLastFrameStatistics(); }
 
     private:
         std::shared_ptr<ISurface> m_surface; //< The surface to render to.
+        std::unique_ptr<MeshArena> m_meshArena; //< The meshes of the world, created once OpenGl is loaded.
+        std::unique_ptr<PipelineCache> m_pipelines; //< Builds the pipelines, created once OpenGl is loaded.
+        PipelineId m_basicPipeline = 0; //< Draws the wireframe of the cube.
+        PipelineId m_voxelPipeline = 0; //< Ray marches the voxels of the cube.
+        PipelineId m_worldPipeline = 0; //< Draws the section meshes.
+        std::unique_ptr<UniformStreamBuffer> m_frameUniforms; //< The frame uniforms of the recent frames, shared by every pipeline.
+        size_t m_uniformAlignment = 256; //< The alignment of a uniform buffer binding offset.
+        Culler m_culler; //< Removes the sections that can not be seen.
+        std::unique_ptr<GpuTimer> m_gpuTimer; //< Times the render passes when profiling is enabled, created once OpenGl is loaded.
+        std::unique_ptr<VertexArray> m_cube; //< The cube the voxel marcher and the wireframe draw.
+        std::unique_ptr<Texture2dUint32> m_cubeTexture; //< The texture the voxel marcher samples.
+        float32 m_maxScreenError = 0.0f; //< The screen error of the remesher the meshes come from, it decides the view distance.
+        world::ChunkMap<uint32> m_solidSections; //< The nodes without air which occlude the ones behind them and their levels of detail.
+        std::vector<glm::ivec3> m_sections; //< The sections with a mesh in the current frame.
+        std::vector<Aabb> m_sectionBounds; //< The bounds of the sections with a mesh.
+        std::vector<Aabb> m_occluderBounds; //< The bounds of the solid sections.
+        std::vector<uint32> m_visibleIndices; //< The indices of the sections that passed the culling.
+        std::vector<glm::ivec3> m_visibleSections; //< The sections drawn in the current frame.
     };
 }
\ No newline at end of file
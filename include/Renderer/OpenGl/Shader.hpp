@@ -3,6 +3,7 @@
 #include "Renderer/ShaderType.hpp" // For the shader type.
 #include "glad/gl.h" // For glad functions.
 #include <string_view> // For string view.
+#include <utility> // For std::exchange.
 
 namespace renderer::opengl {
     /**
@@ -14,6 +15,38 @@ namespace renderer::opengl {
 
         ~Shader() noexcept { glDeleteShader(m_shader); }
 
+        // The shader is deleted once, by the last owner of its id.
+        Shader(const Shader&) = delete;
+        Shader& operator=(const Shader&) = delete;
+        Shader(Shader&& other) noexcept : m_shader(std::exchange(other.m_shader, 0)) {  }
+        Shader& operator=(Shader&& other) noexcept {
+            std::swap(m_shader, other.m_shader);
+            return *this;
+        }
+
+        /**
+         * @brief Hands the source to the driver to compile without waiting for the result.
+         *
+         * @param src The shader source.
+         * @param shaderType The shader type.
+         * @return Shader The shader, which may still be compiling.
+         *
+         * @throws voxels::Exception If the shader could not be created.
+         *
+         * @note Querying anything about the shader waits for the compilation unless the driver reports it complete
+         * through GL_KHR_parallel_shader_compile, call checkCompileStatus once it is needed.
+         */
+        [[nodiscard]] static Shader submitFromSource(std::string_view src, ShaderType shaderType);
+
+        /**
+         * @brief Waits for the compilation and checks whether it succeeded.
+         *
+         * @param shaderType The shader type, for the exception.
+         *
+         * @throws voxels::CompilationException If the shader could not be compiled.
+         */
+        void checkCompileStatus(ShaderType shaderType) const;
+
         /**
          * @brief Compiles a shader from source.
          * 
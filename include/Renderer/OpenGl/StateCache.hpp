@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Global.hpp"
+#include "glad/gl.h"
+#include <array> // For the bindings.
+#include <cstddef> // For size_t.
+#include <utility> // For the capabilities.
+#include <vector> // For the capabilities.
+
+namespace renderer::opengl {
+    /**
+     * @brief How many state changes went through the state cache.
+     *
+     * @note Only the calls made through the cache are counted, raw OpenGl calls, draws and uniforms are not.
+     */
+    struct StateCacheStatistics {
+        size_t issued = 0; //< The number of OpenGl calls the cache made, including the active texture unit switches.
+        size_t skipped = 0; //< The number of calls that were dropped because the state was already set.
+    };
+
+    /**
+     * @brief Remembers the bound objects and enabled capabilities of the current context and drops the calls that would not change them.
+     *
+     * @note Every bind in the renderer goes through the cache, a raw glBind* call makes it stale until invalidate is called.
+     * The cache belongs to the thread since the context is current on one thread, it remembers which context it describes
+     * and setContext forgets everything only when another one is made current, a context keeps its state while it is
+     * not current. The element array buffer binding is part of the vertex array, so it is forgotten whenever the vertex
+     * array changes. Deleted objects have to be reported, OpenGl unbinds them and may reuse their names.
+     */
+    class StateCache {
+    public:
+        StateCache() noexcept { invalidate(); }
+
+        /**
+         * @brief Returns whether the context supports direct state access, OpenGl 4.5 or ARB_direct_state_access.
+         *
+         * @note Objects are then created with glCreate* and changed through their names without being bound.
+         */
+        [[nodiscard]] static inline bool hasDirectStateAccess() noexcept {
+            return GLAD_GL_VERSION_4_5 || GLAD_GL_ARB_direct_state_access;
+        }
+
+        /**
+         * @brief Binds the program.
+         */
+        inline void useProgram(GLuint program) noexcept {
+            if(change(m_program, program))
+                glUseProgram(program);
+        }
+
+        /**
+         * @brief Binds the vertex array.
+         */
+        inline void bindVertexArray(GLuint vertexArray) noexcept {
+            if(!change(m_vertexArray, vertexArray))
+                return;
+            glBindVertexArray(vertexArray);
+            m_buffers[ELEMENT_ARRAY_BUFFER_INDEX] = UNKNOWN;
+        }
+
+        /**
+         * @brief Binds the buffer to the target.
+         */
+        inline void bindBuffer(GLenum target, GLuint buffer) noexcept {
+            auto index = getBufferIndex(target);
+            if(index == BUFFER_TARGET_COUNT) {
+                ++m_statistics.issued;
+                glBindBuffer(target, buffer);
+            } else if(change(m_buffers[index], buffer)) {
+                glBindBuffer(target, buffer);
+            }
+        }
+
+        /**
+         * @brief Binds a range of the buffer to the indexed target, which also binds it to the generic target.
+         */
+        inline void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) noexcept {
+            ++m_statistics.issued;
+            glBindBufferRange(target, index, buffer, offset, size);
+            if(auto generic = getBufferIndex(target); generic != BUFFER_TARGET_COUNT)
+                m_buffers[generic] = buffer;
+        }
+
+        /**
+         * @brief Binds the texture to the texture unit.
+         *
+         * @param unit The texture unit, starting at 0 and not at GL_TEXTURE0.
+         * @param target The target of the texture, only used without direct state access.
+         * @param texture The texture.
+         *
+         * @note The cache keeps one texture per unit, so a unit should only be used with one target.
+         */
+        void bindTexture(GLuint unit, GLenum target, GLuint texture) noexcept;
+
+        /**
+         * @brief Enables or disables the capability.
+         */
+        void setEnabled(GLenum capability, bool enabled) noexcept;
+
+        /**
+         * @brief Forgets the bindings of a deleted object, call before deleting it.
+         */
+        void onBufferDeleted(GLuint buffer) noexcept;
+        void onVertexArrayDeleted(GLuint vertexArray) noexcept;
+        void onProgramDeleted(GLuint program) noexcept;
+        void onTextureDeleted(GLuint texture) noexcept;
+
+        /**
+         * @brief Tells the cache which context is current on the thread, call after making a context current.
+         *
+         * @param context The context, the cache is invalidated unless it already describes it.
+         */
+        inline void setContext(const void* context) noexcept {
+            if(context == m_context)
+                return;
+            invalidate();
+            m_context = context;
+        }
+
+        /**
+         * @brief Forgets every binding and capability and the context, the next call for each of them reaches OpenGl.
+         *
+         * @note Does not call OpenGl, so it can be called before OpenGl is loaded.
+         */
+        void invalidate() noexcept;
+
+        /**
+         * @brief Keeps the statistics of the frame that ended and starts counting the next one.
+         */
+        inline void endFrame() noexcept {
+            m_lastFrameStatistics = m_statistics;
+            m_statistics = {};
+        }
+
+        /**
+         * @brief Returns the statistics since the last frame ended.
+         */
+        [[nodiscard]] inline const StateCacheStatistics& getStatistics() const noexcept { return m_statistics; }
+        /**
+         * @brief Returns the statistics of the last frame that ended.
+         */
+        [[nodiscard]] inline const StateCacheStatistics& getLastFrameStatistics() const noexcept { return m_lastFrameStatistics; }
+
+    private:
+        /// @brief The binding of a state the cache does not know, no object has this name.
+        static constexpr GLuint UNKNOWN = ~GLuint(0);
+        /// @brief The number of buffer targets the cache tracks.
+        static constexpr size_t BUFFER_TARGET_COUNT = 9;
+        /// @brief The index of the element array buffer target.
+        static constexpr size_t ELEMENT_ARRAY_BUFFER_INDEX = 1;
+        /// @brief The number of texture units the cache tracks, the ones above are always bound.
+        static constexpr GLuint TEXTURE_UNIT_COUNT = 16;
+
+        /**
+         * @brief Returns the index of the buffer target, BUFFER_TARGET_COUNT if the cache does not track it.
+         */
+        [[nodiscard]] static constexpr size_t getBufferIndex(GLenum target) noexcept {
+            switch(target) {
+                case GL_ARRAY_BUFFER: return 0;
+                case GL_ELEMENT_ARRAY_BUFFER: return ELEMENT_ARRAY_BUFFER_INDEX;
+                case GL_COPY_READ_BUFFER: return 2;
+                case GL_COPY_WRITE_BUFFER: return 3;
+                case GL_DRAW_INDIRECT_BUFFER: return 4;
+                case GL_UNIFORM_BUFFER: return 5;
+                case GL_SHADER_STORAGE_BUFFER: return 6;
+                case GL_PIXEL_PACK_BUFFER: return 7;
+                case GL_PIXEL_UNPACK_BUFFER: return 8;
+                default: return BUFFER_TARGET_COUNT;
+            }
+        }
+
+        /**
+         * @brief Records the new state.
+         *
+         * @return true If the state changed and the call has to be issued.
+         */
+        [[nodiscard]] inline bool change(GLuint& current, GLuint value) noexcept {
+            if(current == value) {
+                ++m_statistics.skipped;
+                return false;
+            }
+            current = value;
+            ++m_statistics.issued;
+            return true;
+        }
+
+        const void* m_context = nullptr; //< The context the cache describes, nullptr if it is not known.
+        GLuint m_program = UNKNOWN; //< The current program.
+        GLuint m_vertexArray = UNKNOWN; //< The bound vertex array.
+        std::array<GLuint, BUFFER_TARGET_COUNT> m_buffers; //< The bound buffer per target.
+        std::array<GLuint, TEXTURE_UNIT_COUNT> m_textures; //< The bound texture per unit.
+        GLuint m_activeTextureUnit = UNKNOWN; //< The active texture unit, only used without direct state access.
+        std::vector<std::pair<GLenum, bool>> m_capabilities; //< The capabilities that were set since the last invalidation.
+        StateCacheStatistics m_statistics; //< The statistics since the last frame ended.
+        StateCacheStatistics m_lastFrameStatistics; //< The statistics of the last frame.
+    };
+
+    /**
+     * @brief Returns the state cache of the context that is current on this thread.
+     */
+    [[nodiscard]] StateCache& getStateCache() noexcept;
+}
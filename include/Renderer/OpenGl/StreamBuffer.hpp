@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Exception.hpp"
+#include "Global.hpp"
+#include "Renderer/IBindable.hpp"
+#include "Renderer/OpenGl/StateCache.hpp"
+#include "glad/gl.h"
+#include <cstddef> // For size_t.
+#include <cstring> // For std::memcpy.
+#include <deque> // For the fences.
+
+namespace renderer::opengl {
+    /**
+     * @brief A region of a stream buffer that can be written until the next fence.
+     */
+    struct StreamAllocation {
+        void* data; //< The mapped memory of the region.
+        size_t offset; //< The offset of the region from the start of the buffer in bytes, used as the draw offset.
+        size_t size; //< The size of the region in bytes.
+    };
+
+    /**
+     * @brief A buffer with immutable storage that stays mapped and is sub allocated as a ring.
+     *
+     * @tparam Type The OpenGl type of the buffer.
+     *
+     * @note Unlike Buffer::copyDataIntoBuffer nothing is reallocated, an upload is a memcpy into coherent mapped memory.
+     * Regions are handed out in order, fence has to be called once the draws that read the regions of a frame were submitted.
+     * A region is only reused after the GPU signaled the fence that covers it, the CPU only waits if the ring
+     * is full of regions the GPU has not consumed yet, so the capacity should hold about three frames of uploads.
+     * Requires OpenGl 4.4 or ARB_buffer_storage.
+     */
+    template<GLenum Type>
+    class StreamBuffer: public IBindable {
+    public:
+        /**
+         * @brief Constructs a new stream buffer.
+         *
+         * @param capacity The size of the ring in bytes.
+         *
+         * @throws voxels::Exception If buffer storage is not supported or the buffer could not be created or mapped.
+         */
+        explicit StreamBuffer(size_t capacity) : m_capacity(capacity) {
+            if(!GLAD_GL_VERSION_4_4 && !GLAD_GL_ARB_buffer_storage) {
+                THROW_EXCEPTION("Persistent buffers require OpenGl 4.4 or ARB_buffer_storage.");
+            }
+
+            auto directStateAccess = StateCache::hasDirectStateAccess();
+            if(directStateAccess)
+                glCreateBuffers(1, &m_buffer);
+            else
+                glGenBuffers(1, &m_buffer);
+            if(m_buffer == 0) {
+                THROW_EXCEPTION("Could not create a buffer.");
+            }
+
+            constexpr GLbitfield FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            if(directStateAccess) {
+                glNamedBufferStorage(m_buffer, static_cast<GLsizeiptr>(capacity), nullptr, FLAGS);
+                m_data = static_cast<uint8*>(glMapNamedBufferRange(m_buffer, 0, static_cast<GLsizeiptr>(capacity), FLAGS));
+            } else {
+                getStateCache().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+                glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, FLAGS);
+                m_data = static_cast<uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(capacity), FLAGS));
+            }
+            if(!m_data) {
+                getStateCache().onBufferDeleted(m_buffer);
+                glDeleteBuffers(1, &m_buffer);
+                THROW_EXCEPTION("Could not map a persistent buffer.");
+            }
+        }
+        virtual ~StreamBuffer() noexcept {
+            for(const auto& fence : m_fences) {
+                glDeleteSync(fence.sync);
+            }
+            if(StateCache::hasDirectStateAccess()) {
+                glUnmapNamedBuffer(m_buffer);
+            } else {
+                getStateCache().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+                glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            }
+            getStateCache().onBufferDeleted(m_buffer);
+            glDeleteBuffers(1, &m_buffer);
+        }
+
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        virtual void bind() const noexcept override {
+            getStateCache().bindBuffer(Type, m_buffer);
+        }
+        virtual void unBind() const noexcept override {
+            getStateCache().bindBuffer(Type, 0);
+        }
+
+        /**
+         * @brief Reserves a region of the ring, waits for the GPU if the ring is full.
+         *
+         * @param size The size of the region in bytes.
+         * @param alignment The alignment of the offset, has to be a power of two.
+         * @return StreamAllocation The region.
+         *
+         * @throws voxels::Exception If the region is larger than the ring.
+         */
+        [[nodiscard]] StreamAllocation allocate(size_t size, size_t alignment = 4) {
+            if(size > m_capacity) {
+                THROW_EXCEPTION("The allocation does not fit into the stream buffer.");
+            }
+
+            // Bytes skipped for the alignment or at the end of the ring count as used until the fence retires them.
+            size_t offset, needed;
+            retire(false);
+            for(;;) {
+                if(m_used == 0)
+                    m_head = 0;
+                offset = (m_head + alignment - 1) & ~(alignment - 1);
+                if(offset + size > m_capacity)
+                    offset = 0;
+                needed = (offset >= m_head ? offset - m_head : m_capacity - m_head) + size;
+                if(m_capacity - m_used >= needed)
+                    break;
+                retire(true);
+            }
+
+            m_head = offset + size;
+            m_used += needed;
+            m_pending += needed;
+            return { m_data + offset, offset, size };
+        }
+
+        /**
+         * @brief Copies the data into a new region of the ring.
+         *
+         * @param data The data to copy.
+         * @param size The size of the data in bytes.
+         * @param alignment The alignment of the offset, has to be a power of two.
+         * @return StreamAllocation The region holding the data.
+         */
+        StreamAllocation upload(const void* data, size_t size, size_t alignment = 4) {
+            auto allocation = allocate(size, alignment);
+            std::memcpy(allocation.data, data, size);
+            return allocation;
+        }
+
+        /**
+         * @brief Guards every region allocated since the last fence, call after submitting the commands that read them.
+         */
+        void fence() {
+            if(m_pending == 0)
+                return;
+            m_fences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_pending });
+            m_pending = 0;
+        }
+
+        [[nodiscard]] inline GLuint getId() const noexcept { return m_buffer; }
+        [[nodiscard]] inline size_t getCapacity() const noexcept { return m_capacity; }
+        /**
+         * @brief Returns the number of bytes that are allocated and not retired yet.
+         */
+        [[nodiscard]] inline size_t getUsedSize() const noexcept { return m_used; }
+        /**
+         * @brief Returns how many times an allocation had to wait for the GPU.
+         */
+        [[nodiscard]] inline size_t getStallCount() const noexcept { return m_stallCount; }
+
+    private:
+        /**
+         * @brief A fence and the bytes it guards.
+         */
+        struct Fence {
+            GLsync sync; //< The fence.
+            size_t size; //< The bytes allocated before the fence and after the previous one.
+        };
+
+        /**
+         * @brief Frees the regions of the signaled fences.
+         *
+         * @param wait Whether to wait for the oldest fence, if there is no fence the pending regions are fenced first.
+         */
+        void retire(bool wait) {
+            if(wait && m_fences.empty())
+                fence();
+
+            while(!m_fences.empty()) {
+                auto& oldest = m_fences.front();
+                auto status = glClientWaitSync(oldest.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+                if(status == GL_TIMEOUT_EXPIRED && wait) {
+                    ++m_stallCount;
+                    do {
+                        status = glClientWaitSync(oldest.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+                    } while(status == GL_TIMEOUT_EXPIRED);
+                }
+                if(status == GL_TIMEOUT_EXPIRED)
+                    return;
+
+                glDeleteSync(oldest.sync);
+                m_used -= oldest.size;
+                m_fences.pop_front();
+                wait = false;
+            }
+        }
+
+        GLuint m_buffer = 0; //< The underlying OpenGl buffer.
+        uint8* m_data = nullptr; //< The mapped storage.
+        const size_t m_capacity; //< The size of the ring in bytes.
+        size_t m_head = 0; //< The offset the next allocation starts at.
+        size_t m_used = 0; //< The bytes between the oldest unretired region and the head.
+        size_t m_pending = 0; //< The bytes allocated since the last fence.
+        size_t m_stallCount = 0; //< How many times an allocation waited for the GPU.
+        std::deque<Fence> m_fences; //< The fences from oldest to newest.
+    };
+
+    /// @brief A persistently mapped vertex buffer.
+    using VertexStreamBuffer = StreamBuffer<GL_ARRAY_BUFFER>;
+    /// @brief A persistently mapped index buffer.
+    using IndexStreamBuffer = StreamBuffer<GL_ELEMENT_ARRAY_BUFFER>;
+    /// @brief A persistently mapped uniform buffer.
+    using UniformStreamBuffer = StreamBuffer<GL_UNIFORM_BUFFER>;
+}
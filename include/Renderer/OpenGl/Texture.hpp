@@ -3,9 +3,12 @@
 #include "Renderer/IBindable.hpp"
 #include "Renderer/OpenGl/Buffer.hpp"
 #include "Renderer/OpenGl/Common.hpp"
+#include "Renderer/OpenGl/StateCache.hpp"
 #include "Renderer/TextureFilter.hpp"
 #include "Renderer/TextureFormat.hpp"
 #include "Renderer/TextureWrap.hpp"
+#include <algorithm> // For the mip level count.
+#include <bit> // For the mip level count.
 #include <cstddef>
 
 namespace renderer::opengl {
@@ -17,21 +20,34 @@ namespace renderer::opengl {
 
     template<size_t D, typename T, TextureFormat F>
     class Texture: public IBindable {
-        static_assert(false, "Unsupported texture dimension.");
+        // Depends on the parameters so it only fails when the template is instantiated.
+        static_assert(D == 0 && D != 0, "Unsupported texture dimension.");
     };
     template<typename T, TextureFormat F>
     class Texture<2, T, F>: public IBindable {
     public:
         ~Texture() noexcept {
-            unBind();
+            getStateCache().onTextureDeleted(m_texture);
             glDeleteTextures(1, &m_texture);
         }
 
+        /**
+         * @brief Binds the texture to the first texture unit.
+         */
         virtual void bind() const noexcept override {
-            glBindTexture(GL_TEXTURE_2D, m_texture);
+            bindToUnit(0);
         }
         virtual void unBind() const noexcept override {
-            glBindTexture(GL_TEXTURE_2D, 0);
+            getStateCache().bindTexture(0, GL_TEXTURE_2D, 0);
+        }
+
+        /**
+         * @brief Binds the texture to the texture unit.
+         *
+         * @param unit The texture unit, starting at 0 and not at GL_TEXTURE0.
+         */
+        void bindToUnit(GLuint unit) const noexcept {
+            getStateCache().bindTexture(unit, GL_TEXTURE_2D, m_texture);
         }
 
         void copyDataIntoTexture(TextureData data) {
@@ -48,15 +64,29 @@ namespace renderer::opengl {
                 data.data
             );
             glGenerateMipmap(GL_TEXTURE_2D);
-            unBind();
         }
 
         template<TextureWrap Wrap, TextureFilter Filter>
         [[nodiscard]] static inline Texture createTexture(std::optional<TextureData> data = {}) {
             auto tex = Texture();
-            tex.bind();
             auto wrap = fromTextureWrap(Wrap);
             auto filter = fromTextureFilter(Filter);
+            if(StateCache::hasDirectStateAccess()) {
+                // Immutable storage with every mip level, filled without binding the texture.
+                glTextureParameteri(tex.m_texture, GL_TEXTURE_WRAP_S, wrap);
+                glTextureParameteri(tex.m_texture, GL_TEXTURE_WRAP_T, wrap);
+                glTextureParameteri(tex.m_texture, GL_TEXTURE_MIN_FILTER, filter);
+                glTextureParameteri(tex.m_texture, GL_TEXTURE_MAG_FILTER, filter);
+                if(data) {
+                    constexpr auto formatDesc = fromTextureFormat(F);
+                    auto levels = static_cast<GLsizei>(std::bit_width(std::max(data->width, data->height)));
+                    glTextureStorage2D(tex.m_texture, levels, formatDesc.internal, data->width, data->height);
+                    glTextureSubImage2D(tex.m_texture, 0, 0, 0, data->width, data->height, formatDesc.format, formatDesc.type, data->data);
+                    glGenerateTextureMipmap(tex.m_texture);
+                }
+                return tex;
+            }
+            tex.bind();
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
@@ -75,13 +105,15 @@ namespace renderer::opengl {
                 );
                 glGenerateMipmap(GL_TEXTURE_2D);
             }
-            tex.unBind();
             return tex;
         }
 
     private:
         explicit Texture(std::optional<TextureData> data = {}) {
-            glGenTextures(1, &m_texture);
+            if(StateCache::hasDirectStateAccess())
+                glCreateTextures(GL_TEXTURE_2D, 1, &m_texture);
+            else
+                glGenTextures(1, &m_texture);
             if(!m_texture) {
                 THROW_EXCEPTION("Could not create a texture.");
             }
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Global.hpp"
+#include <string_view> // For the names.
+
+namespace renderer::opengl {
+    /**
+     * @brief Hashes the name of a uniform with 64 bit FNV-1a.
+     *
+     * @param name The name of the uniform.
+     * @return uint64 The hash.
+     */
+    [[nodiscard]] constexpr uint64 hashUniformName(std::string_view name) noexcept {
+        uint64 hash = 14695981039346656037ull;
+        for(auto character : name) {
+            hash ^= static_cast<uint8>(character);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief The name of a uniform, hashed at compile time.
+     *
+     * @note String literals convert implicitly, so setUniform("model", ...) hashes "model" while compiling and
+     * the lookup at run time is a comparison of integers instead of a glGetUniformLocation call.
+     */
+    struct UniformName {
+        uint64 hash; //< The hash of the name.
+
+        consteval UniformName(const char* name) noexcept : hash(hashUniformName(name)) {  }
+    };
+
+    static_assert(UniformName("model").hash == hashUniformName("model"));
+}
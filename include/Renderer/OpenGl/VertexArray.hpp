@@ -23,18 +23,18 @@ namespace renderer::opengl {
             m_vertexBuffer.bind();
             attributes.bind();
             m_indexBuffer.bind();
-            unBind();
-            m_vertexBuffer.unBind();
-            m_indexBuffer.unBind();
         }
 
-        ~VertexArray() noexcept { glDeleteVertexArrays(1, &m_vao); }
+        ~VertexArray() noexcept {
+            getStateCache().onVertexArrayDeleted(m_vao);
+            glDeleteVertexArrays(1, &m_vao);
+        }
 
         virtual void bind() const noexcept override {
-            glBindVertexArray(m_vao);
+            getStateCache().bindVertexArray(m_vao);
         }
         virtual void unBind() const noexcept override {
-            glBindVertexArray(0);
+            getStateCache().bindVertexArray(0);
         }
 
         /**
@@ -59,6 +59,8 @@ namespace renderer::opengl {
             m_indexBuffer.copyDataIntoBuffer(data, size, usage);
         }
 
+        [[nodiscard]] inline GLuint getId() const noexcept { return m_vao; }
+
     private:
         GLuint m_vao;
         VertexBuffer m_vertexBuffer;
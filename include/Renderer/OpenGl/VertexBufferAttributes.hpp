@@ -4,6 +4,7 @@
 #include "Renderer/IBindable.hpp"
 #include "Renderer/OpenGl/Common.hpp"
 #include "Renderer/AttributeDescriptor.hpp"
+#include <array>
 #include <initializer_list>
 #include <vector>
 
@@ -46,8 +47,13 @@ namespace renderer::opengl {
         constexpr virtual void bind() const noexcept override {
             auto currentSize = 0u;
             for(int i = 0; i < m_attributes.size(); ++i) {
-                glVertexAttribPointer(i, m_attributes[i].count, fromAttributeType(m_attributes[i].type), m_attributes[i].normalized, 
-                    m_stride, reinterpret_cast<void*>(currentSize));
+                if(m_attributes[i].integer) {
+                    glVertexAttribIPointer(i, m_attributes[i].count, fromAttributeType(m_attributes[i].type),
+                        m_stride, reinterpret_cast<void*>(currentSize));
+                } else {
+                    glVertexAttribPointer(i, m_attributes[i].count, fromAttributeType(m_attributes[i].type), m_attributes[i].normalized, 
+                        m_stride, reinterpret_cast<void*>(currentSize));
+                }
                 currentSize += m_attributes[i].count * getSizeOfType(m_attributes[i].type);
                 glEnableVertexAttribArray(i);
             }
@@ -4,6 +4,7 @@
 #ifdef WINDOW_API_X11
 
 #include "Renderer/ISurface.hpp" // For the interface
+#include "Renderer/OpenGl/StateCache.hpp" // For forgetting the state of another context.
 #include "glad/glx.h" // For the GLX objects.
 
 namespace renderer::opengl {
@@ -16,7 +17,9 @@ namespace renderer::opengl {
             : m_x11Display(display), m_x11WindowHandle(drawable), m_context(context), m_viewportSize(1, 1) {  }
 
         virtual void bind() const noexcept override {
-            glXMakeCurrent(m_x11Display, m_x11WindowHandle, m_context);
+            if(glXGetCurrentContext() != m_context || glXGetCurrentDrawable() != m_x11WindowHandle)
+                glXMakeCurrent(m_x11Display, m_x11WindowHandle, m_context);
+            getStateCache().setContext(m_context);
         }
         virtual void unBind() const noexcept override {
             glXMakeCurrent(m_x11Display, 0, nullptr);
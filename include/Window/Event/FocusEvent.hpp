@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Window/Event/IEvent.hpp" // For the interface.
+
+namespace wnd {
+    /**
+     * @brief Gets emitted when the window gains or loses the input focus.
+     */
+    class FocusEvent : public IEvent {
+    public:
+        [[nodiscard]] virtual constexpr const char* getName() const noexcept override { return "FocusEvent"; }
+
+        [[nodiscard]] explicit FocusEvent(bool focused) noexcept : m_focused(focused) {}
+
+        /// @brief Returns whether the window has the input focus now.
+        [[nodiscard]] inline bool isFocused() const noexcept { return m_focused; }
+
+    private:
+        bool m_focused; //< Whether the window has the input focus.
+    };
+}
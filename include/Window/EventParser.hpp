@@ -2,6 +2,7 @@
 
 #include "Observer.hpp" // For the emmitter.
 #include "Window/Event/CloseRequestedEvent.hpp" // For handling the event.
+#include "Window/Event/FocusEvent.hpp" // For handling the event.
 #include "Window/Event/IEvent.hpp" // For handling the event.
 #include "Window/Event/Key.hpp" // For storing the keys.
 #include "Window/Event/KeyboardEvent.hpp" // For handling the event.
@@ -35,6 +36,14 @@ namespace wnd {
          * @param event The event to parse.
          */
         void parseEvent(const wnd::IEvent& event) noexcept {
+            if(auto* focusEvent = event.downCast<wnd::FocusEvent>(); focusEvent) {
+                m_focused = focusEvent->isFocused();
+                FocusChanged->emit(m_focused);
+                return;
+            }
+            // Everything else is either user input or needs the window to be redrawn.
+            m_receivedInput = true;
+
             if(auto* keyEvent = event.downCast<wnd::KeyboardEvent>(); keyEvent) {
 
                 if(keyEvent->isPressed()) {
@@ -100,6 +109,8 @@ namespace wnd {
 
             m_pressedMouseButtons.reset();
             m_releasedMouseButtons.reset();
+
+            m_receivedInput = false;
         }
 
         /**
@@ -150,6 +161,18 @@ namespace wnd {
             return m_heldMouseButtons.test(static_cast<uint8>(button));
         }
 
+        /**
+         * @brief Returns whether the window has the input focus.
+         */
+        [[nodiscard]] inline bool isFocused() const noexcept { return m_focused; }
+
+        /**
+         * @brief Returns whether any input arrived since the last loop ended or a key or a mouse button is held.
+         */
+        [[nodiscard]] inline bool hasInput() const noexcept {
+            return m_receivedInput || m_heldKeys.any() || m_heldMouseButtons.any();
+        }
+
         /**
          * @brief Returns a reference to the modifier state.
          * 
@@ -165,6 +188,8 @@ namespace wnd {
         std::shared_ptr<voxels::Emitter<const ScrollEvent&>> CursorScrolled = std::make_shared<voxels::Emitter<const ScrollEvent&>>();
         /// @brief Emitted when the window has been requested to close.
         std::shared_ptr<voxels::Emitter<>> CloseRequested = std::make_shared<voxels::Emitter<>>();
+        /// @brief Emitted when the window gains or loses the input focus. ( Provides whether it is focused now. )
+        std::shared_ptr<voxels::Emitter<bool>> FocusChanged = std::make_shared<voxels::Emitter<bool>>();
 
     private:
         std::bitset<0xFF> m_pressedKeys; //< Bitset for all the pressed keys.
@@ -174,6 +199,8 @@ namespace wnd {
         std::bitset<5> m_heldMouseButtons; //< Bitset for all the held mouse buttons.
         std::bitset<5> m_releasedMouseButtons; //< Bitset for all the released mouse buttons.
         ModifierState m_modState; //< The modifier state.
+        bool m_focused = true; //< Whether the window has the input focus.
+        bool m_receivedInput = false; //< Whether any input arrived since the last loop ended.
         struct { int32 x, y; } m_lastCursorPos;
     };
 }
\ No newline at end of file
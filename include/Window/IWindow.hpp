@@ -48,6 +48,14 @@ namespace wnd {
          * @throws Only if the provided callback throws.
          */
         virtual void runLoop(const OnLoopIterationCallback& callback) = 0;
+        /**
+         * @brief Blocks until an event arrives or the timeout expires, whichever comes first.
+         * 
+         * @param timeout The maximum time to wait in seconds.
+         *
+         * @note Used to sleep between frames without missing input.
+         */
+        virtual void waitForEvents(float64 timeout) noexcept = 0;
 
         /**
          * @brief Accepts a window visitor and returns the visitor returned IContext.
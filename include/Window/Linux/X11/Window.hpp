@@ -27,6 +27,7 @@ namespace wnd::x11 {
         Window& operator=(Window&&) = delete;
 
         virtual void runLoop(const OnLoopIterationCallback& callback) override;
+        virtual void waitForEvents(float64 timeout) noexcept override;
 
         virtual inline void setVisibility(bool visible) noexcept override {
             m_visible = visible;
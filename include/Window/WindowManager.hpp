@@ -4,33 +4,64 @@
 #include "Observer.hpp" // For the close requested observer.
 #include "Window/IWindow.hpp" // For the interface.
 #include "Window/EventParser.hpp" // For the event parser.
+#include <chrono> // For the frame pacing.
 #include <functional> // For the LoopCallback
 #include <memory> // For the smart pointers.
 
 namespace wnd {
     struct LoopDescriptor {
         bool shouldClose = false;
-        const float64 deltaTime;
+        const float64 deltaTime; //< The fixed time step in seconds.
         const EventParser& eventParser;
     };
 
+    struct FrameDescriptor {
+        bool shouldClose = false;
+        const float64 deltaTime; //< The time since the last frame in seconds.
+        const float64 alpha; //< How far the frame lies between the last two simulation steps, in [0, 1).
+        const EventParser& eventParser;
+    };
+
+    /**
+     * @brief Controls how the loop steps the simulation and paces the frames.
+     */
+    struct LoopSettings {
+        float64 fixedTimeStep = 1.0 / 60.0; //< The simulated time per update in seconds.
+        uint32 maxStepsPerFrame = 8; //< Time beyond this many steps is dropped so a long stall does not spiral.
+        float64 maxFrameRate = 0.0; //< The frame rate cap, 0 leaves it uncapped.
+        float64 idleFrameRate = 10.0; //< The frame rate while the window is unfocused or idle, 0 disables idling.
+        float64 idleAfter = 5.0; //< Seconds without input after which the loop idles.
+    };
+
     class WindowManager {
     public:
         /**
-         * @brief A callback that gets called for each loop iteration.
+         * @brief A callback that gets called for each simulation step.
          * 
          * @param loopDescriptor The loop descriptor.
          */
         using LoopCallback = std::function<void(LoopDescriptor& loopDescriptor)>;
+        /**
+         * @brief A callback that gets called once per frame after the simulation steps.
+         * 
+         * @param frameDescriptor The frame descriptor.
+         */
+        using FrameCallback = std::function<void(FrameDescriptor& frameDescriptor)>;
 
         explicit WindowManager(std::unique_ptr<IWindow>&& window) noexcept;
 
         /**
          * @brief Runs the loop.
          * 
-         * @param callback The callback to call.
+         * @param update The callback that steps the simulation, it always receives the fixed time step.
+         * @param render The callback that draws a frame.
+         * @param settings The time step and frame pacing settings.
+         *
+         * @note The simulation runs zero or more fixed steps per frame so it behaves the same at any frame rate,
+         * the render callback gets the fraction of a step that is left over to interpolate between the last two steps.
+         * Pressed and released input is visible to the first step of a frame only.
          */
-        void runLoop(const LoopCallback& callback);
+        void runLoop(const LoopCallback& update, const FrameCallback& render, const LoopSettings& settings = {});
 
         /**
          * @brief Gets the event parser.
@@ -42,6 +73,11 @@ namespace wnd {
         [[nodiscard]] inline const IWindow& getWindow() const noexcept { return *m_window; }
 
     private:
+        /**
+         * @brief Sleeps until the time point, the last millisecond is spent yielding because sleeps overshoot.
+         */
+        static void sleepUntil(std::chrono::steady_clock::time_point time) noexcept;
+
         std::unique_ptr<IWindow> m_window; //< The managed window.
         std::shared_ptr<EventParser> m_eventParser; //< The input parser. 
         voxels::Observer<> m_closeRequestedObserver; //< Observer for the close requested event.
@@ -1,5 +1,124 @@
 #pragma once
 
+#include "Global.hpp"
+#include "OctTree.hpp"
+#include "PaletteStorage.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_int3.hpp"
+#include "ext/vector_uint3.hpp"
+#include <concepts> // For constraining the storage.
+#include <cstddef> // For size_t.
+
 namespace world {
-    
-}
\ No newline at end of file
+    /// @brief The data of a single voxel, an index into the block registry.
+    using Voxel = uint32;
+    /// @brief The voxel every chunk is initially filled with.
+    static constexpr Voxel AIR = 0;
+    /// @brief The length of a section, the part of a chunk that is meshed at once.
+    static constexpr uint32 SECTION_LENGTH = 32;
+    /// @brief The number of sections along each axis of a chunk.
+    static constexpr uint32 SECTIONS_PER_AXIS = CHUNK_LENGTH / SECTION_LENGTH;
+
+    static_assert(CHUNK_LENGTH % SECTION_LENGTH == 0, "The chunk length has to be a multiple of the section length.");
+
+    /**
+     * @brief A voxel storage that a chunk can be backed by, such as voxels::OctTree or voxels::PaletteStorage.
+     */
+    template<typename S>
+    concept VoxelStorage = requires(S storage, const S& constStorage, glm::uvec3 voxel, Voxel data) {
+        { constStorage.get(voxel) } -> std::convertible_to<Voxel>;
+        storage.insert(Voxel(data), voxel);
+        storage.fill(data, voxel, voxel);
+        { constStorage.getMemoryUsage() } -> std::convertible_to<size_t>;
+    };
+
+    /**
+     * @brief A cube of CHUNK_LENGTH^3 voxels at an integer chunk coordinate.
+     *
+     * @tparam Storage The storage of the voxels.
+     */
+    template<VoxelStorage Storage>
+    class BasicChunk {
+    public:
+        /**
+         * @brief Constructs a new chunk filled with air.
+         *
+         * @param coordinate The chunk coordinate, the chunk covers the voxels [coordinate * CHUNK_LENGTH, ( coordinate + 1 ) * CHUNK_LENGTH).
+         */
+        explicit BasicChunk(glm::ivec3 coordinate)
+            : m_coordinate(coordinate)
+            , m_voxels(createStorage(getCenter())) {  }
+
+        /**
+         * @brief Gets the voxel.
+         *
+         * @param local The voxel coordinates relative to the minimum corner of the chunk.
+         * @return Voxel The voxel.
+         */
+        [[nodiscard]] inline Voxel get(glm::uvec3 local) const noexcept { return m_voxels.get(local); }
+        /**
+         * @brief Sets the voxel.
+         *
+         * @param local The voxel coordinates relative to the minimum corner of the chunk.
+         * @param voxel The new voxel.
+         */
+        inline void set(glm::uvec3 local, Voxel voxel) { m_voxels.insert(Voxel(voxel), local); }
+        /**
+         * @brief Sets every voxel inside the region.
+         *
+         * @param min The minimum local voxel of the region.
+         * @param max The maximum local voxel of the region ( exclusive ).
+         * @param voxel The new voxel.
+         */
+        inline void fill(glm::uvec3 min, glm::uvec3 max, Voxel voxel) { m_voxels.fill(voxel, min, max); }
+
+        /**
+         * @brief Returns whether the chunk is known to only hold air without looking at every voxel.
+         *
+         * @note Only palette storages can tell cheaply, a chunk that got emptied voxel by voxel may still report false.
+         */
+        [[nodiscard]] inline bool isEmpty() const noexcept {
+            if constexpr(requires { m_voxels.getBitsPerVoxel(); })
+                return m_voxels.getBitsPerVoxel() == 0 && get(glm::uvec3(0)) == AIR;
+            else
+                return false;
+        }
+
+        [[nodiscard]] inline glm::ivec3 getCoordinate() const noexcept { return m_coordinate; }
+        /**
+         * @brief Gets the world space position of the minimum corner of the chunk.
+         */
+        [[nodiscard]] inline glm::vec3 getOrigin() const noexcept { return glm::vec3(m_coordinate) * static_cast<float32>(CHUNK_LENGTH); }
+        /**
+         * @brief Gets the world space position of the center of the chunk.
+         */
+        [[nodiscard]] inline glm::vec3 getCenter() const noexcept { return getOrigin() + static_cast<float32>(CHUNK_LENGTH) / 2.0f; }
+        [[nodiscard]] inline Storage& getVoxels() noexcept { return m_voxels; }
+        [[nodiscard]] inline const Storage& getVoxels() const noexcept { return m_voxels; }
+        /**
+         * @brief Returns the number of bytes used by the chunk including its voxels.
+         */
+        [[nodiscard]] inline size_t getMemoryUsage() const noexcept { return sizeof(*this) - sizeof(m_voxels) + m_voxels.getMemoryUsage(); }
+
+    private:
+        /**
+         * @brief Creates the storage filled with air, storages that are placed in space also receive the chunk center.
+         */
+        [[nodiscard]] static Storage createStorage(glm::vec3 center) {
+            if constexpr(std::constructible_from<Storage, Voxel&&, glm::vec3>)
+                return Storage(Voxel(AIR), center);
+            else
+                return Storage(Voxel(AIR));
+        }
+
+        const glm::ivec3 m_coordinate; //< The chunk coordinate.
+        Storage m_voxels; //< The voxels.
+    };
+
+    /// @brief A chunk backed by an oct tree, best for mostly uniform chunks that are rarely read voxel by voxel.
+    using OctTreeChunk = BasicChunk<voxels::OctTree<Voxel>>;
+    /// @brief A chunk backed by a palette, reads and writes are a few instructions and the memory is bounded by the palette size.
+    using PaletteChunk = BasicChunk<voxels::PaletteStorage<Voxel>>;
+    /// @brief The chunk used by the world.
+    using Chunk = PaletteChunk;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "Global.hpp"
+#include "ext/vector_int3.hpp"
+#include <algorithm> // For std::max.
+#include <bit> // For rounding the capacity to a power of two.
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <optional> // For the slot values.
+#include <utility> // For std::pair.
+#include <vector> // For the slots.
+
+namespace world {
+    /**
+     * @brief Hash map keyed by integer chunk coordinates.
+     *
+     * @tparam V The value type.
+     *
+     * @note Uses open addressing with linear probing in a single power of two array, so a lookup is a hash and
+     * usually a single cache line. Erasing shifts the following entries back instead of leaving tombstones,
+     * so the probe lengths do not degrade while chunks stream in and out. The load factor is kept at or below one half.
+     */
+    template<typename V>
+    class ChunkMap {
+    public:
+        /**
+         * @brief Constructs a new empty map.
+         *
+         * @param capacity How many entries the map should hold without growing.
+         */
+        explicit ChunkMap(size_t capacity = 16) : m_slots(getSlotCount(capacity)) {  }
+
+        /**
+         * @brief Finds the value of the key.
+         *
+         * @param key The chunk coordinate.
+         * @return V* The value or nullptr if the key is not in the map.
+         */
+        [[nodiscard]] V* find(glm::ivec3 key) noexcept {
+            for(auto index = getHomeSlot(key);; index = (index + 1) & getMask()) {
+                auto& slot = m_slots[index];
+                if(!slot.value)
+                    return nullptr;
+                if(slot.key == key)
+                    return &*slot.value;
+            }
+        }
+
+        /**
+         * @brief Finds the value of the key.
+         *
+         * @param key The chunk coordinate.
+         * @return const V* The value or nullptr if the key is not in the map.
+         */
+        [[nodiscard]] inline const V* find(glm::ivec3 key) const noexcept {
+            return const_cast<ChunkMap*>(this)->find(key);
+        }
+
+        /**
+         * @brief Constructs a value for the key if it is not in the map yet.
+         *
+         * @param key The chunk coordinate.
+         * @param args The arguments to construct the value with.
+         * @return std::pair<V&, bool> The value of the key and whether it was inserted.
+         */
+        template<typename... Args>
+        std::pair<V&, bool> tryEmplace(glm::ivec3 key, Args&&... args) {
+            if((m_size + 1) * 2 > m_slots.size())
+                rehash(m_slots.size() * 2);
+
+            auto index = getHomeSlot(key);
+            for(; m_slots[index].value; index = (index + 1) & getMask()) {
+                if(m_slots[index].key == key)
+                    return { *m_slots[index].value, false };
+            }
+
+            auto& slot = m_slots[index];
+            slot.key = key;
+            slot.value.emplace(std::forward<Args>(args)...);
+            ++m_size;
+            return { *slot.value, true };
+        }
+
+        /**
+         * @brief Removes the key from the map.
+         *
+         * @param key The chunk coordinate.
+         * @return true If the key was in the map.
+         * @return false Otherwise.
+         */
+        bool erase(glm::ivec3 key) {
+            auto hole = getHomeSlot(key);
+            for(;; hole = (hole + 1) & getMask()) {
+                if(!m_slots[hole].value)
+                    return false;
+                if(m_slots[hole].key == key)
+                    break;
+            }
+
+            // Shift back every following entry of the cluster whose home slot is not between the hole and itself.
+            for(auto index = (hole + 1) & getMask(); m_slots[index].value; index = (index + 1) & getMask()) {
+                auto home = getHomeSlot(m_slots[index].key);
+                bool reachable = hole <= index ? (home > hole && home <= index) : (home > hole || home <= index);
+                if(reachable)
+                    continue;
+                m_slots[hole] = std::move(m_slots[index]);
+                hole = index;
+            }
+
+            m_slots[hole].value.reset();
+            --m_size;
+            return true;
+        }
+
+        /**
+         * @brief Calls the callback for every entry in an unspecified order.
+         *
+         * @param callback The callback which receives the key and the value, it must not insert or erase entries.
+         */
+        template<std::invocable<glm::ivec3, V&> F>
+        void forEach(F&& callback) {
+            for(auto& slot : m_slots) {
+                if(slot.value)
+                    callback(slot.key, *slot.value);
+            }
+        }
+
+        /**
+         * @brief Calls the callback for every entry in an unspecified order.
+         *
+         * @param callback The callback which receives the key and the value.
+         */
+        template<std::invocable<glm::ivec3, const V&> F>
+        void forEach(F&& callback) const {
+            for(const auto& slot : m_slots) {
+                if(slot.value)
+                    callback(slot.key, *slot.value);
+            }
+        }
+
+        /**
+         * @brief Grows the map so that it can hold the entries without rehashing.
+         *
+         * @param capacity The number of entries.
+         */
+        void reserve(size_t capacity) {
+            auto slotCount = getSlotCount(capacity);
+            if(slotCount > m_slots.size())
+                rehash(slotCount);
+        }
+
+        /**
+         * @brief Removes every entry while keeping the capacity.
+         */
+        void clear() noexcept {
+            for(auto& slot : m_slots) {
+                slot.value.reset();
+            }
+            m_size = 0;
+        }
+
+        [[nodiscard]] inline size_t size() const noexcept { return m_size; }
+        [[nodiscard]] inline bool empty() const noexcept { return m_size == 0; }
+        /**
+         * @brief Returns how many entries the map can hold before it grows.
+         */
+        [[nodiscard]] inline size_t capacity() const noexcept { return m_slots.size() / 2; }
+        /**
+         * @brief Returns the number of bytes used by the slots, memory owned by the values is not included.
+         */
+        [[nodiscard]] inline size_t getMemoryUsage() const noexcept { return m_slots.size() * sizeof(Slot); }
+
+        /**
+         * @brief Hashes the chunk coordinate.
+         *
+         * @note The coordinates are packed into 64 bits and mixed with the murmur3 finalizer,
+         * neighbouring chunks therefore end up in unrelated slots.
+         */
+        [[nodiscard]] static constexpr uint64 hash(glm::ivec3 key) noexcept {
+            uint64 bits = (static_cast<uint64>(static_cast<uint32>(key.x) & 0x1FFFFF) << 42)
+                | (static_cast<uint64>(static_cast<uint32>(key.y) & 0x1FFFFF) << 21)
+                | (static_cast<uint64>(static_cast<uint32>(key.z) & 0x1FFFFF));
+            bits ^= bits >> 33;
+            bits *= 0xff51afd7ed558ccd;
+            bits ^= bits >> 33;
+            bits *= 0xc4ceb9fe1a85ec53;
+            bits ^= bits >> 33;
+            return bits;
+        }
+
+    private:
+        /**
+         * @brief A slot of the table, it is empty if it has no value.
+         */
+        struct Slot {
+            glm::ivec3 key; //< The chunk coordinate.
+            std::optional<V> value; //< The value.
+        };
+
+        [[nodiscard]] static inline size_t getSlotCount(size_t capacity) noexcept {
+            return std::bit_ceil(std::max<size_t>(capacity, 8) * 2);
+        }
+
+        [[nodiscard]] inline size_t getMask() const noexcept { return m_slots.size() - 1; }
+        [[nodiscard]] inline size_t getHomeSlot(glm::ivec3 key) const noexcept { return hash(key) & getMask(); }
+
+        void rehash(size_t slotCount) {
+            auto slots = std::vector<Slot>(slotCount);
+            slots.swap(m_slots);
+            for(auto& slot : slots) {
+                if(!slot.value)
+                    continue;
+                auto index = getHomeSlot(slot.key);
+                while(m_slots[index].value) {
+                    index = (index + 1) & getMask();
+                }
+                m_slots[index] = std::move(slot);
+            }
+        }
+
+        std::vector<Slot> m_slots; //< The table, its size is always a power of two.
+        size_t m_size = 0; //< The number of entries.
+    };
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Global.hpp"
+#include "Mesh.hpp"
+#include "World/Chunk.hpp"
+#include "World/World.hpp"
+#include "ext/vector_int3.hpp"
+#include "ext/vector_uint3.hpp"
+#include <bit> // For the number of levels.
+#include <vector> // For the scratch buffers and the meshes.
+
+namespace world {
+    /// @brief The coarsest level of detail, a node of it covers a whole chunk. A node of level l covers 2^l sections along each axis.
+    static constexpr uint32 MAX_LEVEL_OF_DETAIL = std::countr_zero(SECTIONS_PER_AXIS);
+
+    /**
+     * @brief The faces of a single material.
+     */
+    struct MaterialMesh {
+        Voxel material; //< The material of every face.
+        voxels::Mesh mesh; //< The faces, positions are relative to the minimum corner of the section.
+    };
+
+    /**
+     * @brief Turns the voxels of a section into quads.
+     *
+     * @note Only faces between a solid voxel and air are emitted, the voxels around the section are read from the
+     * neighbouring sections and chunks so the borders are culled as well. Unloaded neighbours count as air.
+     * Coplanar faces of the same material are greedily merged into rectangles, the texture coordinates of a
+     * quad run from zero to its size in voxels so a repeating texture still shows one tile per voxel.
+     * Packed meshes also carry per vertex ambient occlusion, faces are then only merged if their occlusion is uniform.
+     * Distant parts of the world are meshed at a coarser level of detail, where a cell stands for a cube of voxels.
+     * A mesher keeps its scratch buffers between calls, so every thread should use its own.
+     */
+    class ChunkMesher {
+    public:
+        explicit ChunkMesher();
+
+        /**
+         * @brief Meshes the section.
+         *
+         * @param world The world the section is in.
+         * @param chunk The chunk the section is in.
+         * @param section The coordinate of the section inside the chunk, each component is below SECTIONS_PER_AXIS.
+         * @return std::vector<MaterialMesh> A mesh per material that has visible faces.
+         */
+        [[nodiscard]] std::vector<MaterialMesh> mesh(const World& world, const Chunk& chunk, glm::uvec3 section);
+
+        /**
+         * @brief Meshes the section into packed vertices with ambient occlusion.
+         *
+         * @param world The world the section is in.
+         * @param chunk The chunk the section is in.
+         * @param section The coordinate of the section inside the chunk, each component is below SECTIONS_PER_AXIS.
+         * @param skirts The faces of the chunk behind which the neighbours count as air, one bit per normal index.
+         * Set for neighbours drawn at a coarser level of detail, whose surface may not line up with this one.
+         * @return voxels::PackedMesh The faces of every material, drawn with the shared quad indices.
+         */
+        [[nodiscard]] voxels::PackedMesh meshPacked(const World& world, const Chunk& chunk, glm::uvec3 section, uint8 skirts = 0);
+
+        /**
+         * @brief Meshes the section of the chunk in the middle of the neighbourhood, see the overload above.
+         *
+         * @note Reads nothing but the neighbourhood, so it can run while the world changes.
+         */
+        [[nodiscard]] voxels::PackedMesh meshPacked(const ChunkNeighbourhood& neighbourhood, glm::uvec3 section, uint8 skirts = 0);
+
+        /**
+         * @brief Meshes a node of the chunk at a coarser level of detail into packed vertices.
+         *
+         * @param chunk The chunk the node is in.
+         * @param node The coordinate of the node inside the chunk, each component is below SECTIONS_PER_AXIS >> level.
+         * @param level The level of detail, at most MAX_LEVEL_OF_DETAIL. A cell covers 2^level voxels along each axis.
+         * @return voxels::PackedMesh The faces, positions are in cells relative to the minimum corner of the node.
+         *
+         * @note A cell is solid if at least half of its voxels are and takes the most common solid material.
+         * Everything outside the chunk counts as air, so the node closes its surface with skirts along the chunk
+         * borders and no crack opens towards neighbours at another level of detail.
+         */
+        [[nodiscard]] voxels::PackedMesh meshPackedLevel(const Chunk& chunk, glm::uvec3 node, uint32 level);
+
+        /**
+         * @brief Returns whether every voxel of the last meshed section is solid, such a section hides everything behind it.
+         */
+        [[nodiscard]] inline bool isSolid() const noexcept { return m_solid; }
+
+    private:
+        /**
+         * @brief A rectangle of merged faces.
+         */
+        struct Quad {
+            uint32 axis; //< The axis the quad is perpendicular to.
+            uint32 slice; //< The position of the quad along the axis.
+            bool positive; //< Whether the quad faces the positive end of the axis.
+            uint32 i, j; //< The minimum corner along the two other axes.
+            uint32 width, height; //< The size along the two other axes.
+            Voxel material; //< The material.
+            uint8 occlusion; //< The ambient occlusion of the four corners, two bits each in vertex order.
+        };
+        /// @brief The length of the section including the voxels around it.
+        static constexpr uint32 PADDED_LENGTH = SECTION_LENGTH + 2;
+
+        [[nodiscard]] static inline size_t getPaddedIndex(uint32 x, uint32 y, uint32 z) noexcept {
+            return (static_cast<size_t>(x) * PADDED_LENGTH + y) * PADDED_LENGTH + z;
+        }
+
+        /**
+         * @brief Copies the section and the voxels around it into the padded buffer.
+         *
+         * @param getOutside Returns the voxel at a world voxel position outside of the chunk.
+         */
+        template<typename F>
+        void gatherVoxels(const Chunk& chunk, glm::uvec3 section, uint8 skirts, F&& getOutside);
+        /**
+         * @brief Fills the padded buffer with the representative voxels of the cells of the node and the cells around it.
+         */
+        void gatherCells(const Chunk& chunk, glm::uvec3 node, uint32 level);
+        /**
+         * @brief Returns the representative voxel of the cell.
+         *
+         * @param min The minimum local voxel of the cell.
+         * @param length The length of the cell in voxels.
+         * @param inNode Whether the cell belongs to the node, any air in it then clears m_solid.
+         */
+        [[nodiscard]] Voxel getRepresentative(const Chunk& chunk, glm::uvec3 min, uint32 length, bool inNode);
+        /**
+         * @brief Meshes the gathered voxels into packed vertices.
+         */
+        [[nodiscard]] voxels::PackedMesh packQuads();
+
+        /**
+         * @brief Finds the visible faces of the gathered voxels, merges them and calls the callback for every quad.
+         *
+         * @param occlusion Whether the ambient occlusion is computed.
+         * @param emit The callback which receives the quads.
+         */
+        template<typename F>
+        void forEachQuad(bool occlusion, F&& emit);
+
+        /**
+         * @brief Returns the ambient occlusion of the four corners of a face, two bits per corner.
+         *
+         * @param front The padded index of the air voxel in front of the face.
+         * @param uStride The padded stride along the first axis of the face.
+         * @param vStride The padded stride along the second axis of the face.
+         */
+        [[nodiscard]] uint8 getOcclusion(size_t front, size_t uStride, size_t vStride) const noexcept;
+
+        std::vector<Voxel> m_voxels; //< The section with a one voxel border, x is the slowest changing coordinate.
+        std::vector<uint64> m_mask; //< The faces in the current slice, the material and the occlusion above it, zero where there is no face.
+        bool m_solid = false; //< Whether the last meshed section has no air.
+    };
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CameraDescriptor.hpp"
+#include "Global.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "World/Chunk.hpp"
+#include "World/ChunkMap.hpp"
+#include "World/World.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_int3.hpp"
+#include <cstddef> // For size_t.
+#include <functional> // For the generator.
+#include <memory> // For std::unique_ptr.
+#include <mutex> // For guarding the shared state.
+#include <vector> // For the queues.
+
+namespace world {
+    /**
+     * @brief Parameters of the chunk streaming.
+     */
+    struct StreamingDescriptor {
+        int32 loadRadius = 2; //< Chunks whose center is within this many chunks of the camera are loaded.
+        int32 unloadRadius = 3; //< Chunks further than this many chunks are unloaded, larger than the load radius to avoid thrashing at the border.
+        size_t memoryBudget = size_t(512) << 20; //< How many bytes the loaded chunks may use.
+        uint32 maxJobs = 0; //< How many chunks may be generated at once, zero uses the number of job system workers.
+    };
+
+    /**
+     * @brief Loads the chunks around the camera into the world on the job system and unloads far ones.
+     *
+     * @note The world is only ever touched by the thread that calls update, the jobs construct chunks on the side
+     * and hand them over once they are complete. update only takes short locks to exchange queues,
+     * so the frame thread never waits for chunk generation or IO.
+     */
+    class ChunkStreamer {
+    public:
+        /// @brief Fills a freshly constructed chunk, it is called from jobs and may block on IO.
+        using Generator = std::function<void(Chunk&)>;
+
+        /**
+         * @brief Constructs a new streamer.
+         *
+         * @param world The world to stream into, it has to outlive the streamer.
+         * @param generator The function that generates or loads the chunks.
+         * @param descriptor The streaming parameters.
+         * @param jobSystem The job system that runs the generator.
+         */
+        explicit ChunkStreamer(World& world, Generator&& generator, const StreamingDescriptor& descriptor = {}, jobs::JobSystem& jobSystem = jobs::getJobSystem());
+        ~ChunkStreamer();
+
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+        /**
+         * @brief Moves finished chunks into the world, unloads far chunks and reprioritizes the load queue.
+         *
+         * @param camera The camera to stream around.
+         */
+        void update(const voxels::CameraDescriptor& camera);
+
+        /**
+         * @brief Returns how many chunks are waiting to be generated or are being generated.
+         */
+        [[nodiscard]] size_t getPendingCount() const;
+        [[nodiscard]] inline const StreamingDescriptor& getDescriptor() const noexcept { return m_descriptor; }
+        [[nodiscard]] inline size_t getLoadedCount() const noexcept { return m_loadedCount; }
+        [[nodiscard]] inline size_t getUnloadedCount() const noexcept { return m_unloadedCount; }
+
+        /**
+         * @brief Computes the load priority of a chunk, lower values are loaded first.
+         *
+         * @param coordinate The chunk coordinate.
+         * @param camera The camera.
+         * @return float32 The priority.
+         *
+         * @note The distance to the camera is scaled up to three times for chunks behind the camera,
+         * so visible chunks are loaded first without starving the ones right next to the camera.
+         */
+        [[nodiscard]] static float32 getPriority(glm::ivec3 coordinate, const voxels::CameraDescriptor& camera) noexcept;
+
+    private:
+        /**
+         * @brief A chunk that should be loaded.
+         */
+        struct Request {
+            glm::ivec3 coordinate; //< The chunk coordinate.
+            float32 priority; //< The load priority.
+        };
+
+        /**
+         * @brief Generates the most important queued chunk, runs as a job.
+         */
+        void generateNext();
+
+        World& m_world; //< The world that is streamed into.
+        jobs::JobSystem& m_jobSystem; //< The job system that runs the generator.
+        Generator m_generator; //< The chunk generator.
+        const StreamingDescriptor m_descriptor; //< The streaming parameters.
+        size_t m_loadedCount = 0; //< How many chunks have been moved into the world.
+        size_t m_unloadedCount = 0; //< How many chunks have been unloaded.
+
+        mutable std::mutex m_mutex; //< Guards the state below.
+        std::vector<Request> m_queue; //< The requests, sorted so that the most important one is at the back.
+        ChunkMap<bool> m_generating; //< The chunks that are being generated or have not been moved into the world yet.
+        std::vector<std::unique_ptr<Chunk>> m_completed; //< The generated chunks.
+        uint32 m_activeJobs = 0; //< The number of submitted generator jobs.
+        bool m_stopping = false; //< Set when the streamer is destroyed, queued jobs then return immediately.
+
+        jobs::Counter m_jobs; //< Tracks the generator jobs.
+    };
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "CameraDescriptor.hpp"
+#include "Global.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Mesh.hpp"
+#include "World/ChunkMap.hpp"
+#include "World/ChunkMesher.hpp"
+#include "World/World.hpp"
+#include "ext/vector_float3.hpp"
+#include "ext/vector_int3.hpp"
+#include <cmath> // For the view distance.
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <memory> // For the shared chunks.
+#include <optional> // For the neighbourhoods.
+#include <vector> // For the updated sections and the nodes being meshed.
+
+namespace world {
+    /**
+     * @brief Parameters of the remeshing.
+     */
+    struct RemeshingDescriptor {
+        size_t maxSectionsPerUpdate = 64; //< How many nodes are meshed per update at most, the rest wait for the next one.
+        float32 maxScreenError = 0.004f; //< The largest share of the viewport height a cell may cover before a finer level of detail is used, zero disables the levels of detail.
+    };
+
+    /**
+     * @brief Keeps a packed mesh of every visible node up to date by meshing only the nodes the world marked dirty.
+     *
+     * @note Every chunk is drawn at a level of detail picked from the screen space size of a cell at the distance
+     * of the chunk, a node of level l is a cube of 2^l sections meshed with cells of 2^l voxels, so a distant chunk
+     * costs as many triangles as a few sections. Nodes are keyed by their minimum section, level zero nodes are sections.
+     * Sections next to a coarser chunk close their border with skirts, as the coarse nodes do, so no cracks open.
+     * update submits the dirty nodes as one batch of jobs and returns, the jobs read chunks the world shares with them
+     * so the world can change in the meantime. The first update after every job of the batch finished swaps all of
+     * its meshes in at once, so a frame never sees a half updated edit, and submits the next batch. Nodes closest
+     * to the camera are meshed first, a single voxel edit dirties at most eight sections. The finer nodes that replace
+     * a coarser one wait until all of them are meshed, the coarser node is drawn until they are swapped in together.
+     */
+    class Remesher {
+    public:
+        /**
+         * @brief Constructs a new remesher.
+         *
+         * @param world The world to mesh, it has to outlive the remesher.
+         * @param descriptor The remeshing parameters.
+         * @param jobSystem The job system that runs the mesher.
+         */
+        explicit Remesher(World& world, const RemeshingDescriptor& descriptor = {}, jobs::JobSystem& jobSystem = jobs::getJobSystem());
+
+        /**
+         * @brief Waits for the nodes being meshed, their jobs use the remesher.
+         */
+        ~Remesher();
+
+        Remesher(const Remesher&) = delete;
+        Remesher& operator=(const Remesher&) = delete;
+
+        /**
+         * @brief Swaps in the meshes of the last batch if it finished and starts meshing the most important dirty sections, should be called at the start of a frame.
+         *
+         * @param camera The camera whose surroundings are meshed first.
+         *
+         * @note Never waits for the jobs, a batch is swapped in by the first update after it finished.
+         */
+        void update(const voxels::CameraDescriptor& camera);
+
+        /**
+         * @brief Blocks until the batch being meshed finished, so the next update swaps it in.
+         *
+         * @note For tools and benchmarks, a frame should never wait.
+         */
+        void wait();
+
+        /**
+         * @brief Finds the mesh of the node.
+         *
+         * @param section The minimum section of the node, see toSectionCoordinate.
+         * @return const voxels::PackedMesh* The mesh or nullptr if the node has no visible faces.
+         */
+        [[nodiscard]] inline const voxels::PackedMesh* getMesh(glm::ivec3 section) const noexcept { return m_meshes.find(section); }
+
+        /**
+         * @brief Returns the level of detail of the node.
+         *
+         * @param section The minimum section of the node.
+         * @return uint32 The level, zero if there is no node with a mesh or without air.
+         */
+        [[nodiscard]] inline uint32 getLevel(glm::ivec3 section) const noexcept {
+            auto level = m_levels.find(section);
+            return level ? *level : 0;
+        }
+
+        /**
+         * @brief Returns the level of detail the chunk is drawn at.
+         *
+         * @param chunk The chunk coordinate.
+         */
+        [[nodiscard]] inline uint32 getChunkLevel(glm::ivec3 chunk) const noexcept {
+            auto level = m_chunkLevels.find(chunk);
+            return level ? *level : 0;
+        }
+
+        /**
+         * @brief Calls the callback for every node with visible faces in an unspecified order.
+         *
+         * @param callback The callback which receives the minimum section of the node and its mesh.
+         */
+        template<std::invocable<glm::ivec3, const voxels::PackedMesh&> F>
+        inline void forEachMesh(F&& callback) const {
+            m_meshes.forEach(std::forward<F>(callback));
+        }
+
+        /**
+         * @brief Returns whether every voxel of the node is solid, as of its last meshing.
+         *
+         * @param section The minimum section of the node.
+         */
+        [[nodiscard]] inline bool isSolid(glm::ivec3 section) const noexcept { return m_solid.find(section) != nullptr; }
+
+        /**
+         * @brief Calls the callback for every node without air in an unspecified order, these make good occluders.
+         *
+         * @param callback The callback which receives the minimum section of the node.
+         */
+        template<std::invocable<glm::ivec3> F>
+        inline void forEachSolidSection(F&& callback) const {
+            m_solid.forEach([&](glm::ivec3 section, bool) { callback(section); });
+        }
+
+        /**
+         * @brief Returns the nodes the last update meshed or removed, their meshes, levels and solidity were replaced.
+         *
+         * @note Consumers that mirror the meshes, like the GPU mesh arena, have to look at this after every update.
+         */
+        [[nodiscard]] inline const std::vector<glm::ivec3>& getUpdatedSections() const noexcept { return m_updated; }
+        [[nodiscard]] inline size_t getMeshCount() const noexcept { return m_meshes.size(); }
+        /**
+         * @brief Returns how many nodes the last update meshed or removed.
+         */
+        [[nodiscard]] inline size_t getProcessedCount() const noexcept { return m_updated.size(); }
+        /**
+         * @brief Returns how many dirty sections wait for a later update, their nodes are meshed once.
+         */
+        [[nodiscard]] inline size_t getPendingCount() const noexcept { return m_pending.size(); }
+        /**
+         * @brief Returns how many nodes the batch being meshed holds, zero if none is.
+         */
+        [[nodiscard]] inline size_t getMeshingCount() const noexcept { return m_work.size(); }
+        /**
+         * @brief Returns whether no dirty section waits and no batch is being meshed.
+         */
+        [[nodiscard]] inline bool isIdle() const noexcept { return m_pending.size() == 0 && m_work.empty(); }
+        /**
+         * @brief Returns how many nodes have been meshed in total.
+         */
+        [[nodiscard]] inline size_t getTotalProcessedCount() const noexcept { return m_totalProcessedCount; }
+        [[nodiscard]] inline const RemeshingDescriptor& getDescriptor() const noexcept { return m_descriptor; }
+
+        /**
+         * @brief Returns the distance at which the cells of the coarsest level of detail exceed the screen error.
+         *
+         * @param maxScreenError The maxScreenError of the remeshing parameters.
+         * @param fieldOfView The vertical field of view of the camera in radians.
+         * @return float32 The distance in voxels, zero if the levels of detail are disabled.
+         *
+         * @note Renderers put their far plane there, so the coarse nodes are drawn instead of being meshed and clipped.
+         */
+        [[nodiscard]] static inline float32 getViewDistance(float32 maxScreenError, float32 fieldOfView) noexcept {
+            if(maxScreenError <= 0.0f)
+                return 0.0f;
+            // The inverse of the level selection of updateLevels for the first level above the coarsest one.
+            auto cellsPerDistance = maxScreenError * 2.0f * std::tan(fieldOfView * 0.5f);
+            return static_cast<float32>(2u << MAX_LEVEL_OF_DETAIL) / cellsPerDistance;
+        }
+
+        /**
+         * @brief Returns the world space position of the center of the section.
+         *
+         * @param section The section coordinate.
+         */
+        [[nodiscard]] static inline glm::vec3 getSectionCenter(glm::ivec3 section) noexcept {
+            return (glm::vec3(section) + 0.5f) * static_cast<float32>(SECTION_LENGTH);
+        }
+
+        /**
+         * @brief Returns the minimum section of the node that contains the section.
+         *
+         * @param section The section coordinate.
+         * @param level The level of the node.
+         */
+        [[nodiscard]] static constexpr glm::ivec3 getNode(glm::ivec3 section, uint32 level) noexcept {
+            return { section.x >> level << level, section.y >> level << level, section.z >> level << level };
+        }
+
+    private:
+        /**
+         * @brief A dirty node and its new mesh.
+         */
+        struct Work {
+            glm::ivec3 section; //< The minimum section of the node.
+            uint32 level; //< The level of detail of the node.
+            uint8 skirts; //< The faces of the chunk behind which a coarser chunk lies.
+            float32 distance; //< The squared distance to the camera.
+            std::optional<ChunkNeighbourhood> neighbourhood; //< What a level zero node reads, released once it is meshed.
+            std::shared_ptr<const Chunk> chunk; //< The chunk of a coarser node, released once it is meshed.
+            voxels::PackedMesh mesh; //< The new mesh, empty if the node has no visible faces.
+            bool solid = false; //< Whether the node has no air.
+        };
+
+        /**
+         * @brief Picks the most important dirty nodes and submits a job per node.
+         */
+        void submitWork(const voxels::CameraDescriptor& camera);
+        /**
+         * @brief Meshes the node, runs on the job system and only reads what the node shares.
+         */
+        static void meshNode(Work& work);
+        /**
+         * @brief Swaps in the meshes of the finished batch and of the waiting nodes whose coarser node can be replaced.
+         */
+        void applyWork();
+        /**
+         * @brief Swaps in the mesh of the node and removes the nodes it replaces.
+         */
+        void applyNode(Work& item);
+        /**
+         * @brief Returns the minimum section of the coarser node that contains the node, if one is drawn.
+         */
+        [[nodiscard]] std::optional<glm::ivec3> getCoarserNode(const Work& item) const noexcept;
+        /**
+         * @brief Picks the level of every loaded chunk and queues the nodes of the chunks whose level changed.
+         */
+        void updateLevels(const voxels::CameraDescriptor& camera);
+        /**
+         * @brief Returns the faces of the chunk of the section behind which a coarser chunk lies, see ChunkMesher::meshPacked.
+         */
+        [[nodiscard]] uint8 getSkirts(glm::ivec3 section) const noexcept;
+        /**
+         * @brief Removes the mesh, level and solidity of the node and records it as updated.
+         */
+        void eraseNode(glm::ivec3 section);
+
+        World& m_world; //< The world that is meshed.
+        jobs::JobSystem& m_jobSystem; //< The job system that runs the mesher.
+        const RemeshingDescriptor m_descriptor; //< The remeshing parameters.
+        ChunkMap<bool> m_pending; //< The dirty sections whose nodes have not been meshed yet, the values are unused.
+        ChunkMap<voxels::PackedMesh> m_meshes; //< The meshes of the nodes with visible faces.
+        ChunkMap<bool> m_solid; //< The nodes without air, the values are unused.
+        ChunkMap<uint32> m_levels; //< The level of every node with a mesh or without air.
+        ChunkMap<uint32> m_chunkLevels; //< The level of every loaded chunk, missing while the levels of detail are disabled.
+        std::vector<glm::ivec3> m_updated; //< The nodes the last update meshed or removed.
+        std::vector<Work> m_work; //< The batch being meshed, not touched by the frame until its jobs are done.
+        std::vector<Work> m_waiting; //< Meshed nodes that replace part of a coarser node, swapped in once no section of it is dirty.
+        jobs::Counter m_jobs; //< Tracks the jobs of the batch.
+        size_t m_totalProcessedCount = 0; //< How many nodes have been meshed in total.
+    };
+
+    static_assert(Remesher::getNode({ -1, 9, 3 }, 2) == glm::ivec3(-4, 8, 0));
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Global.hpp"
+#include "World/Chunk.hpp"
+#include "common.hpp"
+#include "gtc/constants.hpp"
+#include "trigonometric.hpp"
+
+namespace world {
+    /// @brief The materials placed by the terrain generator.
+    enum Material : Voxel { Stone = 1, Dirt = 2, Grass = 3 };
+
+    /**
+     * @brief Parameters of the height field terrain.
+     */
+    struct TerrainDescriptor {
+        int32 baseHeight = 0; //< The average world height of the surface.
+        float32 amplitude = 24.0f; //< The maximum distance of the surface from the base height.
+        float32 wavelength = 97.0f; //< The horizontal length of one hill.
+        int32 dirtDepth = 3; //< How many dirt voxels are below the grass.
+    };
+
+    /**
+     * @brief Fills the chunk with a deterministic height field terrain of stone, dirt and grass.
+     *
+     * @param chunk The chunk to fill, it is expected to be filled with air.
+     * @param descriptor The terrain parameters.
+     *
+     * @note Only depends on the chunk coordinate so it can run on any thread.
+     * Chunks completely below or above the surface are filled in one call.
+     */
+    inline void generateTerrain(Chunk& chunk, const TerrainDescriptor& descriptor = {}) {
+        auto origin = chunk.getCoordinate() * static_cast<int32>(CHUNK_LENGTH);
+        auto lowest = descriptor.baseHeight - static_cast<int32>(glm::ceil(descriptor.amplitude)) - descriptor.dirtDepth;
+        auto highest = descriptor.baseHeight + static_cast<int32>(glm::ceil(descriptor.amplitude));
+
+        if(origin.y + static_cast<int32>(CHUNK_LENGTH) <= lowest) {
+            chunk.fill(glm::uvec3(0), glm::uvec3(CHUNK_LENGTH), Stone);
+            return;
+        }
+        if(origin.y > highest)
+            return;
+
+        // Converts a world height to a local one clamped to the chunk.
+        auto toLocal = [&](int32 height) {
+            return static_cast<uint32>(glm::clamp(height - origin.y, 0, static_cast<int32>(CHUNK_LENGTH)));
+        };
+        auto frequency = glm::two_pi<float32>() / descriptor.wavelength;
+        for(uint32 x = 0; x < CHUNK_LENGTH; ++x) {
+            for(uint32 z = 0; z < CHUNK_LENGTH; ++z) {
+                auto worldX = static_cast<float32>(origin.x + static_cast<int32>(x));
+                auto worldZ = static_cast<float32>(origin.z + static_cast<int32>(z));
+                auto height = descriptor.baseHeight + static_cast<int32>(descriptor.amplitude * glm::sin(worldX * frequency) * glm::cos(worldZ * frequency * 0.63f));
+
+                auto column = [&](Voxel voxel, int32 bottom, int32 top) {
+                    auto min = toLocal(bottom), max = toLocal(top);
+                    if(min < max)
+                        chunk.fill({ x, min, z }, { x + 1, max, z + 1 }, voxel);
+                };
+                column(Stone, origin.y, height - descriptor.dirtDepth);
+                column(Dirt, height - descriptor.dirtDepth, height);
+                column(Grass, height, height + 1);
+            }
+        }
+    }
+}
@@ -1,7 +1,20 @@
 #pragma once
 
 #include "Global.hpp"
+#include "World/Chunk.hpp"
+#include "World/ChunkMap.hpp"
+#include "ext/vector_int3.hpp"
+#include "ext/vector_uint3.hpp"
+#include "vector_relational.hpp"
+#include <array> // For the neighbourhood.
+#include <atomic> // For the fence before a change.
+#include <bit> // For the section shift.
+#include <concepts> // For constraining the callbacks.
+#include <cstddef> // For size_t.
+#include <memory> // For the shared chunks.
 #include <random>
+#include <utility> // For std::as_const.
+#include <vector> // For the dirty sections.
 
 namespace world {
     using Id = uint64;
@@ -18,4 +31,312 @@ namespace world {
 
         return distribution(engine);
     }
+
+    /**
+     * @brief Converts a world voxel position to the coordinate of the chunk containing it.
+     * 
+     * @param position The world voxel position.
+     * @return glm::ivec3 The chunk coordinate.
+     */
+    [[nodiscard]] static constexpr glm::ivec3 toChunkCoordinate(glm::ivec3 position) noexcept {
+        // Arithmetic shifts round towards negative infinity, so negative positions end up in the right chunk.
+        return { position.x >> MAX_OCT_TREE_DEPTH, position.y >> MAX_OCT_TREE_DEPTH, position.z >> MAX_OCT_TREE_DEPTH };
+    }
+
+    /**
+     * @brief Converts a world voxel position to the voxel coordinates inside of its chunk.
+     * 
+     * @param position The world voxel position.
+     * @return glm::uvec3 The local voxel coordinates.
+     */
+    [[nodiscard]] static constexpr glm::uvec3 toLocalPosition(glm::ivec3 position) noexcept {
+        return glm::uvec3(position) & (CHUNK_LENGTH - 1);
+    }
+
+    /**
+     * @brief Converts a world voxel position to the coordinate of the section containing it.
+     * 
+     * @param position The world voxel position.
+     * @return glm::ivec3 The section coordinate, the chunk coordinate times SECTIONS_PER_AXIS plus the section inside the chunk.
+     */
+    [[nodiscard]] static constexpr glm::ivec3 toSectionCoordinate(glm::ivec3 position) noexcept {
+        constexpr auto SHIFT = std::countr_zero(SECTION_LENGTH);
+        return { position.x >> SHIFT, position.y >> SHIFT, position.z >> SHIFT };
+    }
+
+    static_assert(toChunkCoordinate({ -1, 0, CHUNK_LENGTH }) == glm::ivec3(-1, 0, 1));
+    static_assert(toSectionCoordinate({ -1, SECTION_LENGTH, CHUNK_LENGTH }) == glm::ivec3(-1, 1, SECTIONS_PER_AXIS));
+    static_assert(toLocalPosition({ -1, 0, CHUNK_LENGTH + 1 }) == glm::uvec3(CHUNK_LENGTH - 1, 0, 1));
+
+    /**
+     * @brief The loaded chunks of a world.
+     *
+     * @note Chunks are heap allocated and shared with the readers on other threads through shareChunk. A chunk that is
+     * shared is copied before it is changed, so a reader keeps an unchanging chunk while the world moves on and
+     * mutable references are only valid until the chunk is shared and changed again. Every change that goes through
+     * the world marks the sections whose meshes it affects as dirty, see takeDirtySections. Chunks that are modified
+     * directly have to be marked with markChunkDirty. The world itself belongs to one thread.
+     */
+    class World {
+    public:
+        /**
+         * @brief Constructs a new world without any chunks.
+         * 
+         * @param chunkCapacity How many chunks can be loaded before the chunk table grows.
+         */
+        explicit World(size_t chunkCapacity = 256) : m_chunks(chunkCapacity) {  }
+
+        /**
+         * @brief Gets a loaded chunk.
+         * 
+         * @param coordinate The chunk coordinate.
+         * @return Chunk* The chunk or nullptr if it is not loaded.
+         */
+        [[nodiscard]] inline Chunk* getChunk(glm::ivec3 coordinate) {
+            auto chunk = m_chunks.find(coordinate);
+            return chunk ? &makeUnique(*chunk) : nullptr;
+        }
+        /**
+         * @brief Gets a loaded chunk.
+         * 
+         * @param coordinate The chunk coordinate.
+         * @return const Chunk* The chunk or nullptr if it is not loaded.
+         */
+        [[nodiscard]] inline const Chunk* getChunk(glm::ivec3 coordinate) const noexcept {
+            auto chunk = m_chunks.find(coordinate);
+            return chunk ? chunk->get() : nullptr;
+        }
+
+        /**
+         * @brief Returns whether the chunk is loaded, without copying it like the mutable getChunk may.
+         */
+        [[nodiscard]] inline bool isLoaded(glm::ivec3 coordinate) const noexcept { return m_chunks.find(coordinate) != nullptr; }
+
+        /**
+         * @brief Gets the chunk, creating an empty one if it is not loaded.
+         * 
+         * @param coordinate The chunk coordinate.
+         * @return Chunk& The chunk.
+         */
+        Chunk& loadChunk(glm::ivec3 coordinate) {
+            auto [chunk, inserted] = m_chunks.tryEmplace(coordinate);
+            if(inserted) {
+                chunk = std::make_shared<Chunk>(coordinate);
+                markChunkDirty(coordinate);
+            }
+            return makeUnique(chunk);
+        }
+
+        /**
+         * @brief Moves an already constructed chunk into the world.
+         * 
+         * @param chunk The chunk.
+         * @return Chunk& The loaded chunk, if there already is a chunk at the coordinate it is kept and the new one is dropped.
+         */
+        Chunk& insertChunk(std::unique_ptr<Chunk>&& chunk) {
+            auto [loaded, inserted] = m_chunks.tryEmplace(chunk->getCoordinate());
+            if(inserted) {
+                loaded = std::move(chunk);
+                markChunkDirty(loaded->getCoordinate());
+            }
+            return makeUnique(loaded);
+        }
+
+        /**
+         * @brief Shares the chunk with a reader on another thread.
+         *
+         * @param coordinate The chunk coordinate.
+         * @return std::shared_ptr<const Chunk> The chunk or nullptr if it is not loaded, it does not change while the reader holds it.
+         */
+        [[nodiscard]] inline std::shared_ptr<const Chunk> shareChunk(glm::ivec3 coordinate) const {
+            auto chunk = m_chunks.find(coordinate);
+            return chunk ? *chunk : nullptr;
+        }
+
+        /**
+         * @brief Unloads the chunk, its memory is freed once no reader shares it anymore.
+         * 
+         * @param coordinate The chunk coordinate.
+         * @return true If the chunk was loaded.
+         * @return false Otherwise.
+         */
+        bool unloadChunk(glm::ivec3 coordinate) {
+            if(!m_chunks.erase(coordinate))
+                return false;
+            markChunkDirty(coordinate);
+            return true;
+        }
+
+        /**
+         * @brief Gets the voxel at the world voxel position.
+         * 
+         * @param position The world voxel position.
+         * @return Voxel The voxel or air if its chunk is not loaded.
+         */
+        [[nodiscard]] inline Voxel getVoxel(glm::ivec3 position) const noexcept {
+            auto chunk = getChunk(toChunkCoordinate(position));
+            return chunk ? chunk->get(toLocalPosition(position)) : AIR;
+        }
+
+        /**
+         * @brief Sets the voxel at the world voxel position, loading its chunk if needed.
+         * 
+         * @param position The world voxel position.
+         * @param voxel The new voxel.
+         */
+        void setVoxel(glm::ivec3 position, Voxel voxel) {
+            loadChunk(toChunkCoordinate(position)).set(toLocalPosition(position), voxel);
+
+            // A mesh also reads the voxels around its section, so a voxel on a border, an edge or a corner
+            // dirties the neighbouring sections that touch it as well.
+            auto section = toSectionCoordinate(position);
+            auto local = glm::uvec3(position) & (SECTION_LENGTH - 1);
+            auto min = section - glm::ivec3(glm::equal(local, glm::uvec3(0)));
+            auto max = section + glm::ivec3(glm::equal(local, glm::uvec3(SECTION_LENGTH - 1)));
+            for(auto x = min.x; x <= max.x; ++x) {
+                for(auto y = min.y; y <= max.y; ++y) {
+                    for(auto z = min.z; z <= max.z; ++z) {
+                        markSectionDirty({ x, y, z });
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Marks the section as needing a new mesh.
+         * 
+         * @param section The section coordinate.
+         */
+        inline void markSectionDirty(glm::ivec3 section) { m_dirtySections.tryEmplace(section, true); }
+
+        /**
+         * @brief Marks every section of the chunk and the sections around it as needing a new mesh.
+         * 
+         * @param coordinate The chunk coordinate.
+         */
+        void markChunkDirty(glm::ivec3 coordinate) {
+            auto min = coordinate * static_cast<int32>(SECTIONS_PER_AXIS) - 1;
+            auto max = (coordinate + 1) * static_cast<int32>(SECTIONS_PER_AXIS);
+            for(auto x = min.x; x <= max.x; ++x) {
+                for(auto y = min.y; y <= max.y; ++y) {
+                    for(auto z = min.z; z <= max.z; ++z) {
+                        markSectionDirty({ x, y, z });
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the sections marked dirty since the last call and clears the marks.
+         * 
+         * @return std::vector<glm::ivec3> The section coordinates, sections of unloaded chunks may be included.
+         */
+        [[nodiscard]] std::vector<glm::ivec3> takeDirtySections() {
+            std::vector<glm::ivec3> sections;
+            sections.reserve(m_dirtySections.size());
+            m_dirtySections.forEach([&](glm::ivec3 section, bool) { sections.push_back(section); });
+            m_dirtySections.clear();
+            return sections;
+        }
+
+        [[nodiscard]] inline size_t getDirtySectionCount() const noexcept { return m_dirtySections.size(); }
+
+        /**
+         * @brief Calls the callback for every loaded chunk in an unspecified order.
+         * 
+         * @param callback The callback which receives the chunk, it must not load or unload chunks.
+         *
+         * @note Shared chunks are copied first, callbacks that only read take a const chunk and use the overload below.
+         */
+        template<std::invocable<Chunk&> F>
+            requires(!std::invocable<F, const Chunk&>)
+        void forEachChunk(F&& callback) {
+            m_chunks.forEach([&](glm::ivec3, std::shared_ptr<Chunk>& chunk) { callback(makeUnique(chunk)); });
+        }
+
+        /**
+         * @brief Calls the callback for every loaded chunk in an unspecified order.
+         * 
+         * @param callback The callback which receives the chunk.
+         */
+        template<std::invocable<const Chunk&> F>
+        void forEachChunk(F&& callback) const {
+            m_chunks.forEach([&](glm::ivec3, const std::shared_ptr<Chunk>& chunk) { callback(*chunk); });
+        }
+
+        [[nodiscard]] inline size_t getChunkCount() const noexcept { return m_chunks.size(); }
+        /**
+         * @brief Returns the number of bytes used by the chunk table and all of the loaded chunks.
+         */
+        [[nodiscard]] size_t getMemoryUsage() const noexcept {
+            auto usage = m_chunks.getMemoryUsage();
+            forEachChunk([&](const Chunk& chunk) { usage += chunk.getMemoryUsage(); });
+            return usage;
+        }
+
+    private:
+        /**
+         * @brief Copies the chunk if a reader shares it, so it can be changed.
+         */
+        static Chunk& makeUnique(std::shared_ptr<Chunk>& chunk) {
+            if(chunk.use_count() > 1) {
+                chunk = std::make_shared<Chunk>(std::as_const(*chunk));
+            } else {
+                // The count is read relaxed, the fence orders the reads of the last reader that let go before the changes.
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+            return *chunk;
+        }
+
+        ChunkMap<std::shared_ptr<Chunk>> m_chunks; //< The loaded chunks.
+        ChunkMap<bool> m_dirtySections; //< The sections whose meshes are out of date, the values are unused.
+    };
+
+    /**
+     * @brief A chunk and the 26 chunks around it shared by the world, everything a level zero mesh of the chunk reads.
+     *
+     * @note The chunks are shared, see World::shareChunk, so the neighbourhood can be read on another thread
+     * while the world changes.
+     */
+    class ChunkNeighbourhood {
+    public:
+        /**
+         * @brief Shares the chunk and its neighbours.
+         *
+         * @param world The world.
+         * @param coordinate The coordinate of the chunk in the middle.
+         */
+        ChunkNeighbourhood(const World& world, glm::ivec3 coordinate) : m_coordinate(coordinate) {
+            for(int32 x = -1; x <= 1; ++x) {
+                for(int32 y = -1; y <= 1; ++y) {
+                    for(int32 z = -1; z <= 1; ++z) {
+                        m_chunks[getIndex({ x, y, z })] = world.shareChunk(coordinate + glm::ivec3(x, y, z));
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the chunk in the middle, nullptr if it is not loaded.
+         */
+        [[nodiscard]] inline const Chunk* getChunk() const noexcept { return m_chunks[getIndex(glm::ivec3(0))].get(); }
+
+        /**
+         * @brief Gets the voxel at the world voxel position, which has to lie in the chunk or one of its neighbours.
+         *
+         * @return Voxel The voxel or air if its chunk is not loaded.
+         */
+        [[nodiscard]] inline Voxel getVoxel(glm::ivec3 position) const noexcept {
+            const auto& chunk = m_chunks[getIndex(toChunkCoordinate(position) - m_coordinate)];
+            return chunk ? chunk->get(toLocalPosition(position)) : AIR;
+        }
+
+    private:
+        [[nodiscard]] static constexpr size_t getIndex(glm::ivec3 offset) noexcept {
+            return static_cast<size_t>(((offset.x + 1) * 3 + offset.y + 1) * 3 + offset.z + 1);
+        }
+
+        glm::ivec3 m_coordinate; //< The coordinate of the chunk in the middle.
+        std::array<std::shared_ptr<const Chunk>, 27> m_chunks; //< The chunks, x is the slowest changing offset.
+    };
 }
\ No newline at end of file
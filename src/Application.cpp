@@ -1,15 +1,65 @@
 #include "Application.hpp"
 
+#include "Profiling/Profiler.hpp" // For the frame profile.
+#include "common.hpp" // For glm::mix.
+#include <iostream> // For printing the frame profile.
+
+#ifdef VOXELS_PROFILING
+namespace {
+    /// @brief How many frames are captured into the trace from the start.
+    constexpr uint32 PROFILE_CAPTURE_FRAMES = 600;
+    /// @brief How often the profile of a frame is printed.
+    constexpr uint64 PROFILE_PRINT_INTERVAL = 240;
+    /// @brief Where the trace is written when the application closes.
+    constexpr const char* PROFILE_TRACE_PATH = "./voxels_trace.json";
+}
+#endif
+
 void voxels::Application::start() noexcept {
-    m_windowManager.runLoop([&](wnd::LoopDescriptor& loopDescriptor) {
+    m_previousCameraPosition = m_cameraController.getCameraDescriptor().position;
+#ifdef VOXELS_PROFILING
+    profiling::getProfiler().startCapture(PROFILE_CAPTURE_FRAMES);
+#endif
+
+    m_windowManager.runLoop(
+        [&](wnd::LoopDescriptor& loopDescriptor) {
+
+            if(loopDescriptor.eventParser.isPressed(wnd::Key::Escape)) {
+                loopDescriptor.shouldClose = true;
+            }
+
+            PROFILE_SCOPE("step");
+            m_previousCameraPosition = m_cameraController.getCameraDescriptor().position;
+            m_cameraController.onUpdate(loopDescriptor.deltaTime);
+            m_chunkStreamer.update(m_cameraController.getCameraDescriptor());
+
+        },
+        [&](wnd::FrameDescriptor& frameDescriptor) {
 
-        if(loopDescriptor.eventParser.isPressed(wnd::Key::Escape)) {
-            loopDescriptor.shouldClose = true;
-        }
+            // Swap in the meshes of everything that changed during the steps before drawing.
+            m_remesher.update(m_cameraController.getCameraDescriptor());
+            m_renderer->updateMeshes(m_remesher);
 
-        m_cameraController.onUpdate(loopDescriptor.deltaTime);
+            // Draw the camera between the last two steps so the motion stays smooth at any frame rate.
+            auto camera = m_cameraController.getCameraDescriptor();
+            auto position = glm::mix(m_previousCameraPosition, camera.position, static_cast<float32>(frameDescriptor.alpha));
+            m_renderer->render({ position, camera.direction, camera.fieldOfView });
 
-        m_renderer->render(m_cameraController.getCameraDescriptor());
+#ifdef VOXELS_PROFILING
+            auto& profiler = profiling::getProfiler();
+            profiler.endFrame();
+            if(profiler.getLastFrame().index % PROFILE_PRINT_INTERVAL == 0)
+                std::cout << profiler.getLastFrame();
+#endif
+        },
+        { .maxFrameRate = 240.0 }
+    );
 
-    });
-}
\ No newline at end of file
+#ifdef VOXELS_PROFILING
+    try {
+        profiling::getProfiler().writeChromeTrace(PROFILE_TRACE_PATH);
+    } catch(const std::exception& exception) {
+        std::cerr << "Could not write the trace: " << exception.what() << '\n';
+    }
+#endif
+}
@@ -1,13 +1,21 @@
 #include "File.hpp" // For declarations.
 #include "Exception.hpp" // For exceptions.
+#include "Jobs/JobSystem.hpp" // For reading on the shared workers.
 #include <filesystem> // For checking if a file exists.
 
 std::future<std::string> voxels::FileReader::readContent() {
-    return std::async(std::launch::async, [this] {
-        std::stringstream bytes;
-        bytes << m_file.rdbuf();
-        return bytes.str();
+    auto promise = std::promise<std::string>();
+    auto future = promise.get_future();
+    jobs::getJobSystem().submit([this, promise = std::move(promise)] mutable {
+        try {
+            std::stringstream bytes;
+            bytes << m_file.rdbuf();
+            promise.set_value(bytes.str());
+        } catch(...) {
+            promise.set_exception(std::current_exception());
+        }
     });
+    return future;
 }
 
 void voxels::FileWriter::writeContent(std::string_view content) {
@@ -0,0 +1,165 @@
+/**
+ * @file JobSystem.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the work stealing job system.
+ */
+
+#include "Jobs/JobSystem.hpp" // For declarations.
+#include <iterator> // For std::prev.
+#include <optional> // For the popped task.
+
+namespace {
+    /// @brief The job system the current thread is a worker of.
+    thread_local const jobs::JobSystem* currentSystem = nullptr;
+    /// @brief The index of the current thread's queue in its job system.
+    thread_local uint32 currentIndex = 0;
+}
+
+jobs::JobSystem::JobSystem(uint32 workerCount) {
+    if(workerCount == 0)
+        workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    for(uint32 i = 0; i < workerCount; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for(uint32 i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this, i](std::stop_token stopToken) { work(stopToken, i); });
+    }
+}
+
+jobs::JobSystem::~JobSystem() {
+    for(auto& worker : m_workers) {
+        worker.request_stop();
+    }
+    m_workers.clear();
+}
+
+void jobs::JobSystem::submit(Job&& job, Counter* counter) {
+    if(counter)
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    push({ std::move(job), counter });
+}
+
+void jobs::JobSystem::submitAfter(Counter& dependency, Job&& job, Counter* counter) {
+    if(counter)
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(dependency.m_mutex);
+        if(!dependency.isDone()) {
+            dependency.m_continuations.emplace_back(std::move(job), counter);
+            return;
+        }
+    }
+    push({ std::move(job), counter });
+}
+
+void jobs::JobSystem::wait(const Counter& counter) {
+    while(!counter.isDone()) {
+        if(!tryRun(&counter))
+            std::this_thread::yield();
+    }
+}
+
+void jobs::JobSystem::push(Task&& task) {
+    auto index = currentSystem == this
+        ? currentIndex
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        auto& queue = *m_queues[index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    m_queuedCount.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock makes sure a worker that is about to sleep sees the job.
+    { std::lock_guard lock(m_sleepMutex); }
+    m_sleepCondition.notify_one();
+}
+
+bool jobs::JobSystem::tryRun(const Counter* counter) {
+    auto isWorker = currentSystem == this;
+    auto first = isWorker ? currentIndex : m_nextQueue.load(std::memory_order_relaxed) % m_queues.size();
+
+    std::optional<Task> task;
+    for(uint32 i = 0; i < m_queues.size() && !task; ++i) {
+        auto index = (first + i) % m_queues.size();
+        auto& queue = *m_queues[index];
+        std::lock_guard lock(queue.mutex);
+        if(queue.tasks.empty())
+            continue;
+        if(counter) {
+            // Only a job of the counter, searched from the end the owner or a thief would take it from.
+            auto matches = [&](const Task& candidate) { return candidate.counter == counter; };
+            auto found = queue.tasks.end();
+            if(isWorker && index == currentIndex) {
+                if(auto last = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), matches); last != queue.tasks.rend())
+                    found = std::prev(last.base());
+            } else {
+                found = std::find_if(queue.tasks.begin(), queue.tasks.end(), matches);
+            }
+            if(found == queue.tasks.end())
+                continue;
+            task.emplace(std::move(*found));
+            queue.tasks.erase(found);
+        } else if(isWorker && index == currentIndex) {
+            // The owner works depth first on its newest job, thieves take the oldest one which is usually the biggest.
+            task.emplace(std::move(queue.tasks.back()));
+            queue.tasks.pop_back();
+        } else {
+            task.emplace(std::move(queue.tasks.front()));
+            queue.tasks.pop_front();
+        }
+    }
+    if(!task)
+        return false;
+
+    m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    task->job();
+    finish(task->counter);
+    return true;
+}
+
+void jobs::JobSystem::finish(Counter* counter) {
+    if(!counter)
+        return;
+
+    // Announced before the decrement, so isDone stays false until this call is done with the counter.
+    counter->m_finishing.fetch_add(1, std::memory_order_relaxed);
+    // Only the job that takes the count to zero runs the continuations, the count is never written back since
+    // a job submitted with the counter in the meantime has already incremented it again.
+    if(counter->m_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        counter->m_finishing.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    // submitAfter checks the count and appends under the lock, so it either sees the counter done or its continuation gets taken here.
+    std::vector<std::pair<Job, Counter*>> continuations;
+    {
+        std::lock_guard lock(counter->m_mutex);
+        continuations.swap(counter->m_continuations);
+    }
+    counter->m_finishing.fetch_sub(1, std::memory_order_release);
+    for(auto& [job, continuationCounter] : continuations) {
+        push({ std::move(job), continuationCounter });
+    }
+}
+
+void jobs::JobSystem::work(std::stop_token stopToken, uint32 index) {
+    currentSystem = this;
+    currentIndex = index;
+
+    while(true) {
+        if(tryRun())
+            continue;
+
+        std::unique_lock lock(m_sleepMutex);
+        // Queued jobs are finished before the worker stops.
+        if(!m_sleepCondition.wait(lock, stopToken, [this] { return m_queuedCount.load(std::memory_order_acquire) > 0; }))
+            return;
+    }
+}
+
+jobs::JobSystem& jobs::getJobSystem() {
+    static JobSystem system;
+    return system;
+}
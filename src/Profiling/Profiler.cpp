@@ -0,0 +1,142 @@
+/**
+ * @file Profiler.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the frame profiler.
+ */
+
+#include "Profiling/Profiler.hpp" // For declarations.
+#include "File.hpp" // For writing the trace.
+#include <algorithm> // For finding the statistics.
+#include <cstring> // For comparing the names.
+#include <filesystem> // For overwriting the trace.
+#include <sstream> // For formatting the trace.
+#include <utility> // For pairing the statistics with their kind.
+
+namespace {
+    /**
+     * @brief Writes the name as a JSON string.
+     */
+    void writeJsonString(std::ostringstream& stream, const char* name) {
+        stream << '"';
+        for(; *name; ++name) {
+            if(*name == '"' || *name == '\\')
+                stream << '\\';
+            stream << *name;
+        }
+        stream << '"';
+    }
+}
+
+std::ostream& profiling::operator<<(std::ostream& stream, const FrameProfile& frame) {
+    auto flags = stream.flags();
+    auto precision = stream.precision(3);
+    stream << std::fixed << "Frame " << frame.index << ": " << frame.milliseconds << " ms";
+    if(frame.dropped > 0)
+        stream << ", " << frame.dropped << " zones dropped";
+    stream << '\n';
+    for(const auto& [statistics, kind] : { std::pair(&frame.cpu, "cpu"), std::pair(&frame.gpu, "gpu") }) {
+        for(const auto& zone : *statistics) {
+            stream << "  " << kind << ' ' << zone.name << ": " << zone.milliseconds << " ms in " << zone.calls
+                << " zones, at most " << zone.maxMilliseconds << " ms\n";
+        }
+    }
+    stream.flags(flags);
+    stream.precision(precision);
+    return stream;
+}
+
+void profiling::Profiler::recordGpu(const ZoneEvent& event) {
+    accumulate(m_frame.gpu, event);
+    if(isCapturing())
+        m_capture.push_back({ event, GPU_THREAD_ID });
+}
+
+void profiling::Profiler::endFrame() {
+    {
+        std::lock_guard lock(m_threadsMutex);
+        for(auto& thread : m_threads) {
+            thread->drain([&](const ZoneEvent& event) {
+                accumulate(m_frame.cpu, event);
+                if(isCapturing())
+                    m_capture.push_back({ event, thread->getThreadId() });
+            });
+            m_frame.dropped += thread->takeDroppedCount();
+        }
+    }
+
+    auto frameEnd = now();
+    m_frame.milliseconds = static_cast<float64>(frameEnd - m_frameStart) / 1e6;
+    m_frameStart = frameEnd;
+    if(m_captureFramesLeft > 0)
+        --m_captureFramesLeft;
+
+    // The vectors of the old frame are reused, the names of a frame rarely change.
+    auto index = m_frame.index;
+    std::swap(m_lastFrame, m_frame);
+    m_frame.index = index + 1;
+    m_frame.milliseconds = 0.0;
+    m_frame.cpu.clear();
+    m_frame.gpu.clear();
+    m_frame.dropped = 0;
+}
+
+void profiling::Profiler::startCapture(uint32 frameCount) {
+    m_capture.clear();
+    m_captureFramesLeft = frameCount;
+}
+
+void profiling::Profiler::writeChromeTrace(std::string_view path) const {
+    std::ostringstream stream;
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    // Name the tracks, the first thread that records is usually the main thread.
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPU_THREAD_ID << ",\"args\":{\"name\":\"GPU\"}}";
+    {
+        std::lock_guard lock(m_threadsMutex);
+        for(const auto& thread : m_threads) {
+            stream << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->getThreadId()
+                << ",\"args\":{\"name\":\"Thread " << thread->getThreadId() << "\"}}";
+        }
+    }
+
+    // Complete events in microseconds relative to the first zone.
+    uint64 origin = ~uint64(0);
+    for(const auto& captured : m_capture) {
+        origin = std::min(origin, captured.event.start);
+    }
+    stream.precision(3);
+    stream << std::fixed;
+    for(const auto& captured : m_capture) {
+        stream << ",{\"name\":";
+        writeJsonString(stream, captured.event.name);
+        stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << captured.threadId
+            << ",\"ts\":" << static_cast<float64>(captured.event.start - origin) / 1e3
+            << ",\"dur\":" << static_cast<float64>(captured.event.end - captured.event.start) / 1e3 << '}';
+    }
+    stream << "]}\n";
+
+    auto writer = std::filesystem::exists(path) ? voxels::openForWriting(path) : voxels::createAndWrite(path);
+    writer.writeContent(stream.str());
+}
+
+profiling::ThreadBuffer& profiling::Profiler::registerThread() {
+    std::lock_guard lock(m_threadsMutex);
+    return *m_threads.emplace_back(std::make_unique<ThreadBuffer>(static_cast<uint32>(m_threads.size())));
+}
+
+void profiling::Profiler::accumulate(std::vector<ZoneStatistics>& statistics, const ZoneEvent& event) {
+    // Names are literals, so equal names usually share the pointer and the comparison rarely reaches strcmp.
+    auto zone = std::ranges::find_if(statistics, [&](const ZoneStatistics& zone) {
+        return zone.name == event.name || std::strcmp(zone.name, event.name) == 0;
+    });
+    if(zone == statistics.end())
+        zone = statistics.insert(zone, { event.name });
+    auto milliseconds = static_cast<float64>(event.end - event.start) / 1e6;
+    ++zone->calls;
+    zone->milliseconds += milliseconds;
+    zone->maxMilliseconds = std::max(zone->maxMilliseconds, milliseconds);
+}
+
+profiling::Profiler& profiling::getProfiler() {
+    static Profiler profiler;
+    return profiler;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file Renderer.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the source for the CPU ray marching renderer.
+ */
+
+#include "Renderer/Cpu/Renderer.hpp" // For declarations.
+#include "World/TerrainGenerator.hpp" // For the material colors.
+#include "common.hpp" // For glm::mix and glm::floor.
+#include "geometric.hpp" // For glm::normalize and glm::cross.
+#include <cmath> // For std::tan and std::ceil.
+#include <experimental/simd> // For stepping the lanes of a packet at once.
+#include <limits> // For the infinite distances.
+
+namespace {
+    namespace stdx = std::experimental;
+
+    constexpr float32 INFINITY_DISTANCE = std::numeric_limits<float32>::infinity();
+    constexpr auto SKY_COLOR = glm::vec3(0.55f, 0.7f, 0.9f);
+
+    /**
+     * @brief Returns the base color of the voxel.
+     */
+    [[nodiscard]] glm::vec3 getColor(world::Voxel voxel) noexcept {
+        switch(voxel) {
+        case world::Stone: return { 0.5f, 0.5f, 0.52f };
+        case world::Dirt: return { 0.45f, 0.3f, 0.18f };
+        case world::Grass: return { 0.3f, 0.6f, 0.2f };
+        default: return { 1.0f, 0.0f, 1.0f };
+        }
+    }
+
+    [[nodiscard]] inline uint32 packColor(glm::vec3 color) noexcept {
+        auto bytes = glm::uvec3(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return 0xFF000000u | bytes.z << 16 | bytes.y << 8 | bytes.x;
+    }
+
+    /// @brief A float of every lane of a packet in SIMD registers.
+    using FloatLanes = stdx::fixed_size_simd<float32, renderer::cpu::RayPacket::SIZE>;
+    /// @brief An int of every lane of a packet in SIMD registers.
+    using IntLanes = stdx::fixed_size_simd<int32, renderer::cpu::RayPacket::SIZE>;
+
+    template<typename T>
+    [[nodiscard]] inline stdx::fixed_size_simd<T, renderer::cpu::RayPacket::SIZE> load(const renderer::cpu::RayPacket::Lanes<T>& lanes) noexcept {
+        return { lanes.data(), stdx::element_aligned };
+    }
+
+    template<typename T>
+    inline void store(renderer::cpu::RayPacket::Lanes<T>& lanes, const stdx::fixed_size_simd<T, renderer::cpu::RayPacket::SIZE>& values) noexcept {
+        values.copy_to(lanes.data(), stdx::element_aligned);
+    }
+
+    /**
+     * @brief Converts a mask of float lanes into one of int lanes, the standard has no cast between masks of different types.
+     */
+    [[nodiscard]] inline IntLanes::mask_type toIntMask(const FloatLanes::mask_type& mask) noexcept {
+        auto selected = FloatLanes(0.0f);
+        stdx::where(mask, selected) = 1.0f;
+        return stdx::static_simd_cast<IntLanes>(selected) != 0;
+    }
+
+    /**
+     * @brief Steps every masked lane into the next voxel along the axis whose boundary is the closest.
+     *
+     * @note Branch free, the axis is picked with comparisons over all lanes and the updates are blended in by mask.
+     * Ties go to the later axis.
+     */
+    inline void stepVoxels(renderer::cpu::RayPacket& packet, const FloatLanes::mask_type& stepping) noexcept {
+        auto& p = packet;
+        auto tMaxX = load(p.tMaxX), tMaxY = load(p.tMaxY), tMaxZ = load(p.tMaxZ);
+        auto firstX = tMaxX < tMaxY && tMaxX < tMaxZ;
+        auto firstY = !firstX && tMaxY < tMaxZ;
+        auto alongX = stepping && firstX;
+        auto alongY = stepping && firstY;
+        auto alongZ = stepping && !firstX && !firstY;
+
+        auto distance = load(p.distance);
+        stdx::where(alongX, distance) = tMaxX;
+        stdx::where(alongY, distance) = tMaxY;
+        stdx::where(alongZ, distance) = tMaxZ;
+        store(p.distance, distance);
+
+        stdx::where(alongX, tMaxX) += load(p.tDeltaX);
+        stdx::where(alongY, tMaxY) += load(p.tDeltaY);
+        stdx::where(alongZ, tMaxZ) += load(p.tDeltaZ);
+        store(p.tMaxX, tMaxX);
+        store(p.tMaxY, tMaxY);
+        store(p.tMaxZ, tMaxZ);
+
+        auto intX = toIntMask(alongX), intY = toIntMask(alongY), intZ = toIntMask(alongZ);
+        auto voxelX = load(p.voxelX), voxelY = load(p.voxelY), voxelZ = load(p.voxelZ);
+        stdx::where(intX, voxelX) += load(p.stepX);
+        stdx::where(intY, voxelY) += load(p.stepY);
+        stdx::where(intZ, voxelZ) += load(p.stepZ);
+        store(p.voxelX, voxelX);
+        store(p.voxelY, voxelY);
+        store(p.voxelZ, voxelZ);
+
+        auto axis = load(p.axis);
+        stdx::where(intX, axis) = 0;
+        stdx::where(intY, axis) = 1;
+        stdx::where(intZ, axis) = 2;
+        store(p.axis, axis);
+    }
+
+    /**
+     * @brief Advances one axis of the lane by a number of voxels.
+     *
+     * @return float32 The distance at which the last of the boundaries was crossed.
+     */
+    inline float32 advanceAxis(int32& voxel, float32& tMax, int32 step, float32 tDelta, int32 count) noexcept {
+        // An axis the ray is parallel to crosses nothing, and 0 * infinity would make its boundary NaN.
+        if(count == 0)
+            return tMax;
+        voxel += step * count;
+        auto crossed = tMax + static_cast<float32>(count - 1) * tDelta;
+        tMax += static_cast<float32>(count) * tDelta;
+        return crossed;
+    }
+
+    /**
+     * @brief Moves the lane into the first voxel after the chunk it is in.
+     *
+     * @note The number of boundaries crossed along each axis is computed directly instead of stepping through the chunk.
+     * The axis that leaves the chunk first is advanced exactly, the others are clamped so they can not leave it earlier.
+     */
+    void skipChunk(renderer::cpu::RayPacket& packet, uint32 lane) noexcept {
+        auto& p = packet;
+        constexpr auto LENGTH = static_cast<int32>(CHUNK_LENGTH);
+        auto min = p.chunkCoordinate[lane] * LENGTH;
+
+        // The number of steps along each axis until the chunk is left.
+        auto stepsX = p.stepX[lane] > 0 ? min.x + LENGTH - p.voxelX[lane] : p.voxelX[lane] - min.x + 1;
+        auto stepsY = p.stepY[lane] > 0 ? min.y + LENGTH - p.voxelY[lane] : p.voxelY[lane] - min.y + 1;
+        auto stepsZ = p.stepZ[lane] > 0 ? min.z + LENGTH - p.voxelZ[lane] : p.voxelZ[lane] - min.z + 1;
+
+        auto getExit = [](float32 tMax, float32 tDelta, int32 steps) {
+            return steps == 1 ? tMax : tMax + static_cast<float32>(steps - 1) * tDelta;
+        };
+        auto exitX = getExit(p.tMaxX[lane], p.tDeltaX[lane], stepsX);
+        auto exitY = getExit(p.tMaxY[lane], p.tDeltaY[lane], stepsY);
+        auto exitZ = getExit(p.tMaxZ[lane], p.tDeltaZ[lane], stepsZ);
+        auto exit = std::min({ exitX, exitY, exitZ });
+
+        // The number of boundaries an axis crosses before the chunk is left.
+        auto getCrossings = [exit](float32 tMax, float32 tDelta, int32 steps) {
+            if(tMax >= exit)
+                return 0;
+            return std::min(static_cast<int32>(std::ceil((exit - tMax) / tDelta)), steps - 1);
+        };
+
+        if(exitX == exit) {
+            advanceAxis(p.voxelX[lane], p.tMaxX[lane], p.stepX[lane], p.tDeltaX[lane], stepsX);
+            advanceAxis(p.voxelY[lane], p.tMaxY[lane], p.stepY[lane], p.tDeltaY[lane], getCrossings(p.tMaxY[lane], p.tDeltaY[lane], stepsY));
+            advanceAxis(p.voxelZ[lane], p.tMaxZ[lane], p.stepZ[lane], p.tDeltaZ[lane], getCrossings(p.tMaxZ[lane], p.tDeltaZ[lane], stepsZ));
+            p.axis[lane] = 0;
+        } else if(exitY == exit) {
+            advanceAxis(p.voxelX[lane], p.tMaxX[lane], p.stepX[lane], p.tDeltaX[lane], getCrossings(p.tMaxX[lane], p.tDeltaX[lane], stepsX));
+            advanceAxis(p.voxelY[lane], p.tMaxY[lane], p.stepY[lane], p.tDeltaY[lane], stepsY);
+            advanceAxis(p.voxelZ[lane], p.tMaxZ[lane], p.stepZ[lane], p.tDeltaZ[lane], getCrossings(p.tMaxZ[lane], p.tDeltaZ[lane], stepsZ));
+            p.axis[lane] = 1;
+        } else {
+            advanceAxis(p.voxelX[lane], p.tMaxX[lane], p.stepX[lane], p.tDeltaX[lane], getCrossings(p.tMaxX[lane], p.tDeltaX[lane], stepsX));
+            advanceAxis(p.voxelY[lane], p.tMaxY[lane], p.stepY[lane], p.tDeltaY[lane], getCrossings(p.tMaxY[lane], p.tDeltaY[lane], stepsY));
+            advanceAxis(p.voxelZ[lane], p.tMaxZ[lane], p.stepZ[lane], p.tDeltaZ[lane], stepsZ);
+            p.axis[lane] = 2;
+        }
+        p.distance[lane] = exit;
+    }
+
+    /**
+     * @brief Sets up the traversal of one axis of a lane.
+     */
+    inline void setupAxis(float32 origin, float32 direction, int32& voxel, int32& step, float32& tMax, float32& tDelta) noexcept {
+        voxel = static_cast<int32>(std::floor(origin));
+        step = direction > 0.0f ? 1 : -1;
+        // An axis the ray is parallel to never has its boundary crossed.
+        tDelta = direction != 0.0f ? std::abs(1.0f / direction) : INFINITY_DISTANCE;
+        auto boundary = static_cast<float32>(voxel + (step > 0 ? 1 : 0));
+        tMax = direction != 0.0f ? (boundary - origin) / direction : INFINITY_DISTANCE;
+    }
+}
+
+renderer::cpu::Renderer::Renderer(const world::World& world, uint32 width, uint32 height, const RendererDescriptor& descriptor,
+    jobs::JobSystem& jobSystem)
+        : m_world(world)
+        , m_descriptor(descriptor)
+        , m_jobSystem(jobSystem)
+        , m_surface(width, height) {  }
+
+void renderer::cpu::Renderer::render(const voxels::CameraDescriptor& cameraDescriptor) {
+    auto [width, height] = m_surface.getViewportSize();
+    auto tilesX = (width + m_descriptor.tileSize - 1) / m_descriptor.tileSize;
+    auto tilesY = (height + m_descriptor.tileSize - 1) / m_descriptor.tileSize;
+
+    m_jobSystem.parallelFor(static_cast<size_t>(tilesX) * tilesY, 1, [&](size_t begin, size_t end) {
+        for(auto tile = begin; tile < end; ++tile) {
+            renderTile(cameraDescriptor, static_cast<uint32>(tile % tilesX), static_cast<uint32>(tile / tilesX));
+        }
+    });
+
+    m_surface.swapBuffers();
+}
+
+renderer::cpu::RayHit renderer::cpu::Renderer::traceRay(const world::World& world, glm::vec3 origin, glm::vec3 direction, float32 maxDistance) {
+    RayPacket packet {};
+    packet.originX[0] = origin.x;
+    packet.originY[0] = origin.y;
+    packet.originZ[0] = origin.z;
+    packet.directionX[0] = direction.x;
+    packet.directionY[0] = direction.y;
+    packet.directionZ[0] = direction.z;
+    packet.active[0] = true;
+
+    tracePacket(world, packet, maxDistance);
+
+    if(packet.voxel[0] == world::AIR)
+        return {};
+    return { true, packet.distance[0], packet.voxel[0], { packet.voxelX[0], packet.voxelY[0], packet.voxelZ[0] }, static_cast<uint8>(packet.axis[0]) };
+}
+
+void renderer::cpu::Renderer::tracePacket(const world::World& world, RayPacket& packet, float32 maxDistance) noexcept {
+    auto& p = packet;
+    for(uint32 lane = 0; lane < RayPacket::SIZE; ++lane) {
+        setupAxis(p.originX[lane], p.directionX[lane], p.voxelX[lane], p.stepX[lane], p.tMaxX[lane], p.tDeltaX[lane]);
+        setupAxis(p.originY[lane], p.directionY[lane], p.voxelY[lane], p.stepY[lane], p.tMaxY[lane], p.tDeltaY[lane]);
+        setupAxis(p.originZ[lane], p.directionZ[lane], p.voxelZ[lane], p.stepZ[lane], p.tMaxZ[lane], p.tDeltaZ[lane]);
+        p.distance[lane] = 0.0f;
+        p.axis[lane] = 1;
+        p.voxel[lane] = world::AIR;
+        p.chunk[lane] = nullptr;
+        // The cached coordinate can not match any voxel at first, so the chunk is looked up on the first step.
+        p.chunkCoordinate[lane] = glm::ivec3(std::numeric_limits<int32>::max());
+    }
+
+    while(true) {
+        // The chunk lookup and the voxel read are gathers, they go lane by lane.
+        RayPacket::Lanes<bool> stepping {};
+        for(uint32 lane = 0; lane < RayPacket::SIZE; ++lane) {
+            if(!p.active[lane])
+                continue;
+
+            auto position = glm::ivec3(p.voxelX[lane], p.voxelY[lane], p.voxelZ[lane]);
+            auto coordinate = world::toChunkCoordinate(position);
+            if(coordinate != p.chunkCoordinate[lane]) {
+                p.chunkCoordinate[lane] = coordinate;
+                p.chunk[lane] = world.getChunk(coordinate);
+            }
+
+            if(!p.chunk[lane] || p.chunk[lane]->isEmpty()) {
+                skipChunk(p, lane);
+            } else if(auto voxel = p.chunk[lane]->get(world::toLocalPosition(position)); voxel != world::AIR) {
+                p.voxel[lane] = voxel;
+                p.active[lane] = false;
+            } else {
+                stepping[lane] = true;
+            }
+        }
+
+        // Every lane that stays in its chunk steps at once.
+        stepVoxels(p, FloatLanes::mask_type(stepping.data(), stdx::element_aligned));
+
+        auto active = FloatLanes::mask_type(p.active.data(), stdx::element_aligned) && load(p.distance) <= maxDistance;
+        active.copy_to(p.active.data(), stdx::element_aligned);
+        if(stdx::none_of(active))
+            break;
+    }
+}
+
+void renderer::cpu::Renderer::renderTile(const voxels::CameraDescriptor& cameraDescriptor, uint32 tileX, uint32 tileY) noexcept {
+    auto [width, height] = m_surface.getViewportSize();
+    auto& pixels = m_surface.getBackBuffer();
+
+    // The camera basis, right and up are scaled so that they span the image plane at a distance of one.
+    auto forward = cameraDescriptor.direction;
+    auto right = glm::normalize(glm::cross(forward, voxels::CameraDescriptor::UP));
+    auto up = glm::cross(right, forward);
+    auto halfHeight = std::tan(cameraDescriptor.fieldOfView * 0.5f);
+    right *= halfHeight * static_cast<float32>(width) / static_cast<float32>(height);
+    up *= halfHeight;
+
+    auto minX = tileX * m_descriptor.tileSize, minY = tileY * m_descriptor.tileSize;
+    auto maxX = std::min(minX + m_descriptor.tileSize, width), maxY = std::min(minY + m_descriptor.tileSize, height);
+
+    RayPacket packet;
+    for(auto y = minY; y < maxY; ++y) {
+        for(auto x = minX; x < maxX; x += RayPacket::SIZE) {
+            auto ndcY = 1.0f - 2.0f * (static_cast<float32>(y) + 0.5f) / static_cast<float32>(height);
+            for(uint32 lane = 0; lane < RayPacket::SIZE; ++lane) {
+                auto ndcX = 2.0f * (static_cast<float32>(x + lane) + 0.5f) / static_cast<float32>(width) - 1.0f;
+                auto direction = glm::normalize(forward + right * ndcX + up * ndcY);
+                packet.originX[lane] = cameraDescriptor.position.x;
+                packet.originY[lane] = cameraDescriptor.position.y;
+                packet.originZ[lane] = cameraDescriptor.position.z;
+                packet.directionX[lane] = direction.x;
+                packet.directionY[lane] = direction.y;
+                packet.directionZ[lane] = direction.z;
+                packet.active[lane] = x + lane < maxX;
+            }
+
+            tracePacket(m_world, packet, m_descriptor.maxDistance);
+
+            for(uint32 lane = 0; lane < RayPacket::SIZE && x + lane < maxX; ++lane) {
+                auto color = SKY_COLOR;
+                if(packet.voxel[lane] != world::AIR) {
+                    // Light the faces by their axis and fade into the sky with the distance.
+                    constexpr float32 FACE_SHADES[] = { 0.8f, 1.0f, 0.65f };
+                    auto fog = glm::clamp(packet.distance[lane] / m_descriptor.maxDistance, 0.0f, 1.0f);
+                    color = glm::mix(getColor(packet.voxel[lane]) * FACE_SHADES[packet.axis[lane]], SKY_COLOR, fog * fog);
+                }
+                pixels[static_cast<size_t>(y) * width + x + lane] = packColor(color);
+            }
+        }
+    }
+}
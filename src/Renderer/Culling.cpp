@@ -0,0 +1,290 @@
+/**
+ * @file Culling.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the frustum and occlusion culling.
+ */
+
+#include "Renderer/Culling.hpp" // For declarations.
+#include "common.hpp" // For the absolute normals.
+#include "geometric.hpp" // For normalizing the planes.
+#include <algorithm> // For picking the closest occluders.
+#include <chrono> // For the timings.
+#include <cmath> // For rounding the rectangles.
+#include <limits> // For the initial depth range.
+
+namespace {
+    /// @brief The length of the square tiles of the depth buffer that store the farthest depth of their pixels.
+    constexpr int32 TILE_LENGTH = 8;
+
+    /**
+     * @brief Returns how many tiles cover the pixels.
+     */
+    [[nodiscard]] inline uint32 getTileCount(uint32 pixels) noexcept {
+        return (pixels + TILE_LENGTH - 1) / TILE_LENGTH;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    [[nodiscard]] inline float64 getMilliseconds(Clock::time_point begin, Clock::time_point end) noexcept {
+        return std::chrono::duration<float64, std::milli>(end - begin).count();
+    }
+
+    /**
+     * @brief Returns the signed doubled area of the triangle, positive if c is left of the edge from a to b.
+     */
+    [[nodiscard]] inline float32 getEdge(glm::vec2 a, glm::vec2 b, glm::vec2 c) noexcept {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    /**
+     * @brief Writes the convex hull of the points counter clockwise, with the monotone chain algorithm.
+     *
+     * @return size_t The number of points of the hull, below three if the points lie on a line.
+     */
+    [[nodiscard]] size_t getConvexHull(std::array<glm::vec2, 8> points, std::array<glm::vec2, 8>& hull) noexcept {
+        std::ranges::sort(points, [](glm::vec2 a, glm::vec2 b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+        // The lower chain from left to right and the upper one back, each drops the points that would turn clockwise.
+        std::array<glm::vec2, 16> chain;
+        size_t size = 0;
+        for(size_t i = 0; i < points.size(); ++i) {
+            while(size >= 2 && getEdge(chain[size - 2], chain[size - 1], points[i]) <= 0.0f)
+                --size;
+            chain[size++] = points[i];
+        }
+        for(auto i = points.size() - 1, lower = size + 1; i-- > 0;) {
+            while(size >= lower && getEdge(chain[size - 2], chain[size - 1], points[i]) <= 0.0f)
+                --size;
+            chain[size++] = points[i];
+        }
+        // The last point closes the chain on the first one.
+        auto count = std::min(size - 1, hull.size());
+        std::copy_n(chain.begin(), count, hull.begin());
+        return count;
+    }
+}
+
+renderer::Frustum renderer::Frustum::fromMatrix(const glm::mat4& projectionView) noexcept {
+    // glm is column major, so the rows are gathered across the columns.
+    auto row = [&](glm::length_t i) {
+        return glm::vec4(projectionView[0][i], projectionView[1][i], projectionView[2][i], projectionView[3][i]);
+    };
+    auto frustum = Frustum {{
+        row(3) + row(0), row(3) - row(0),
+        row(3) + row(1), row(3) - row(1),
+        row(3) + row(2), row(3) - row(2),
+    }};
+    for(auto& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+bool renderer::Frustum::intersects(const Aabb& box) const noexcept {
+    for(const auto& plane : planes) {
+        // The corner furthest along the normal, if it is outside the whole box is.
+        auto corner = glm::vec3(
+            plane.x > 0.0f ? box.max.x : box.min.x,
+            plane.y > 0.0f ? box.max.y : box.min.y,
+            plane.z > 0.0f ? box.max.z : box.min.z
+        );
+        if(glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+renderer::Culler::Culler(const CullingDescriptor& descriptor)
+    : m_descriptor(descriptor)
+    , m_depth(static_cast<size_t>(descriptor.depthWidth) * descriptor.depthHeight, 0.0f)
+    , m_tiles(static_cast<size_t>(getTileCount(descriptor.depthWidth)) * getTileCount(descriptor.depthHeight), 0.0f) {  }
+
+void renderer::Culler::cull(const glm::mat4& projectionView, std::span<const Aabb> boxes, std::span<const Aabb> occluders, std::vector<uint32>& visible) {
+    auto begin = Clock::now();
+    m_statistics = { .tested = boxes.size() };
+    visible.clear();
+
+    auto frustum = Frustum::fromMatrix(projectionView);
+    testFrustum(frustum, boxes, m_inFrustum);
+    m_statistics.frustumCulled = boxes.size() - m_inFrustum.size();
+    auto frustumEnd = Clock::now();
+    m_statistics.frustumMilliseconds = getMilliseconds(begin, frustumEnd);
+
+    if(!m_descriptor.occlusion || occluders.empty() || m_depth.empty()) {
+        visible.assign(m_inFrustum.begin(), m_inFrustum.end());
+        m_statistics.visible = visible.size();
+        return;
+    }
+
+    // The closest occluders hide the most, the distance of their centers to the near plane orders them.
+    testFrustum(frustum, occluders, m_occludersInFrustum);
+    auto near = frustum.planes[4];
+    m_occluderOrder.clear();
+    for(auto i : m_occludersInFrustum) {
+        auto center = (occluders[i].min + occluders[i].max) * 0.5f;
+        m_occluderOrder.emplace_back(glm::dot(glm::vec3(near), center) + near.w, i);
+    }
+    if(m_occluderOrder.size() > m_descriptor.maxOccluders) {
+        auto last = m_occluderOrder.begin() + static_cast<std::ptrdiff_t>(m_descriptor.maxOccluders);
+        std::ranges::nth_element(m_occluderOrder, last);
+        m_occluderOrder.erase(last, m_occluderOrder.end());
+    }
+
+    std::ranges::fill(m_depth, 0.0f);
+    for(auto [distance, i] : m_occluderOrder) {
+        rasterizeOccluder(projectionView, occluders[i]);
+    }
+    std::ranges::fill(m_tiles, std::numeric_limits<float32>::max());
+    for(uint32 y = 0; y < m_descriptor.depthHeight; ++y) {
+        for(uint32 x = 0; x < m_descriptor.depthWidth; ++x) {
+            auto& tile = m_tiles[static_cast<size_t>(y / TILE_LENGTH) * getTileCount(m_descriptor.depthWidth) + x / TILE_LENGTH];
+            tile = std::min(tile, m_depth[static_cast<size_t>(y) * m_descriptor.depthWidth + x]);
+        }
+    }
+    for(auto i : m_inFrustum) {
+        if(isOccluded(projectionView, boxes[i]))
+            ++m_statistics.occlusionCulled;
+        else
+            visible.push_back(i);
+    }
+    m_statistics.occluders = m_occluderOrder.size();
+    m_statistics.visible = visible.size();
+    m_statistics.occlusionMilliseconds = getMilliseconds(frustumEnd, Clock::now());
+}
+
+void renderer::Culler::testFrustum(const Frustum& frustum, std::span<const Aabb> boxes, std::vector<uint32>& inside) {
+    // The boxes are split into structure of arrays layout once, so every plane is a straight loop over them.
+    auto count = boxes.size();
+    for(auto* lanes : { &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ, &m_distance }) {
+        lanes->resize(count);
+    }
+    for(size_t i = 0; i < count; ++i) {
+        m_centerX[i] = (boxes[i].max.x + boxes[i].min.x) * 0.5f; m_extentX[i] = (boxes[i].max.x - boxes[i].min.x) * 0.5f;
+        m_centerY[i] = (boxes[i].max.y + boxes[i].min.y) * 0.5f; m_extentY[i] = (boxes[i].max.y - boxes[i].min.y) * 0.5f;
+        m_centerZ[i] = (boxes[i].max.z + boxes[i].min.z) * 0.5f; m_extentZ[i] = (boxes[i].max.z - boxes[i].min.z) * 0.5f;
+    }
+    std::ranges::fill(m_distance, std::numeric_limits<float32>::max());
+
+    // The signed distance of the corner furthest along the normal, the smallest over the planes decides.
+    // The extents projected onto the normal reach that corner without picking it per box.
+    for(const auto& plane : frustum.planes) {
+        auto absolute = glm::abs(glm::vec3(plane));
+        const auto* __restrict centerX = m_centerX.data();
+        const auto* __restrict centerY = m_centerY.data();
+        const auto* __restrict centerZ = m_centerZ.data();
+        const auto* __restrict extentX = m_extentX.data();
+        const auto* __restrict extentY = m_extentY.data();
+        const auto* __restrict extentZ = m_extentZ.data();
+        auto* __restrict distance = m_distance.data();
+        for(size_t i = 0; i < count; ++i) {
+            auto center = plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w;
+            auto radius = absolute.x * extentX[i] + absolute.y * extentY[i] + absolute.z * extentZ[i];
+            distance[i] = std::min(distance[i], center + radius);
+        }
+    }
+    // Every index is written and the end only advances past the ones inside, which avoids a mispredicted branch per box.
+    inside.resize(count);
+    size_t end = 0;
+    for(size_t i = 0; i < count; ++i) {
+        inside[end] = static_cast<uint32>(i);
+        end += m_distance[i] >= 0.0f;
+    }
+    inside.resize(end);
+}
+
+bool renderer::Culler::project(const glm::mat4& projectionView, const Aabb& box, std::array<glm::vec2, 8>& corners, ScreenBox& screen) const noexcept {
+    auto resolution = glm::vec2(m_descriptor.depthWidth, m_descriptor.depthHeight);
+    screen = { resolution.x, resolution.y, 0.0f, 0.0f, 0.0f, std::numeric_limits<float32>::max() };
+    // The projection is linear, so the corners are the projected minimum plus the projected edges.
+    auto origin = projectionView * glm::vec4(box.min, 1.0f);
+    auto size = box.max - box.min;
+    glm::vec4 edges[3] = { projectionView[0] * size.x, projectionView[1] * size.y, projectionView[2] * size.z };
+    for(uint32 i = 0; i < 8; ++i) {
+        auto clip = origin;
+        for(uint32 axis = 0; axis < 3; ++axis) {
+            if(i & (1u << axis))
+                clip += edges[axis];
+        }
+        if(clip.z < -clip.w)
+            return false;
+
+        auto inverseDepth = 1.0f / clip.w;
+        corners[i] = (glm::vec2(clip) * inverseDepth * 0.5f + 0.5f) * resolution;
+        screen.minX = std::min(screen.minX, corners[i].x);
+        screen.minY = std::min(screen.minY, corners[i].y);
+        screen.maxX = std::max(screen.maxX, corners[i].x);
+        screen.maxY = std::max(screen.maxY, corners[i].y);
+        screen.nearest = std::max(screen.nearest, inverseDepth);
+        screen.farthest = std::min(screen.farthest, inverseDepth);
+    }
+    return true;
+}
+
+void renderer::Culler::rasterizeOccluder(const glm::mat4& projectionView, const Aabb& box) noexcept {
+    std::array<glm::vec2, 8> corners;
+    ScreenBox screen;
+    if(!project(projectionView, box, corners, screen))
+        return;
+
+    // A box in front of the near plane projects onto the convex hull of its corners, rasterizing the hull covers the
+    // pixels on the edges between its faces too, which no single face covers completely.
+    std::array<glm::vec2, 8> hull;
+    auto hullSize = getConvexHull(corners, hull);
+    if(hullSize < 3)
+        return;
+
+    // Only pixels the hull covers completely are written, every edge is moved inwards by the most it can change across
+    // half a pixel, so a box behind the occluder can never be dropped because of a partially covered pixel.
+    std::array<float32, 8> insets;
+    for(size_t i = 0; i < hullSize; ++i) {
+        auto edge = hull[(i + 1) % hullSize] - hull[i];
+        insets[i] = 0.5f * (std::abs(edge.x) + std::abs(edge.y));
+    }
+
+    auto minX = std::max(static_cast<int32>(std::floor(screen.minX)), 0);
+    auto minY = std::max(static_cast<int32>(std::floor(screen.minY)), 0);
+    auto maxX = std::min(static_cast<int32>(std::ceil(screen.maxX)), static_cast<int32>(m_descriptor.depthWidth));
+    auto maxY = std::min(static_cast<int32>(std::ceil(screen.maxY)), static_cast<int32>(m_descriptor.depthHeight));
+    for(auto y = minY; y < maxY; ++y) {
+        for(auto x = minX; x < maxX; ++x) {
+            auto center = glm::vec2(x, y) + 0.5f;
+            auto covered = true;
+            for(size_t i = 0; i < hullSize && covered; ++i) {
+                covered = getEdge(hull[i], hull[(i + 1) % hullSize], center) >= insets[i];
+            }
+            if(!covered)
+                continue;
+            auto& depth = m_depth[static_cast<size_t>(y) * m_descriptor.depthWidth + x];
+            depth = std::max(depth, screen.farthest);
+        }
+    }
+}
+
+bool renderer::Culler::isOccluded(const glm::mat4& projectionView, const Aabb& box) const noexcept {
+    std::array<glm::vec2, 8> corners;
+    ScreenBox screen;
+    if(!project(projectionView, box, corners, screen))
+        return false;
+
+    auto minX = std::max(static_cast<int32>(std::floor(screen.minX)), 0);
+    auto minY = std::max(static_cast<int32>(std::floor(screen.minY)), 0);
+    auto maxX = std::min(static_cast<int32>(std::ceil(screen.maxX)), static_cast<int32>(m_descriptor.depthWidth));
+    auto maxY = std::min(static_cast<int32>(std::ceil(screen.maxY)), static_cast<int32>(m_descriptor.depthHeight));
+    if(minX >= maxX || minY >= maxY)
+        return false;
+
+    // Tiles whose farthest occluder is still in front of the box are skipped, the others are checked pixel by pixel.
+    for(auto tileY = minY / TILE_LENGTH; tileY * TILE_LENGTH < maxY; ++tileY) {
+        for(auto tileX = minX / TILE_LENGTH; tileX * TILE_LENGTH < maxX; ++tileX) {
+            if(m_tiles[static_cast<size_t>(tileY) * getTileCount(m_descriptor.depthWidth) + tileX] > screen.nearest)
+                continue;
+            for(auto y = std::max(minY, tileY * TILE_LENGTH); y < std::min(maxY, (tileY + 1) * TILE_LENGTH); ++y) {
+                for(auto x = std::max(minX, tileX * TILE_LENGTH); x < std::min(maxX, (tileX + 1) * TILE_LENGTH); ++x) {
+                    // A larger value is nearer, the pixel has to be covered by something strictly in front of the box.
+                    if(m_depth[static_cast<size_t>(y) * m_descriptor.depthWidth + x] <= screen.nearest)
+                        return false;
+                }
+            }
+        }
+    }
+    return true;
+}
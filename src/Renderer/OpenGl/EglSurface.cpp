@@ -0,0 +1,150 @@
+/**
+ * @file EglSurface.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the headless EGL surface.
+ */
+
+#include "Renderer/OpenGl/EglSurface.hpp" // For declarations.
+#include "Exception.hpp" // For exceptions.
+#include "Renderer/OpenGl/StateCache.hpp" // For forgetting the state of another context.
+#include <EGL/eglext.h> // For the surfaceless platform.
+#include <algorithm> // For std::max.
+#include <limits> // For waiting without a timeout.
+
+renderer::opengl::EglSurface::EglSurface(uint32 width, uint32 height)
+    : m_viewportSize(width, height)
+{
+    // Releases what was created so far, the destructor does not run for a throwing constructor.
+    auto fail = [&](const char* message) {
+        if(m_context != EGL_NO_CONTEXT)
+            eglDestroyContext(m_display, m_context);
+        if(m_pbuffer != EGL_NO_SURFACE)
+            eglDestroySurface(m_display, m_pbuffer);
+        if(m_display != EGL_NO_DISPLAY)
+            eglTerminate(m_display);
+        THROW_EXCEPTION(message);
+    };
+
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if(getPlatformDisplay)
+        m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if(m_display == EGL_NO_DISPLAY)
+        m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if(m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, nullptr, nullptr)) {
+        m_display = EGL_NO_DISPLAY;
+        fail("Could not initialize an EGL display.");
+    }
+
+    constexpr EGLint CONFIG_ATTRIBUTES[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_NONE };
+    constexpr EGLint CONTEXT_ATTRIBUTES[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE,
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if(!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(m_display, CONFIG_ATTRIBUTES, &config, 1, &configCount))
+        fail("Could not choose an EGL config.");
+    // The surfaceless platform may have no configs, the context then only draws into framebuffer objects.
+    if(configCount == 0)
+        config = EGL_NO_CONFIG_KHR;
+    m_context = eglCreateContext(m_display, config, EGL_NO_CONTEXT, CONTEXT_ATTRIBUTES);
+    if(m_context == EGL_NO_CONTEXT)
+        fail("Could not create an OpenGl 4.5 core context with EGL.");
+
+    // Without EGL_KHR_surfaceless_context the context needs a surface, it is never drawn to.
+    if(!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context)) {
+        constexpr EGLint PBUFFER_ATTRIBUTES[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        if(configCount > 0)
+            m_pbuffer = eglCreatePbufferSurface(m_display, config, PBUFFER_ATTRIBUTES);
+        if(m_pbuffer == EGL_NO_SURFACE || !eglMakeCurrent(m_display, m_pbuffer, m_pbuffer, m_context))
+            fail("Could not make the EGL context current.");
+    }
+    if(!gladLoadGL(reinterpret_cast<GLADloadfunc>(eglGetProcAddress)))
+        fail("Could not load GL.");
+
+    glCreateFramebuffers(1, &m_framebuffer);
+    glCreateRenderbuffers(1, &m_colorBuffer);
+    glCreateRenderbuffers(1, &m_depthBuffer);
+    allocateFramebuffer();
+    glNamedFramebufferRenderbuffer(m_framebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glNamedFramebufferRenderbuffer(m_framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    if(glCheckNamedFramebufferStatus(m_framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glDeleteRenderbuffers(1, &m_colorBuffer);
+        glDeleteRenderbuffers(1, &m_depthBuffer);
+        glDeleteFramebuffers(1, &m_framebuffer);
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        fail("The offscreen framebuffer is incomplete.");
+    }
+    unBind();
+}
+
+renderer::opengl::EglSurface::~EglSurface() noexcept {
+    bind();
+    for(auto fence : m_fences) {
+        if(fence)
+            glDeleteSync(fence);
+    }
+    glDeleteRenderbuffers(1, &m_colorBuffer);
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+    glDeleteFramebuffers(1, &m_framebuffer);
+    unBind();
+    getStateCache().invalidate();
+
+    eglDestroyContext(m_display, m_context);
+    if(m_pbuffer != EGL_NO_SURFACE)
+        eglDestroySurface(m_display, m_pbuffer);
+    eglTerminate(m_display);
+}
+
+void renderer::opengl::EglSurface::bind() const noexcept {
+    if(eglGetCurrentContext() != m_context || eglGetCurrentSurface(EGL_DRAW) != m_pbuffer)
+        eglMakeCurrent(m_display, m_pbuffer, m_pbuffer, m_context);
+    getStateCache().setContext(m_context);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+}
+
+void renderer::opengl::EglSurface::unBind() const noexcept {
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+void renderer::opengl::EglSurface::swapBuffers() {
+    // Like a swap chain of FRAMES_IN_FLIGHT images, the frame that would reuse the oldest one waits for it.
+    auto& fence = m_fences[m_frameCount % FRAMES_IN_FLIGHT];
+    if(fence) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    ++m_frameCount;
+}
+
+void renderer::opengl::EglSurface::setViewportSize(uint32 width, uint32 height) noexcept {
+    bind();
+    m_viewportSize = { width, height };
+    allocateFramebuffer();
+    unBind();
+}
+
+std::vector<uint8> renderer::opengl::EglSurface::readPixels() const {
+    auto [width, height] = m_viewportSize;
+    std::vector<uint8> pixels(size_t(width) * height * 4);
+    bind();
+    // The pixel pack buffer binding would turn the pointer into an offset.
+    getStateCache().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    unBind();
+    return pixels;
+}
+
+void renderer::opengl::EglSurface::allocateFramebuffer() noexcept {
+    // A renderbuffer can not be empty.
+    auto width = static_cast<GLsizei>(std::max(m_viewportSize.first, 1u));
+    auto height = static_cast<GLsizei>(std::max(m_viewportSize.second, 1u));
+    glNamedRenderbufferStorage(m_colorBuffer, GL_RGBA8, width, height);
+    glNamedRenderbufferStorage(m_depthBuffer, GL_DEPTH24_STENCIL8, width, height);
+    glViewport(0, 0, width, height);
+}
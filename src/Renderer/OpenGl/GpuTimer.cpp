@@ -0,0 +1,55 @@
+/**
+ * @file GpuTimer.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the GPU pass timer.
+ */
+
+#include "Renderer/OpenGl/GpuTimer.hpp" // For declarations.
+
+renderer::opengl::GpuTimer::~GpuTimer() noexcept {
+    for(const auto& pass : m_pending) {
+        glDeleteQueries(1, &pass.query);
+    }
+    if(!m_free.empty())
+        glDeleteQueries(static_cast<GLsizei>(m_free.size()), m_free.data());
+}
+
+void renderer::opengl::GpuTimer::begin(const char* name) {
+    if(m_pending.size() >= m_maxPassesInFlight)
+        return;
+
+    GLuint query;
+    if(m_free.empty()) {
+        glGenQueries(1, &query);
+    } else {
+        query = m_free.back();
+        m_free.pop_back();
+    }
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    m_pending.push_back({ query, name, profiling::now() });
+    m_active = true;
+}
+
+void renderer::opengl::GpuTimer::end() noexcept {
+    if(!m_active)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_active = false;
+}
+
+void renderer::opengl::GpuTimer::collect(profiling::Profiler& profiler) {
+    // The queries finish in order, the first one that is not available ends the search.
+    while(!m_pending.empty() && !(m_active && m_pending.size() == 1)) {
+        const auto& pass = m_pending.front();
+        GLint available = 0;
+        glGetQueryObjectiv(pass.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if(!available)
+            break;
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(pass.query, GL_QUERY_RESULT, &elapsed);
+        profiler.recordGpu({ pass.name, pass.submitted, pass.submitted + static_cast<uint64>(elapsed) });
+        m_free.push_back(pass.query);
+        m_pending.pop_front();
+    }
+}
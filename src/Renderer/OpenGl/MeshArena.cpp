@@ -0,0 +1,183 @@
+/**
+ * @file MeshArena.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the shared section mesh buffer.
+ */
+
+#include "Renderer/OpenGl/MeshArena.hpp" // For declarations.
+#include "PackedVertex.hpp" // For the vertex layout.
+#include "Renderer/OpenGl/StateCache.hpp" // For binding the vertex array.
+#include "World/Chunk.hpp" // For SECTION_LENGTH.
+#include <algorithm> // For finding the free ranges.
+#include <limits> // For the vertex index limit.
+
+namespace {
+    /// @brief How many meshes a single multi draw call draws at most, larger sets are split.
+    constexpr size_t MAX_DRAWS_PER_CALL = 16384;
+    /// @brief How many batches of commands the stream buffers hold, so the GPU can lag behind by a few frames.
+    constexpr size_t STREAMED_BATCHES = 4;
+    /// @brief The attribute location of the section origin, the packed vertex uses location 0.
+    constexpr GLuint ORIGIN_LOCATION = 1;
+}
+
+renderer::opengl::MeshArena::MeshArena(size_t vertexCapacity)
+    : m_vertices(std::make_unique<VertexBuffer>())
+    , m_origins(STREAMED_BATCHES * MAX_DRAWS_PER_CALL * sizeof(glm::ivec4))
+    , m_commands(STREAMED_BATCHES * MAX_DRAWS_PER_CALL * sizeof(DrawElementsIndirectCommand))
+    , m_vertexCapacity(std::max<size_t>(vertexCapacity, 4))
+{
+    glGenVertexArrays(1, &m_vertexArray);
+    if(m_vertexArray == 0) {
+        THROW_EXCEPTION("Could not create a vertex array.");
+    }
+    m_vertices->copyDataIntoBuffer(nullptr, m_vertexCapacity * sizeof(voxels::PackedVertex), GL_DYNAMIC_DRAW);
+    m_free.push_back({ 0, static_cast<uint32>(m_vertexCapacity) });
+    bindBuffers();
+}
+
+renderer::opengl::MeshArena::~MeshArena() noexcept {
+    getStateCache().onVertexArrayDeleted(m_vertexArray);
+    glDeleteVertexArrays(1, &m_vertexArray);
+}
+
+void renderer::opengl::MeshArena::upload(glm::ivec3 section, const voxels::PackedMesh& mesh, uint32 level) {
+    erase(section);
+    if(mesh.vertices.empty())
+        return;
+
+    auto count = static_cast<uint32>(mesh.vertices.size());
+    reserveQuads(count / 4);
+    auto allocation = allocate(count);
+    allocation.level = level;
+    m_vertices->copySubDataIntoBuffer(mesh.vertices.data(), allocation.first * sizeof(voxels::PackedVertex), count * sizeof(voxels::PackedVertex));
+    m_allocations.tryEmplace(section, allocation);
+}
+
+bool renderer::opengl::MeshArena::erase(glm::ivec3 section) {
+    auto allocation = m_allocations.find(section);
+    if(!allocation)
+        return false;
+    free(*allocation);
+    m_allocations.erase(section);
+    return true;
+}
+
+void renderer::opengl::MeshArena::draw(std::span<const glm::ivec3> sections) {
+    m_drawCount = 0;
+    m_submissionCount = 0;
+
+    getStateCache().bindVertexArray(m_vertexArray);
+    m_commands.bind();
+    for(size_t begin = 0; begin < sections.size(); begin += MAX_DRAWS_PER_CALL) {
+        m_commandScratch.clear();
+        m_originScratch.clear();
+        for(auto section : sections.subspan(begin, std::min(MAX_DRAWS_PER_CALL, sections.size() - begin))) {
+            auto allocation = m_allocations.find(section);
+            if(!allocation)
+                continue;
+            m_commandScratch.push_back({
+                .count = allocation->count / 4 * 6,
+                .instanceCount = 1,
+                .firstIndex = 0,
+                .baseVertex = static_cast<GLint>(allocation->first),
+                .baseInstance = static_cast<GLuint>(m_originScratch.size()),
+            });
+            m_originScratch.emplace_back(section * static_cast<int32>(world::SECTION_LENGTH), allocation->level);
+        }
+        if(m_commandScratch.empty())
+            continue;
+
+        // The base instances index the origins from the offset of this batch.
+        auto origins = m_origins.upload(m_originScratch.data(), m_originScratch.size() * sizeof(glm::ivec4), sizeof(glm::ivec4));
+        auto commands = m_commands.upload(m_commandScratch.data(), m_commandScratch.size() * sizeof(DrawElementsIndirectCommand), sizeof(GLuint));
+        m_origins.bind();
+        glVertexAttribIPointer(ORIGIN_LOCATION, 4, GL_INT, sizeof(glm::ivec4), reinterpret_cast<void*>(origins.offset));
+
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<void*>(commands.offset),
+            static_cast<GLsizei>(m_commandScratch.size()), sizeof(DrawElementsIndirectCommand));
+        m_drawCount += m_commandScratch.size();
+        ++m_submissionCount;
+    }
+    m_origins.fence();
+    m_commands.fence();
+}
+
+renderer::opengl::MeshArena::Allocation renderer::opengl::MeshArena::allocate(uint32 count) {
+    for(;;) {
+        auto range = std::ranges::find_if(m_free, [&](const Allocation& range) { return range.count >= count; });
+        if(range != m_free.end()) {
+            auto allocation = Allocation { range->first, count };
+            range->first += count;
+            range->count -= count;
+            if(range->count == 0)
+                m_free.erase(range);
+            m_vertexCount += count;
+            return allocation;
+        }
+        grow(std::max(m_vertexCapacity * 2, m_vertexCapacity + count));
+    }
+}
+
+void renderer::opengl::MeshArena::free(Allocation allocation) {
+    m_vertexCount -= allocation.count;
+    auto next = std::ranges::lower_bound(m_free, allocation.first, {}, &Allocation::first);
+    if(next != m_free.end() && allocation.first + allocation.count == next->first) {
+        allocation.count += next->count;
+        next = m_free.erase(next);
+    }
+    if(next != m_free.begin()) {
+        auto previous = next - 1;
+        if(previous->first + previous->count == allocation.first) {
+            previous->count += allocation.count;
+            return;
+        }
+    }
+    m_free.insert(next, allocation);
+}
+
+void renderer::opengl::MeshArena::grow(size_t vertexCapacity) {
+    if(vertexCapacity > std::numeric_limits<GLint>::max()) {
+        THROW_EXCEPTION("The mesh arena can not address that many vertices.");
+    }
+
+    auto vertices = std::make_unique<VertexBuffer>();
+    vertices->copyDataIntoBuffer(nullptr, vertexCapacity * sizeof(voxels::PackedVertex), GL_DYNAMIC_DRAW);
+    auto size = static_cast<GLsizeiptr>(m_vertexCapacity * sizeof(voxels::PackedVertex));
+    if(StateCache::hasDirectStateAccess()) {
+        glCopyNamedBufferSubData(m_vertices->getId(), vertices->getId(), 0, 0, size);
+    } else {
+        getStateCache().bindBuffer(GL_COPY_READ_BUFFER, m_vertices->getId());
+        getStateCache().bindBuffer(GL_COPY_WRITE_BUFFER, vertices->getId());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+    }
+
+    // The new space extends the last free range if it ends at the old capacity.
+    auto added = Allocation { static_cast<uint32>(m_vertexCapacity), static_cast<uint32>(vertexCapacity - m_vertexCapacity) };
+    if(!m_free.empty() && m_free.back().first + m_free.back().count == added.first)
+        m_free.back().count += added.count;
+    else
+        m_free.push_back(added);
+
+    m_vertices = std::move(vertices);
+    m_vertexCapacity = vertexCapacity;
+    bindBuffers();
+}
+
+void renderer::opengl::MeshArena::reserveQuads(uint32 quadCount) {
+    if(quadCount <= m_quadCapacity)
+        return;
+    m_quadCapacity = std::max(quadCount, m_quadCapacity * 2);
+    auto indices = voxels::getQuadIndices(m_quadCapacity);
+    // The vertex array keeps referring to the index buffer, only its storage is replaced.
+    m_indices.copyDataIntoBuffer(indices.data(), indices.size() * sizeof(uint32));
+}
+
+void renderer::opengl::MeshArena::bindBuffers() const noexcept {
+    getStateCache().bindVertexArray(m_vertexArray);
+    m_vertices->bind();
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(voxels::PackedVertex), nullptr);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(ORIGIN_LOCATION);
+    glVertexAttribDivisor(ORIGIN_LOCATION, 1);
+    m_indices.bind();
+}
@@ -7,6 +7,9 @@
 #include "Renderer/OpenGl/Pipeline.hpp" // For declarations.
 #include "Renderer/CompilationException.hpp" // For INFO_LOG_BUFFER_SIZE.
 #include "Renderer/LinkingException.hpp" // For exceptions.
+#include <algorithm> // For std::max.
+#include <string> // For the uniform names.
+#include <utility> // For std::move.
 
 renderer::opengl::Pipeline renderer::opengl::Pipeline::linkShaders(Shader vertexShader, Shader fragmentShader) {
     auto program = glCreateProgram();
@@ -33,5 +36,33 @@ renderer::opengl::Pipeline renderer::opengl::Pipeline::linkShaders(Shader vertex
         THROW_LINK_EXCEPTION(infoLog);
     }
 
-    return renderer::opengl::Pipeline(program, vertexShader, fragmentShader); 
-}
\ No newline at end of file
+    return renderer::opengl::Pipeline(program, std::move(vertexShader), std::move(fragmentShader));
+}
+
+std::vector<renderer::opengl::Pipeline::UniformLocation> renderer::opengl::Pipeline::findUniformLocations(GLuint programId) {
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<UniformLocation> uniforms;
+    std::string name(static_cast<size_t>(std::max(maxLength, 1)), '\0');
+    for(GLint i = 0; i < count; ++i) {
+        // The members of uniform blocks have no location, they are set through their buffer.
+        auto index = static_cast<GLuint>(i);
+        GLint block;
+        glGetActiveUniformsiv(programId, 1, &index, GL_UNIFORM_BLOCK_INDEX, &block);
+        if(block != -1)
+            continue;
+
+        GLsizei length = 0;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(programId, index, static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+        auto view = std::string_view(name.data(), static_cast<size_t>(length));
+        // Arrays are reported as their first element, they are set by their plain name.
+        if(view.ends_with("[0]"))
+            view.remove_suffix(3);
+        uniforms.push_back({ hashUniformName(view), glGetUniformLocation(programId, name.data()) });
+    }
+    return uniforms;
+}
@@ -0,0 +1,368 @@
+/**
+ * @file PipelineCache.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the source for the PipelineCache class.
+ */
+
+#include "Renderer/OpenGl/PipelineCache.hpp" // For declarations.
+#include "Exception.hpp" // For exceptions.
+#include "Renderer/CompilationException.hpp" // For INFO_LOG_BUFFER_SIZE.
+#include "Renderer/LinkingException.hpp" // For exceptions.
+#include "Renderer/ShaderType.hpp" // For the shader types.
+#include <algorithm> // For std::find.
+#include <chrono> // For timing the wait.
+#include <cstdlib> // For std::getenv.
+#include <cstring> // For std::memcpy.
+#include <random> // For the temporary names.
+#include <thread> // For yielding while waiting.
+#include <utility> // For std::exchange.
+
+// glad was generated without the extension, the token is the same as the one of ARB_parallel_shader_compile.
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace {
+    /// @brief The first bytes of a program binary file, "VXPB".
+    constexpr uint32 BINARY_MAGIC = 0x42505856;
+    /// @brief The magic and the format of the binary precede it in the file.
+    constexpr size_t BINARY_HEADER_SIZE = 2 * sizeof(uint32);
+
+    /**
+     * @brief Returns a random suffix for a temporary file, so runs and caches writing the same binary never share one.
+     */
+    [[nodiscard]] std::string getTemporarySuffix() {
+        static std::random_device device;
+        static std::mt19937_64 engine(device());
+        return "." + std::to_string(engine()) + ".tmp";
+    }
+
+    /**
+     * @brief Continues a 64 bit FNV-1a hash with the bytes.
+     */
+    [[nodiscard]] uint64 hashBytes(uint64 hash, std::string_view bytes) noexcept {
+        for(auto byte : bytes) {
+            hash ^= static_cast<uint8>(byte);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Returns whether the future has its value, without waiting for it.
+     */
+    [[nodiscard]] bool isFinished(const std::future<std::string>& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /**
+     * @brief Opens the file for reading on the heap, readContent keeps a pointer to the reader until its future is ready.
+     */
+    [[nodiscard]] std::unique_ptr<voxels::FileReader> openReader(std::string_view path) {
+        // The reader can not be moved, so it is constructed in place from the returned value.
+        return std::unique_ptr<voxels::FileReader>(new voxels::FileReader(voxels::openForReading(path)));
+    }
+
+    /**
+     * @brief Returns whether the context supports the extension.
+     */
+    [[nodiscard]] bool hasExtension(std::string_view name) noexcept {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for(GLint i = 0; i < count; ++i) {
+            auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if(extension != nullptr && name == extension)
+                return true;
+        }
+        return false;
+    }
+}
+
+renderer::opengl::PipelineCache::PipelineCache(std::filesystem::path directory)
+    : m_directory(std::move(directory))
+    , m_parallelCompile(hasExtension("GL_KHR_parallel_shader_compile") || hasExtension("GL_ARB_parallel_shader_compile"))
+{
+    for(auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        if(auto string = glGetString(name))
+            m_driver += reinterpret_cast<const char*>(string);
+        m_driver += '\n';
+    }
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    m_binaryFormats.resize(static_cast<size_t>(formatCount));
+    if(formatCount > 0)
+        glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, m_binaryFormats.data());
+}
+
+renderer::opengl::PipelineCache::~PipelineCache() noexcept {
+    flush();
+    for(auto& entry : m_entries) {
+        // The jobs still reading write through the readers, they have to finish before the readers are freed.
+        for(auto* read : { &entry->vertexRead, &entry->fragmentRead, &entry->binaryRead }) {
+            if(read->valid())
+                read->wait();
+        }
+        if(entry->program != 0)
+            glDeleteProgram(entry->program);
+    }
+}
+
+renderer::opengl::PipelineId renderer::opengl::PipelineCache::request(std::string_view vertexPath, std::string_view fragmentPath) {
+    auto entry = std::make_unique<Entry>();
+    entry->vertexReader = openReader(vertexPath);
+    entry->fragmentReader = openReader(fragmentPath);
+    // Both files are opened before either is read, a missing one then leaves no job behind that reads into a freed reader.
+    entry->vertexRead = entry->vertexReader->readContent();
+    entry->fragmentRead = entry->fragmentReader->readContent();
+
+    m_entries.push_back(std::move(entry));
+    ++m_pending;
+    return m_entries.size() - 1;
+}
+
+void renderer::opengl::PipelineCache::update() {
+    if(isReady())
+        return;
+
+    // Everything that can be submitted is submitted before any status is queried, so the driver works on all of them at once.
+    for(auto& entry : m_entries) {
+        if(entry->stage == Stage::ReadingSources || entry->stage == Stage::ReadingBinary)
+            advanceReading(*entry);
+    }
+    for(auto& entry : m_entries) {
+        if(entry->stage != Stage::Compiling)
+            continue;
+        if(m_parallelCompile) {
+            GLint complete = GL_FALSE;
+            glGetProgramiv(entry->program, GL_COMPLETION_STATUS_KHR, &complete);
+            if(!complete)
+                continue;
+        }
+        finishCompile(*entry);
+    }
+}
+
+void renderer::opengl::PipelineCache::wait() {
+    auto start = std::chrono::steady_clock::now();
+    while(!isReady()) {
+        update();
+        if(!isReady())
+            std::this_thread::yield();
+    }
+    m_statistics.waitMilliseconds += std::chrono::duration<float64, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::filesystem::path renderer::opengl::PipelineCache::getDefaultDirectory() {
+    if(auto cache = std::getenv("XDG_CACHE_HOME"); cache != nullptr && *cache != '\0')
+        return std::filesystem::path(cache) / "voxels" / "pipelines";
+    if(auto home = std::getenv("HOME"); home != nullptr && *home != '\0')
+        return std::filesystem::path(home) / ".cache" / "voxels" / "pipelines";
+
+    std::error_code error;
+    auto temporary = std::filesystem::temp_directory_path(error);
+    return (error ? std::filesystem::path(".") : temporary) / "voxels" / "pipelines";
+}
+
+void renderer::opengl::PipelineCache::advanceReading(Entry& entry) {
+    if(entry.stage == Stage::ReadingSources) {
+        if(!isFinished(entry.vertexRead) || !isFinished(entry.fragmentRead))
+            return;
+        try {
+            entry.vertexSource = entry.vertexRead.get();
+            entry.fragmentSource = entry.fragmentRead.get();
+        } catch(...) {
+            fail(entry);
+            throw;
+        }
+        entry.vertexReader.reset();
+        entry.fragmentReader.reset();
+
+        // The length of the vertex source separates the sources, so moving text from one to the other changes the key.
+        auto vertexLength = static_cast<uint64>(entry.vertexSource.size());
+        entry.key = hashBytes(14695981039346656037ull, m_driver);
+        entry.key = hashBytes(entry.key, std::string_view(reinterpret_cast<const char*>(&vertexLength), sizeof(vertexLength)));
+        entry.key = hashBytes(entry.key, entry.vertexSource);
+        entry.key = hashBytes(entry.key, entry.fragmentSource);
+
+        std::error_code error;
+        auto path = getBinaryPath(entry.key);
+        if(hasProgramBinaries() && std::filesystem::exists(path, error)) {
+            try {
+                entry.binaryReader = openReader(path.string());
+                entry.binaryRead = entry.binaryReader->readContent();
+                entry.stage = Stage::ReadingBinary;
+                return;
+            } catch(const std::exception&) {
+                // The binary vanished or can not be read, it is compiled and written again.
+            }
+        }
+        submitCompile(entry);
+    } else if(entry.stage == Stage::ReadingBinary) {
+        if(!isFinished(entry.binaryRead))
+            return;
+        std::string binary;
+        try {
+            binary = entry.binaryRead.get();
+        } catch(const std::exception&) {
+            // An empty binary is rejected below.
+        }
+        entry.binaryReader.reset();
+
+        if(loadBinary(entry, binary)) {
+            ++m_statistics.loaded;
+            makeReady(entry);
+            return;
+        }
+        ++m_statistics.rejected;
+        submitCompile(entry);
+    }
+}
+
+bool renderer::opengl::PipelineCache::loadBinary(Entry& entry, std::string_view binary) {
+    if(binary.size() <= BINARY_HEADER_SIZE)
+        return false;
+    uint32 magic, format;
+    std::memcpy(&magic, binary.data(), sizeof(uint32));
+    std::memcpy(&format, binary.data() + sizeof(uint32), sizeof(uint32));
+    // A format the driver does not have would be an OpenGl error instead of a failed link.
+    if(magic != BINARY_MAGIC || std::find(m_binaryFormats.begin(), m_binaryFormats.end(), static_cast<GLint>(format)) == m_binaryFormats.end())
+        return false;
+
+    auto program = glCreateProgram();
+    if(program == 0)
+        return false;
+    binary.remove_prefix(BINARY_HEADER_SIZE);
+    glProgramBinary(program, static_cast<GLenum>(format), binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // The driver can reject a binary it wrote itself, after an update for example.
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if(!success) {
+        glDeleteProgram(program);
+        return false;
+    }
+    entry.program = program;
+    return true;
+}
+
+void renderer::opengl::PipelineCache::submitCompile(Entry& entry) {
+    try {
+        entry.vertexShader = Shader::submitFromSource(entry.vertexSource, ShaderType::Vertex);
+        entry.fragmentShader = Shader::submitFromSource(entry.fragmentSource, ShaderType::Fragment);
+    } catch(...) {
+        fail(entry);
+        throw;
+    }
+
+    entry.program = glCreateProgram();
+    if(entry.program == 0) {
+        fail(entry);
+        THROW_EXCEPTION("Could not create program.");
+    }
+    glAttachShader(entry.program, entry.vertexShader.get());
+    glAttachShader(entry.program, entry.fragmentShader.get());
+    // Without the hint the driver may not keep what glGetProgramBinary needs.
+    if(hasProgramBinaries())
+        glProgramParameteri(entry.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(entry.program);
+    entry.stage = Stage::Compiling;
+}
+
+void renderer::opengl::PipelineCache::finishCompile(Entry& entry) {
+    GLint success;
+    glGetProgramiv(entry.program, GL_LINK_STATUS, &success);
+    if(!success) {
+        char infoLog[INFO_LOG_BUFFER_SIZE];
+        glGetProgramInfoLog(entry.program, INFO_LOG_BUFFER_SIZE, nullptr, infoLog);
+        // A shader that did not compile fails the link too, its own log says more than the one of the program.
+        auto vertexShader = std::move(entry.vertexShader);
+        auto fragmentShader = std::move(entry.fragmentShader);
+        fail(entry);
+        vertexShader.checkCompileStatus(ShaderType::Vertex);
+        fragmentShader.checkCompileStatus(ShaderType::Fragment);
+        THROW_LINK_EXCEPTION(infoLog);
+    }
+
+    // The linked program does not need its shaders anymore.
+    glDetachShader(entry.program, entry.vertexShader.get());
+    glDetachShader(entry.program, entry.fragmentShader.get());
+    entry.vertexShader = Shader(0);
+    entry.fragmentShader = Shader(0);
+
+    if(hasProgramBinaries())
+        storeBinary(entry);
+    ++m_statistics.compiled;
+    makeReady(entry);
+}
+
+void renderer::opengl::PipelineCache::storeBinary(const Entry& entry) {
+    GLint length = 0;
+    glGetProgramiv(entry.program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0)
+        return;
+
+    std::string content(BINARY_HEADER_SIZE + static_cast<size_t>(length), '\0');
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(entry.program, length, &written, &format, content.data() + BINARY_HEADER_SIZE);
+    if(written <= 0)
+        return;
+    auto formatValue = static_cast<uint32>(format);
+    std::memcpy(content.data(), &BINARY_MAGIC, sizeof(uint32));
+    std::memcpy(content.data() + sizeof(uint32), &formatValue, sizeof(uint32));
+    content.resize(BINARY_HEADER_SIZE + static_cast<size_t>(written));
+
+    // Written next to its final name and renamed, so another run never reads half a binary.
+    auto path = getBinaryPath(entry.key);
+    auto temporary = path;
+    temporary += getTemporarySuffix();
+    jobs::getJobSystem().submit([this, path = std::move(path), temporary = std::move(temporary), content = std::move(content)] {
+        try {
+            std::filesystem::create_directories(m_directory);
+            {
+                auto writer = voxels::createAndWrite(temporary.string());
+                writer.writeContent(content);
+            }
+            std::filesystem::rename(temporary, path);
+            m_stored.fetch_add(1, std::memory_order_relaxed);
+        } catch(const std::exception&) {
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+        }
+    }, &m_writes);
+}
+
+void renderer::opengl::PipelineCache::flush() {
+    jobs::getJobSystem().wait(m_writes);
+}
+
+void renderer::opengl::PipelineCache::makeReady(Entry& entry) {
+    entry.pipeline = std::make_unique<Pipeline>(std::exchange(entry.program, 0));
+    entry.vertexSource = {};
+    entry.fragmentSource = {};
+    entry.stage = Stage::Ready;
+    --m_pending;
+}
+
+void renderer::opengl::PipelineCache::fail(Entry& entry) noexcept {
+    if(entry.program != 0) {
+        glDeleteProgram(entry.program);
+        entry.program = 0;
+    }
+    entry.vertexShader = Shader(0);
+    entry.fragmentShader = Shader(0);
+    entry.vertexSource = {};
+    entry.fragmentSource = {};
+    entry.stage = Stage::Failed;
+    --m_pending;
+}
+
+std::filesystem::path renderer::opengl::PipelineCache::getBinaryPath(uint64 key) const {
+    constexpr const char* DIGITS = "0123456789abcdef";
+    std::string name(16, '0');
+    for(size_t i = 0; i < name.size(); ++i) {
+        name[name.size() - 1 - i] = DIGITS[(key >> (4 * i)) & 0xF];
+    }
+    return m_directory / (name + ".bin");
+}
@@ -5,67 +5,52 @@
  */
 
 #include "Renderer/OpenGl/Renderer.hpp" // For declarations.
-#include "File.hpp"
 #include "Global.hpp"
+#include "Profiling/Profiler.hpp"
 #include "Renderer/OpenGl/Buffer.hpp"
+#include "Renderer/OpenGl/FrameUniforms.hpp"
 #include "Renderer/OpenGl/Pipeline.hpp"
+#include "Renderer/OpenGl/StateCache.hpp"
 #include "Renderer/OpenGl/Texture.hpp"
 #include "Renderer/OpenGl/VertexArray.hpp"
 #include "Renderer/OpenGl/VertexBufferAttributes.hpp"
-#include "Renderer/OpenGl/WindowVisitor.hpp"
-#include "Renderer/ShaderType.hpp"
 #include "Utilities/MeshLoading.hpp"
 #include "Vertex.hpp"
-#include <ctime>
+#include "World/Chunk.hpp"
+#include "World/Remesher.hpp" // For the updated meshes.
 #include <iostream>
-
-renderer::opengl::Renderer::Renderer(const wnd::IWindow& window)
-    : m_surface(window.acceptVisitor(renderer::opengl::WindowVisitor())) 
-{
-    m_surface->bind();
-    if(!gladLoaderLoadGL()) {
-        THROW_EXCEPTION("Could not load GL.");
+#include <utility>
+
+namespace {
+    /// @brief The far plane without levels of detail.
+    constexpr float32 MIN_FAR_PLANE = 1024.0f;
+
+    /**
+     * @brief Returns the world space bounds of the node, 2^level sections per axis from its minimum section.
+     */
+    [[nodiscard]] inline renderer::Aabb getSectionBounds(glm::ivec3 section, uint32 level) noexcept {
+        auto min = glm::vec3(section * static_cast<int32>(world::SECTION_LENGTH));
+        return { min, min + static_cast<float32>(world::SECTION_LENGTH << level) };
     }
 
-    std::cout << glGetString(GL_VERSION) << '\n';
-
-    m_surface->unBind();
-}
-
-void renderer::opengl::Renderer::render(const voxels::CameraDescriptor& cameraDescriptor) {
-    m_surface->bind();
-    static renderer::opengl::Pipeline basicPipeline = renderer::opengl::Pipeline::linkShaders(
-        renderer::opengl::Shader::compileFromSource(
-            voxels::openForReading("./assets/shaders/basic.vert").readContent().get(),
-            ShaderType::Vertex
-        ),
-        renderer::opengl::Shader::compileFromSource(
-            voxels::openForReading("./assets/shaders/basic.frag").readContent().get(),
-            ShaderType::Fragment
-        )
-    );
-    static renderer::opengl::Pipeline voxelPipeline = renderer::opengl::Pipeline::linkShaders(
-        renderer::opengl::Shader::compileFromSource(
-            voxels::openForReading("./assets/shaders/voxelMarcher.vert").readContent().get(),
-            ShaderType::Vertex
-        ),
-        renderer::opengl::Shader::compileFromSource(
-            voxels::openForReading("./assets/shaders/voxelMarcher.frag").readContent().get(),
-            ShaderType::Fragment
-        )
-    );
-    static renderer::opengl::VertexArray vertexArray = [] {
+    /**
+     * @brief Creates the vertex array of the cube mesh.
+     */
+    [[nodiscard]] std::unique_ptr<renderer::opengl::VertexArray> createCube() {
         auto attributes = renderer::opengl::VertexBufferAttributes(voxels::Vertex::getAttributes());
-        auto vertexArray = renderer::opengl::VertexArray(attributes);
+        auto vertexArray = std::make_unique<renderer::opengl::VertexArray>(attributes);
 
         auto mesh = voxels::loadMeshes("./assets/meshes/cube.obj")[0];
 
-        vertexArray.copyDataIntoVertexBuffer(reinterpret_cast<void*>(mesh.vertices.data()), sizeof(voxels::Vertex) * mesh.vertices.size());
-        vertexArray.copyDataIntoIndexBuffer(reinterpret_cast<void*>(mesh.indices.data()), sizeof(uint32) * mesh.indices.size());
+        vertexArray->copyDataIntoVertexBuffer(reinterpret_cast<void*>(mesh.vertices.data()), sizeof(voxels::Vertex) * mesh.vertices.size());
+        vertexArray->copyDataIntoIndexBuffer(reinterpret_cast<void*>(mesh.indices.data()), sizeof(uint32) * mesh.indices.size());
         return vertexArray;
-    }();
-    static auto texture = [] {
-        std::srand(time(nullptr));
+    }
+
+    /**
+     * @brief Creates the texture the voxel marcher samples, solid with a white border.
+     */
+    [[nodiscard]] renderer::opengl::Texture2dUint32 createCubeTexture() {
         static constexpr auto width = 32u, height = 32u;
         std::vector<uint32> data(width * height, 0x0);
         for(auto i = 0u; i < height; ++i) {
@@ -76,9 +61,82 @@ void renderer::opengl::Renderer::render(const voxels::CameraDescriptor& cameraDe
             data[i * width + 31]    = 0xFFFFFFFF;
         }
 
-        return Texture2dUint32::createTexture<TextureWrap::ClampToBorder, TextureFilter::Nearest>({{data.data(), width, height}});
-    }();
+        return renderer::opengl::Texture2dUint32::createTexture<renderer::TextureWrap::ClampToBorder, renderer::TextureFilter::Nearest>({{data.data(), width, height}});
+    }
+}
+
+renderer::opengl::Renderer::Renderer(std::shared_ptr<ISurface> surface)
+    : m_surface(std::move(surface)) 
+{
+    m_surface->bind();
+    std::cout << glGetString(GL_VERSION) << '\n';
+
+    m_meshArena = std::make_unique<MeshArena>();
+    // Compiled in the background while the first frames are drawn without them, or loaded from the program binaries of the last run.
+    m_pipelines = std::make_unique<PipelineCache>();
+    m_basicPipeline = m_pipelines->request("./assets/shaders/basic.vert", "./assets/shaders/basic.frag");
+    m_voxelPipeline = m_pipelines->request("./assets/shaders/voxelMarcher.vert", "./assets/shaders/voxelMarcher.frag");
+    m_worldPipeline = m_pipelines->request("./assets/shaders/voxel.vert", "./assets/shaders/voxel.frag");
+    // A few frames of uniforms, so writing the next frame never waits for the GPU to finish the previous one.
+    GLint alignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    m_uniformAlignment = static_cast<size_t>(alignment);
+    m_frameUniforms = std::make_unique<UniformStreamBuffer>(16 * 1024);
+    m_gpuTimer = std::make_unique<GpuTimer>();
+    // Created here and not on the first frame, the names belong to the context of this surface.
+    m_cube = createCube();
+    // The texture can not be moved, so it is constructed in place from the one createCubeTexture returns.
+    m_cubeTexture.reset(new Texture2dUint32(createCubeTexture()));
+
+    m_surface->unBind();
+}
+
+renderer::opengl::Renderer::~Renderer() noexcept {
+    // The members delete their OpenGl objects, which needs the context current.
+    m_surface->bind();
+    m_cubeTexture.reset();
+    m_cube.reset();
+    m_gpuTimer.reset();
+    m_frameUniforms.reset();
+    m_pipelines.reset();
+    m_meshArena.reset();
+    m_surface->unBind();
+}
 
+void renderer::opengl::Renderer::waitForPipelines() {
+    m_surface->bind();
+    m_pipelines->wait();
+    m_surface->unBind();
+}
+
+void renderer::opengl::Renderer::updateMeshes(const world::Remesher& remesher) {
+    m_maxScreenError = remesher.getDescriptor().maxScreenError;
+    if(remesher.getUpdatedSections().empty())
+        return;
+
+    PROFILE_SCOPE("upload");
+    m_surface->bind();
+    for(auto section : remesher.getUpdatedSections()) {
+        if(auto mesh = remesher.getMesh(section))
+            m_meshArena->upload(section, *mesh, remesher.getLevel(section));
+        else
+            m_meshArena->erase(section);
+
+        if(remesher.isSolid(section))
+            m_solidSections.tryEmplace(section).first = remesher.getLevel(section);
+        else
+            m_solidSections.erase(section);
+    }
+    m_surface->unBind();
+}
+
+void renderer::opengl::Renderer::render(const voxels::CameraDescriptor& cameraDescriptor) {
+    PROFILE_SCOPE("render");
+    m_surface->bind();
+    m_pipelines->update();
+    auto basicPipeline = m_pipelines->get(m_basicPipeline);
+    auto voxelPipeline = m_pipelines->get(m_voxelPipeline);
+    auto worldPipeline = m_pipelines->get(m_worldPipeline);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -88,46 +146,90 @@ void renderer::opengl::Renderer::render(const voxels::CameraDescriptor& cameraDe
     auto model = glm::mat4(1.0f);
     auto view = cameraDescriptor.constructViewMatrix();
     auto [width, height] = m_surface->getViewportSize();
+    // The coarse levels of detail reach as far as their cells stay below the screen error.
+    auto farPlane = std::max(MIN_FAR_PLANE, world::Remesher::getViewDistance(m_maxScreenError, cameraDescriptor.fieldOfView));
     auto perspective = glm::perspectiveFov(
         cameraDescriptor.fieldOfView, 
         static_cast<float>(width), 
         static_cast<float>(height), 
         0.1f, 
-        1024.0f
+        farPlane
     );
     auto mvp = perspective * view * model;
     auto projView = perspective * view;
 
-    basicPipeline.setUniform("model", model);
-    basicPipeline.setUniform("projectionView", projView);
+    // The camera goes into one uniform buffer that every pipeline reads.
+    auto frameUniforms = FrameUniforms { projView, glm::vec4(cameraDescriptor.position, 1.0f) };
+    auto frame = m_frameUniforms->upload(&frameUniforms, sizeof(FrameUniforms), m_uniformAlignment);
+    auto& state = getStateCache();
+    state.bindBufferRange(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, m_frameUniforms->getId(), static_cast<GLintptr>(frame.offset), sizeof(FrameUniforms));
+
+    if(basicPipeline)
+        basicPipeline->setUniform("model", model);
+    if(worldPipeline)
+        worldPipeline->setUniform("model", model);
+    if(voxelPipeline) {
+        voxelPipeline->setUniform("model", model);
+        voxelPipeline->setUniform("uTexture", 0);
+    }
 
-    voxelPipeline.setUniform("model", model);
-    voxelPipeline.setUniform("projectionView", projView);
-    voxelPipeline.setUniform("cameraWorldPos", cameraDescriptor.position);
-    voxelPipeline.setUniform("uTexture", 0);
+    state.setEnabled(GL_DEPTH_TEST, true);
+    glDepthFunc(GL_LESS);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-    
-    vertexArray.bind();
+    // Only the sections that survive the culling go into the multi draw call.
+    {
+        PROFILE_SCOPE("cull");
+        m_sections.clear();
+        m_sectionBounds.clear();
+        m_meshArena->forEachSection([&](glm::ivec3 section, uint32 level) {
+            m_sections.push_back(section);
+            m_sectionBounds.push_back(getSectionBounds(section, level));
+        });
+        m_occluderBounds.clear();
+        m_solidSections.forEach([&](glm::ivec3 section, uint32 level) { m_occluderBounds.push_back(getSectionBounds(section, level)); });
+        m_culler.cull(projView, m_sectionBounds, m_occluderBounds, m_visibleIndices);
+        m_visibleSections.clear();
+        for(auto i : m_visibleIndices) {
+            m_visibleSections.push_back(m_sections[i]);
+        }
+    }
 
-    glActiveTexture(GL_TEXTURE0);
-    texture.bind();
-    voxelPipeline.bind();
+    if(worldPipeline) {
+        PROFILE_GPU_SCOPE(*m_gpuTimer, "world");
+        worldPipeline->bind();
+        m_meshArena->draw(m_visibleSections);
+    }
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+    m_cube->bind();
+
+    if(voxelPipeline) {
+        m_cubeTexture->bindToUnit(0);
+        voxelPipeline->bind();
+
+        state.setEnabled(GL_DEPTH_TEST, true);
+        glDepthFunc(GL_LESS);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-    basicPipeline.bind();
+        PROFILE_GPU_SCOPE(*m_gpuTimer, "marcher");
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+    }
+
+    if(basicPipeline) {
+        basicPipeline->bind();
 
-    glDisable(GL_DEPTH_TEST);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        state.setEnabled(GL_DEPTH_TEST, false);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+        PROFILE_GPU_SCOPE(*m_gpuTimer, "wireframe");
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+    }
 
-    vertexArray.unBind();
-    basicPipeline.unBind();
+    m_frameUniforms->fence();
+    state.endFrame();
+#ifdef VOXELS_PROFILING
+    m_gpuTimer->collect(profiling::getProfiler());
+#endif
 
     m_surface->swapBuffers();
     
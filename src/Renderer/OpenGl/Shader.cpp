@@ -7,37 +7,45 @@
 #include "Renderer/OpenGl/Shader.hpp" // For declarations.
 #include "Renderer/CompilationException.hpp" // For exceptions.
 
-renderer::opengl::Shader renderer::opengl::Shader::compileFromSource(std::string_view src, ShaderType shaderType) {
-        auto openGlShaderType = [=] {
-            switch(shaderType) {
-                case ShaderType::Vertex: return GL_VERTEX_SHADER;
-                case ShaderType::Fragment: return GL_FRAGMENT_SHADER;
-                default: return 0;
-            }
-        }();
-
-        auto shader = glCreateShader(openGlShaderType);
-
-        if(shader == 0) {
-            THROW_EXCEPTION("Failed to create shader.");
+renderer::opengl::Shader renderer::opengl::Shader::submitFromSource(std::string_view src, ShaderType shaderType) {
+    auto openGlShaderType = [=] {
+        switch(shaderType) {
+            case ShaderType::Vertex: return GL_VERTEX_SHADER;
+            case ShaderType::Fragment: return GL_FRAGMENT_SHADER;
+            default: return 0;
         }
+    }();
 
-        // Set the shader source.
-        auto srcData = src.data();
-        glShaderSource(shader, 1, &srcData, nullptr);
-        // Compile the shader.
-        glCompileShader(shader);
-
-        // Check if the compilation was successful.
-        GLint success;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if(!success) {
-            char infoLog[INFO_LOG_BUFFER_SIZE];
-            glGetShaderInfoLog(shader, INFO_LOG_BUFFER_SIZE, nullptr, infoLog);
-            // Make sure to delete the shader if there was an error so that it doesn't leak.
-            glDeleteShader(shader);
-            THROW_COMP_EXCEPTION(shaderType, infoLog);
-        }
+    auto shader = glCreateShader(openGlShaderType);
+
+    if(shader == 0) {
+        THROW_EXCEPTION("Failed to create shader.");
+    }
+
+    // Set the shader source, the view does not have to be null terminated.
+    auto srcData = src.data();
+    auto srcLength = static_cast<GLint>(src.size());
+    glShaderSource(shader, 1, &srcData, &srcLength);
+    // Compile the shader.
+    glCompileShader(shader);
 
-        return renderer::opengl::Shader(shader);
-}
\ No newline at end of file
+    return renderer::opengl::Shader(shader);
+}
+
+void renderer::opengl::Shader::checkCompileStatus(ShaderType shaderType) const {
+    // Check if the compilation was successful.
+    GLint success;
+    glGetShaderiv(m_shader, GL_COMPILE_STATUS, &success);
+    if(!success) {
+        char infoLog[INFO_LOG_BUFFER_SIZE];
+        glGetShaderInfoLog(m_shader, INFO_LOG_BUFFER_SIZE, nullptr, infoLog);
+        THROW_COMP_EXCEPTION(shaderType, infoLog);
+    }
+}
+
+renderer::opengl::Shader renderer::opengl::Shader::compileFromSource(std::string_view src, ShaderType shaderType) {
+    // The shader deletes itself if the check throws, so it doesn't leak.
+    auto shader = submitFromSource(src, shaderType);
+    shader.checkCompileStatus(shaderType);
+    return shader;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file StateCache.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the OpenGl state cache.
+ */
+
+#include "Renderer/OpenGl/StateCache.hpp" // For declarations.
+#include <algorithm> // For finding the capabilities.
+
+void renderer::opengl::StateCache::bindTexture(GLuint unit, GLenum target, GLuint texture) noexcept {
+    if(unit < TEXTURE_UNIT_COUNT && !change(m_textures[unit], texture))
+        return;
+    if(unit >= TEXTURE_UNIT_COUNT)
+        ++m_statistics.issued;
+
+    if(hasDirectStateAccess()) {
+        glBindTextureUnit(unit, texture);
+        return;
+    }
+    if(m_activeTextureUnit != unit) {
+        m_activeTextureUnit = unit;
+        ++m_statistics.issued;
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    glBindTexture(target, texture);
+}
+
+void renderer::opengl::StateCache::setEnabled(GLenum capability, bool enabled) noexcept {
+    auto cached = std::ranges::find(m_capabilities, capability, &std::pair<GLenum, bool>::first);
+    if(cached != m_capabilities.end() && cached->second == enabled) {
+        ++m_statistics.skipped;
+        return;
+    }
+    if(cached == m_capabilities.end())
+        m_capabilities.emplace_back(capability, enabled);
+    else
+        cached->second = enabled;
+
+    ++m_statistics.issued;
+    if(enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void renderer::opengl::StateCache::onBufferDeleted(GLuint buffer) noexcept {
+    // The element array buffer of another vertex array is not unbound, so it is not known anymore either.
+    for(auto& bound : m_buffers) {
+        if(bound == buffer)
+            bound = UNKNOWN;
+    }
+}
+
+void renderer::opengl::StateCache::onVertexArrayDeleted(GLuint vertexArray) noexcept {
+    if(m_vertexArray == vertexArray) {
+        m_vertexArray = UNKNOWN;
+        m_buffers[ELEMENT_ARRAY_BUFFER_INDEX] = UNKNOWN;
+    }
+}
+
+void renderer::opengl::StateCache::onProgramDeleted(GLuint program) noexcept {
+    // A deleted program stays in use until another one is bound.
+    if(m_program == program)
+        m_program = UNKNOWN;
+}
+
+void renderer::opengl::StateCache::onTextureDeleted(GLuint texture) noexcept {
+    for(auto& bound : m_textures) {
+        if(bound == texture)
+            bound = UNKNOWN;
+    }
+}
+
+void renderer::opengl::StateCache::invalidate() noexcept {
+    m_context = nullptr;
+    m_program = UNKNOWN;
+    m_vertexArray = UNKNOWN;
+    m_buffers.fill(UNKNOWN);
+    m_textures.fill(UNKNOWN);
+    m_activeTextureUnit = UNKNOWN;
+    m_capabilities.clear();
+}
+
+renderer::opengl::StateCache& renderer::opengl::getStateCache() noexcept {
+    thread_local StateCache cache;
+    return cache;
+}
@@ -41,5 +41,11 @@ std::unique_ptr<renderer::ISurface> renderer::opengl::WindowVisitor::visit(const
 
     auto ctx = glad_glXCreateNewContext(display, *fbConfig, GLX_RGBA_TYPE, nullptr, GL_TRUE);
 
-    return std::make_unique<renderer::opengl::X11Surface>(display, window.getWindowId(), ctx);
+    auto surface = std::make_unique<renderer::opengl::X11Surface>(display, window.getWindowId(), ctx);
+    surface->bind();
+    if(!gladLoaderLoadGL()) {
+        THROW_EXCEPTION("Could not load GL.");
+    }
+    surface->unBind();
+    return surface;
 }
\ No newline at end of file
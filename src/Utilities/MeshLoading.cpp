@@ -0,0 +1,52 @@
+/**
+ * @file MeshLoading.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the mesh loading, the only user of the obj loader.
+ */
+
+#include "Utilities/MeshLoading.hpp" // For declarations.
+#include "Exception.hpp" // For exceptions.
+#include "OBJ_Loader.h" // For parsing obj files, its functions are not inline so only this file may include it.
+#include <algorithm> // For transforming the meshes.
+#include <iterator> // For std::back_inserter.
+#include <sstream> // For the error messages.
+
+std::vector<voxels::Mesh> voxels::loadMeshes(const std::filesystem::path& path) {
+    if(!std::filesystem::exists(path)) {
+        std::stringstream sstream;
+        sstream << path << " does not exist.";
+        THROW_EXCEPTION(sstream.str());
+    }
+
+    if(path.filename().extension().compare(".obj") == 0) {
+        objl::Loader loader;
+
+        auto result = loader.LoadFile(path.c_str());
+        if(!result) {
+            THROW_EXCEPTION("Failed to load .obj file.");
+        }
+
+        std::vector<Mesh> meshes;
+        meshes.reserve(loader.LoadedMeshes.size());
+
+        std::ranges::transform(loader.LoadedMeshes, std::back_inserter(meshes), [](const objl::Mesh& mesh) {
+            std::vector<Vertex> vertices;
+            vertices.reserve(mesh.Vertices.size());
+
+            std::ranges::transform(mesh.Vertices, std::back_inserter(vertices), [](const objl::Vertex& vertex) {
+                return Vertex {
+                    {vertex.Position.X, vertex.Position.Y, vertex.Position.Z},
+                    {vertex.TextureCoordinate.X, vertex.TextureCoordinate.Y}
+                };
+            });
+
+            return Mesh { std::move(vertices), std::move(mesh.Indices) };
+        });
+        
+        return meshes;
+    } else {
+        std::stringstream sstream;
+        sstream << path.filename().extension() << " format is not supported.";
+        THROW_EXCEPTION(sstream.str());
+    }
+}
@@ -14,6 +14,7 @@
 #include "Window/Event/ResizeEvent.hpp" // Resize event
 #include "Window/Event/ScrollEvent.hpp" // Scroll event
 #include "Window/Event/CloseRequestedEvent.hpp" // Close requested event
+#include "Window/Event/FocusEvent.hpp" // Focus event
 
 
 std::unique_ptr<wnd::IEvent> wnd::x11::EventTranslator::translateEvent(const XEvent& event) const noexcept {
@@ -55,6 +56,12 @@ std::unique_ptr<wnd::IEvent> wnd::x11::EventTranslator::translateEvent(const XEv
             auto key = XLookupKeysym(const_cast<XKeyEvent*>(&event.xkey), 0);
             return std::make_unique<wnd::KeyboardEvent>(static_cast<wnd::Key>(key), wnd::ButtonState::Released);
         }
+        case FocusIn: {
+            return std::make_unique<wnd::FocusEvent>(true);
+        }
+        case FocusOut: {
+            return std::make_unique<wnd::FocusEvent>(false);
+        }
         case ClientMessage: {
             // This if statement checks if the user has requested to close the window.
             if(event.xclient.data.l[0] == m_deleteWindowProtocol)
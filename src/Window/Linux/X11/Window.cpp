@@ -12,6 +12,7 @@
 #include <X11/Xlib.h> // For X11.
 #include <X11/Xutil.h> // X11 utility.
 #include <chrono> // Required for the delta time calculations.
+#include <sys/select.h> // For waiting on the display connection.
 
 
 wnd::x11::Window::Window(std::string_view title, uint32 width, uint32 height, std::unique_ptr<wnd::IEventTranslator<XEvent>>&& eventTranslator)
@@ -29,7 +30,8 @@ wnd::x11::Window::Window(std::string_view title, uint32 width, uint32 height, st
     winAttributes.event_mask = ExposureMask
         | KeyPressMask | KeyReleaseMask 
         | ButtonPressMask | ButtonReleaseMask
-        | PointerMotionMask;
+        | PointerMotionMask
+        | FocusChangeMask;
     // Create the window.
     m_x11WindowId = XCreateWindow(
         m_x11Display,
@@ -109,6 +111,21 @@ void wnd::x11::Window::runLoop(const OnLoopIterationCallback& callback) {
     }
 }
 
+void wnd::x11::Window::waitForEvents(float64 timeout) noexcept {
+    // Flush the outgoing requests, the server will not answer before it receives them.
+    if(XPending(m_x11Display) > 0)
+        return;
+
+    // Sleep until the display connection becomes readable or the timeout expires.
+    auto fileDescriptor = ConnectionNumber(m_x11Display);
+    fd_set descriptors;
+    FD_ZERO(&descriptors);
+    FD_SET(fileDescriptor, &descriptors);
+    auto microseconds = static_cast<int64>(timeout * 1'000'000.0);
+    timeval time { microseconds / 1'000'000, microseconds % 1'000'000 };
+    select(fileDescriptor + 1, &descriptors, nullptr, nullptr, &time);
+}
+
 void wnd::x11::Window::updateVisibility() noexcept {
     // If the window is visible, raise it, if not, lower it.
     if(m_visible) {
@@ -1,5 +1,8 @@
 #include "Window/WindowManager.hpp"
 
+#include <algorithm> // For std::min.
+#include <thread> // For sleeping between frames.
+
 wnd::WindowManager::WindowManager(std::unique_ptr<IWindow>&& window) noexcept
     : m_window(std::move(window))
     , m_eventParser(std::make_unique<EventParser>())
@@ -10,31 +13,74 @@ wnd::WindowManager::WindowManager(std::unique_ptr<IWindow>&& window) noexcept
         }
     ) {  }
 
-void wnd::WindowManager::runLoop(const LoopCallback& callback) {
-    m_window->runLoop([this, &callback](std::vector<std::unique_ptr<IEvent>>& event, float64 deltaTime) {
+void wnd::WindowManager::runLoop(const LoopCallback& update, const FrameCallback& render, const LoopSettings& settings) {
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<float64>;
 
-        // Setup the loop descriptor.
-        auto loopDescriptor = wnd::LoopDescriptor {
-            false,
-            deltaTime,
-            *m_eventParser
-        };
+    float64 accumulator = 0.0;
+    auto lastInput = Clock::now();
+
+    m_window->runLoop([&](std::vector<std::unique_ptr<IEvent>>& event, float64 deltaTime) {
+        auto frameStart = Clock::now();
+        bool shouldClose = false;
 
         // Parse the event if there is one.
         for(const auto& event : event) {
             m_eventParser->parseEvent(*event);
         }
+        if(m_eventParser->hasInput())
+            lastInput = frameStart;
 
-        // Call the callback.
-        callback(loopDescriptor); 
+        // Step the simulation, never by more than the step limit so a long frame can not snowball.
+        accumulator += std::min(deltaTime, settings.fixedTimeStep * settings.maxStepsPerFrame);
+        while(accumulator >= settings.fixedTimeStep) {
+            auto loopDescriptor = wnd::LoopDescriptor {
+                false,
+                settings.fixedTimeStep,
+                *m_eventParser
+            };
+            update(loopDescriptor);
+            shouldClose |= loopDescriptor.shouldClose;
 
-        // Update the input parser.
-        m_eventParser->onLoopEnded();
+            // Update the input parser, the remaining steps only see the held state.
+            m_eventParser->onLoopEnded();
+            accumulator -= settings.fixedTimeStep;
+        }
+
+        // Draw the frame.
+        auto frameDescriptor = wnd::FrameDescriptor {
+            false,
+            deltaTime,
+            accumulator / settings.fixedTimeStep,
+            *m_eventParser
+        };
+        render(frameDescriptor);
+        shouldClose |= frameDescriptor.shouldClose;
 
         // Close the window if it should be closed.
-        if(loopDescriptor.shouldClose) {
+        if(shouldClose) {
             m_window->close();
+            return;
         }
 
+        // Pace the frames, an idle window waits for events so input still wakes it up immediately.
+        bool idle = !m_eventParser->isFocused() || Seconds(frameStart - lastInput).count() > settings.idleAfter;
+        if(idle && settings.idleFrameRate > 0.0) {
+            auto remaining = 1.0 / settings.idleFrameRate - Seconds(Clock::now() - frameStart).count();
+            if(remaining > 0.0)
+                m_window->waitForEvents(remaining);
+        } else if(settings.maxFrameRate > 0.0) {
+            sleepUntil(frameStart + std::chrono::duration_cast<Clock::duration>(Seconds(1.0 / settings.maxFrameRate)));
+        }
     });
-}
\ No newline at end of file
+}
+
+void wnd::WindowManager::sleepUntil(std::chrono::steady_clock::time_point time) noexcept {
+    constexpr auto SPIN_TIME = std::chrono::milliseconds(1);
+
+    if(time - std::chrono::steady_clock::now() > SPIN_TIME)
+        std::this_thread::sleep_until(time - SPIN_TIME);
+    while(std::chrono::steady_clock::now() < time) {
+        std::this_thread::yield();
+    }
+}
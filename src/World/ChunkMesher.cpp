@@ -0,0 +1,302 @@
+/**
+ * @file ChunkMesher.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the greedy section mesher.
+ */
+
+#include "World/ChunkMesher.hpp" // For declarations.
+#include <algorithm> // For std::ranges::find_if.
+#include <array> // For counting the materials of a cell.
+#include <utility> // For the material counts.
+
+namespace {
+    /**
+     * @brief Returns the ambient occlusion of a corner of a face.
+     */
+    [[nodiscard]] constexpr uint32 getCorner(uint8 occlusion, uint32 corner) noexcept {
+        return (occlusion >> (2 * corner)) & 0b11;
+    }
+
+    /**
+     * @brief Returns whether the voxel outside the chunk lies behind one of the faces whose neighbours count as air.
+     *
+     * @param local The local coordinates of the voxel, components below zero wrapped around.
+     * @param skirts One bit per normal index, the axis times two plus one for the negative end.
+     */
+    [[nodiscard]] constexpr bool isSkirt(glm::uvec3 local, uint8 skirts) noexcept {
+        for(uint32 axis = 0; axis < 3; ++axis) {
+            if(local[axis] == CHUNK_LENGTH && (skirts >> (axis * 2)) & 1)
+                return true;
+            if(local[axis] > CHUNK_LENGTH && (skirts >> (axis * 2 + 1)) & 1)
+                return true;
+        }
+        return false;
+    }
+}
+
+world::ChunkMesher::ChunkMesher()
+    : m_voxels(static_cast<size_t>(PADDED_LENGTH) * PADDED_LENGTH * PADDED_LENGTH, AIR)
+    , m_mask(static_cast<size_t>(SECTION_LENGTH) * SECTION_LENGTH, 0) {  }
+
+std::vector<world::MaterialMesh> world::ChunkMesher::mesh(const World& world, const Chunk& chunk, glm::uvec3 section) {
+    std::vector<MaterialMesh> meshes;
+    if(chunk.isEmpty()) {
+        m_solid = false;
+        return meshes;
+    }
+
+    gatherVoxels(chunk, section, 0, [&](glm::ivec3 position) { return world.getVoxel(position); });
+    forEachQuad(false, [&](const Quad& quad) {
+        auto mesh = std::ranges::find_if(meshes, [&](const MaterialMesh& mesh) { return mesh.material == quad.material; });
+        if(mesh == meshes.end()) {
+            meshes.push_back({ quad.material, {} });
+            mesh = meshes.end() - 1;
+        }
+        auto& vertices = mesh->mesh.vertices;
+        auto& indices = mesh->mesh.indices;
+
+        auto u = (quad.axis + 1) % 3, v = (quad.axis + 2) % 3;
+        glm::vec3 corner(0.0f), du(0.0f), dv(0.0f);
+        corner[quad.axis] = static_cast<float32>(quad.slice);
+        corner[u] = static_cast<float32>(quad.i);
+        corner[v] = static_cast<float32>(quad.j);
+        du[u] = static_cast<float32>(quad.width);
+        dv[v] = static_cast<float32>(quad.height);
+
+        // u x v points along the positive axis, so this order is counter clockwise seen from the positive side.
+        auto base = static_cast<uint32>(vertices.size());
+        vertices.push_back({ corner, { 0.0f, 0.0f } });
+        vertices.push_back({ corner + du, { static_cast<float32>(quad.width), 0.0f } });
+        vertices.push_back({ corner + du + dv, { static_cast<float32>(quad.width), static_cast<float32>(quad.height) } });
+        vertices.push_back({ corner + dv, { 0.0f, static_cast<float32>(quad.height) } });
+        if(quad.positive) {
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        } else {
+            indices.insert(indices.end(), { base, base + 2, base + 1, base, base + 3, base + 2 });
+        }
+    });
+    return meshes;
+}
+
+voxels::PackedMesh world::ChunkMesher::meshPacked(const World& world, const Chunk& chunk, glm::uvec3 section, uint8 skirts) {
+    if(chunk.isEmpty()) {
+        m_solid = false;
+        return {};
+    }
+
+    gatherVoxels(chunk, section, skirts, [&](glm::ivec3 position) { return world.getVoxel(position); });
+    return packQuads();
+}
+
+voxels::PackedMesh world::ChunkMesher::meshPacked(const ChunkNeighbourhood& neighbourhood, glm::uvec3 section, uint8 skirts) {
+    const auto* chunk = neighbourhood.getChunk();
+    if(!chunk || chunk->isEmpty()) {
+        m_solid = false;
+        return {};
+    }
+
+    gatherVoxels(*chunk, section, skirts, [&](glm::ivec3 position) { return neighbourhood.getVoxel(position); });
+    return packQuads();
+}
+
+voxels::PackedMesh world::ChunkMesher::meshPackedLevel(const Chunk& chunk, glm::uvec3 node, uint32 level) {
+    if(chunk.isEmpty()) {
+        m_solid = false;
+        return {};
+    }
+
+    gatherCells(chunk, node, level);
+    return packQuads();
+}
+
+voxels::PackedMesh world::ChunkMesher::packQuads() {
+    voxels::PackedMesh mesh;
+    forEachQuad(true, [&](const Quad& quad) {
+        auto u = (quad.axis + 1) % 3, v = (quad.axis + 2) % 3;
+        glm::uvec3 corner(0), du(0), dv(0);
+        corner[quad.axis] = quad.slice;
+        corner[u] = quad.i;
+        corner[v] = quad.j;
+        du[u] = quad.width;
+        dv[v] = quad.height;
+
+        auto normal = quad.axis * 2 + (quad.positive ? 0 : 1);
+        auto occlusion = [&](uint32 vertex) { return getCorner(quad.occlusion, vertex); };
+        glm::uvec3 corners[4] = { corner, corner + du, corner + du + dv, corner + dv };
+
+        // The vertices are ordered so that the shared quad indices always form counter clockwise triangles, starting at
+        // a corner of the diagonal whose corners are more alike, so the occlusion is interpolated without a crease.
+        uint32 first = occlusion(0) + occlusion(2) < occlusion(1) + occlusion(3) ? 1 : 0;
+        for(uint32 vertex = 0; vertex < 4; ++vertex) {
+            auto index = quad.positive ? (first + vertex) % 4 : (first + 4 - vertex) % 4;
+            mesh.vertices.push_back(voxels::PackedVertex::pack(corners[index], normal, occlusion(index), quad.material));
+        }
+    });
+    return mesh;
+}
+
+template<typename F>
+void world::ChunkMesher::gatherVoxels(const Chunk& chunk, glm::uvec3 section, uint8 skirts, F&& getOutside) {
+    auto min = section * SECTION_LENGTH;
+    auto chunkOrigin = chunk.getCoordinate() * static_cast<int32>(CHUNK_LENGTH);
+
+    m_solid = true;
+    for(uint32 x = 0; x < PADDED_LENGTH; ++x) {
+        for(uint32 y = 0; y < PADDED_LENGTH; ++y) {
+            for(uint32 z = 0; z < PADDED_LENGTH; ++z) {
+                // The padded coordinates are shifted by one, so the local coordinates of the border wrap around below zero.
+                auto local = min + glm::uvec3(x, y, z) - 1u;
+                bool inChunk = local.x < CHUNK_LENGTH && local.y < CHUNK_LENGTH && local.z < CHUNK_LENGTH;
+                auto voxel = inChunk
+                    ? chunk.get(local)
+                    : isSkirt(local, skirts) ? AIR : getOutside(chunkOrigin + glm::ivec3(min) + glm::ivec3(x, y, z) - 1);
+                m_voxels[getPaddedIndex(x, y, z)] = voxel;
+
+                // The border belongs to the neighbours, the coordinates wrap around below one.
+                bool inSection = x - 1 < SECTION_LENGTH && y - 1 < SECTION_LENGTH && z - 1 < SECTION_LENGTH;
+                m_solid &= voxel != AIR || !inSection;
+            }
+        }
+    }
+}
+
+void world::ChunkMesher::gatherCells(const Chunk& chunk, glm::uvec3 node, uint32 level) {
+    auto length = 1u << level;
+    auto min = node * (SECTION_LENGTH << level);
+
+    m_solid = true;
+    for(uint32 x = 0; x < PADDED_LENGTH; ++x) {
+        for(uint32 y = 0; y < PADDED_LENGTH; ++y) {
+            for(uint32 z = 0; z < PADDED_LENGTH; ++z) {
+                // The border cells outside the chunk stay air, which closes the node with skirts.
+                auto local = min + (glm::uvec3(x, y, z) - 1u) * length;
+                bool inChunk = local.x < CHUNK_LENGTH && local.y < CHUNK_LENGTH && local.z < CHUNK_LENGTH;
+                bool inNode = x - 1 < SECTION_LENGTH && y - 1 < SECTION_LENGTH && z - 1 < SECTION_LENGTH;
+                m_voxels[getPaddedIndex(x, y, z)] = inChunk ? getRepresentative(chunk, local, length, inNode) : AIR;
+            }
+        }
+    }
+}
+
+world::Voxel world::ChunkMesher::getRepresentative(const Chunk& chunk, glm::uvec3 min, uint32 length, bool inNode) {
+    // A uniform chunk has no palette to look into.
+    if(chunk.getVoxels().getBitsPerVoxel() == 0) {
+        auto voxel = chunk.get(min);
+        m_solid &= voxel != AIR || !inNode;
+        return voxel;
+    }
+
+    // A cell rarely holds more than a few materials, the ones beyond the last slot are not counted.
+    std::array<std::pair<Voxel, uint32>, 8> materials;
+    size_t materialCount = 0;
+    uint32 air = 0;
+    for(uint32 x = 0; x < length; ++x) {
+        for(uint32 y = 0; y < length; ++y) {
+            for(uint32 z = 0; z < length; ++z) {
+                auto voxel = chunk.get(min + glm::uvec3(x, y, z));
+                if(voxel == AIR) {
+                    ++air;
+                    continue;
+                }
+                auto material = std::find_if(materials.begin(), materials.begin() + materialCount, [&](const auto& entry) { return entry.first == voxel; });
+                if(material != materials.begin() + materialCount)
+                    ++material->second;
+                else if(materialCount < materials.size())
+                    materials[materialCount++] = { voxel, 1 };
+            }
+        }
+    }
+
+    m_solid &= air == 0 || !inNode;
+    if(air * 2 > length * length * length || materialCount == 0)
+        return AIR;
+    return std::max_element(materials.begin(), materials.begin() + materialCount, [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+}
+
+template<typename F>
+void world::ChunkMesher::forEachQuad(bool occlusion, F&& emit) {
+    // The distance between neighbouring voxels along each axis in the padded buffer.
+    constexpr size_t STRIDES[] = { PADDED_LENGTH * PADDED_LENGTH, PADDED_LENGTH, 1 };
+
+    for(uint32 axis = 0; axis < 3; ++axis) {
+        auto u = (axis + 1) % 3, v = (axis + 2) % 3;
+        // A slice is the plane between the voxel layers slice - 1 and slice, the border layers are only read.
+        for(uint32 slice = 0; slice <= SECTION_LENGTH; ++slice) {
+            for(bool positive : { true, false }) {
+                // A positive face belongs to the solid voxel behind the plane, a negative one to the voxel in front of it.
+                if(positive ? slice == 0 : slice == SECTION_LENGTH)
+                    continue;
+
+                bool anyFace = false;
+                for(uint32 j = 0; j < SECTION_LENGTH; ++j) {
+                    auto back = slice * STRIDES[axis] + (j + 1) * STRIDES[v] + STRIDES[u];
+                    for(uint32 i = 0; i < SECTION_LENGTH; ++i, back += STRIDES[u]) {
+                        auto solid = positive ? back : back + STRIDES[axis];
+                        auto other = positive ? back + STRIDES[axis] : back;
+                        uint64 face = 0;
+                        if(m_voxels[solid] != AIR && m_voxels[other] == AIR) {
+                            face = m_voxels[solid];
+                            if(occlusion)
+                                face |= static_cast<uint64>(getOcclusion(other, STRIDES[u], STRIDES[v])) << 32;
+                        }
+
+                        m_mask[j * SECTION_LENGTH + i] = face;
+                        anyFace |= face != 0;
+                    }
+                }
+                if(!anyFace)
+                    continue;
+
+                // Merge the faces, grow along u first and then along v for as long as whole rows match.
+                for(uint32 j = 0; j < SECTION_LENGTH; ++j) {
+                    for(uint32 i = 0; i < SECTION_LENGTH;) {
+                        auto face = m_mask[j * SECTION_LENGTH + i];
+                        if(face == 0) {
+                            ++i;
+                            continue;
+                        }
+
+                        // A face may only be stretched along an axis its occlusion does not change along,
+                        // otherwise the interpolated shading would be stretched as well.
+                        auto faceOcclusion = static_cast<uint8>(face >> 32);
+                        bool growU = getCorner(faceOcclusion, 0) == getCorner(faceOcclusion, 1) && getCorner(faceOcclusion, 3) == getCorner(faceOcclusion, 2);
+                        bool growV = getCorner(faceOcclusion, 0) == getCorner(faceOcclusion, 3) && getCorner(faceOcclusion, 1) == getCorner(faceOcclusion, 2);
+                        uint32 width = 1;
+                        while(growU && i + width < SECTION_LENGTH && m_mask[j * SECTION_LENGTH + i + width] == face) {
+                            ++width;
+                        }
+                        uint32 height = 1;
+                        for(; growV && j + height < SECTION_LENGTH; ++height) {
+                            auto row = m_mask.begin() + (j + height) * SECTION_LENGTH + i;
+                            if(!std::all_of(row, row + width, [face](uint64 other) { return other == face; }))
+                                break;
+                        }
+                        for(uint32 row = 0; row < height; ++row) {
+                            std::fill_n(m_mask.begin() + (j + row) * SECTION_LENGTH + i, width, 0);
+                        }
+
+                        emit(Quad { axis, slice, positive, i, j, width, height, static_cast<Voxel>(face), faceOcclusion });
+                        i += width;
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint8 world::ChunkMesher::getOcclusion(size_t front, size_t uStride, size_t vStride) const noexcept {
+    auto isSolid = [&](size_t index) -> uint32 { return m_voxels[index] != AIR; };
+
+    uint8 occlusion = 0;
+    // The corners in vertex order, ( -u, -v ), ( +u, -v ), ( +u, +v ) and ( -u, +v ).
+    constexpr int32 SIGNS[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+    for(uint32 corner = 0; corner < 4; ++corner) {
+        auto uOffset = SIGNS[corner][0] * static_cast<int64>(uStride);
+        auto vOffset = SIGNS[corner][1] * static_cast<int64>(vStride);
+        auto side1 = isSolid(front + uOffset), side2 = isSolid(front + vOffset), diagonal = isSolid(front + uOffset + vOffset);
+        // Two solid sides hide the corner completely, whatever the diagonal is.
+        auto value = side1 && side2 ? 0 : 3 - (side1 + side2 + diagonal);
+        occlusion |= value << (2 * corner);
+    }
+    return occlusion;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file ChunkStreamer.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the background chunk streaming.
+ */
+
+#include "World/ChunkStreamer.hpp" // For declarations.
+#include "Profiling/Profiler.hpp" // For the zones.
+#include "common.hpp" // For glm::floor.
+#include "geometric.hpp" // For distances.
+#include <algorithm> // For sorting the requests.
+#include <cmath> // For std::isfinite.
+#include <limits> // For an unlimited load count.
+
+namespace {
+    /**
+     * @brief Returns the squared distance between two chunk coordinates in chunks.
+     */
+    [[nodiscard]] int32 getDistanceSquared(glm::ivec3 a, glm::ivec3 b) noexcept {
+        auto delta = a - b;
+        return delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+    }
+}
+
+world::ChunkStreamer::ChunkStreamer(World& world, Generator&& generator, const StreamingDescriptor& descriptor, jobs::JobSystem& jobSystem)
+    : m_world(world)
+    , m_jobSystem(jobSystem)
+    , m_generator(std::move(generator))
+    , m_descriptor(descriptor) {  }
+
+world::ChunkStreamer::~ChunkStreamer() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_jobSystem.wait(m_jobs);
+}
+
+void world::ChunkStreamer::update(const voxels::CameraDescriptor& camera) {
+    PROFILE_SCOPE("stream");
+    auto cameraChunk = toChunkCoordinate(glm::ivec3(glm::floor(camera.position)));
+    auto unloadRadiusSquared = m_descriptor.unloadRadius * m_descriptor.unloadRadius;
+
+    // Take over the finished chunks.
+    std::vector<std::unique_ptr<Chunk>> completed;
+    {
+        std::lock_guard lock(m_mutex);
+        completed.swap(m_completed);
+        for(const auto& chunk : completed) {
+            m_generating.erase(chunk->getCoordinate());
+        }
+    }
+    for(auto& chunk : completed) {
+        // The camera may have moved away while the chunk was generated.
+        if(getDistanceSquared(chunk->getCoordinate(), cameraChunk) > unloadRadiusSquared)
+            continue;
+        m_world.insertChunk(std::move(chunk));
+        ++m_loadedCount;
+    }
+    completed.clear();
+
+    // Unload the chunks that are out of range, then the least important ones until the budget is met.
+    struct Loaded {
+        glm::ivec3 coordinate;
+        float32 priority;
+        size_t memory;
+    };
+    std::vector<Loaded> loaded;
+    loaded.reserve(m_world.getChunkCount());
+    size_t memory = 0;
+    m_world.forEachChunk([&](const Chunk& chunk) {
+        if(getDistanceSquared(chunk.getCoordinate(), cameraChunk) > unloadRadiusSquared) {
+            loaded.push_back({ chunk.getCoordinate(), std::numeric_limits<float32>::infinity(), 0 });
+            return;
+        }
+        loaded.push_back({ chunk.getCoordinate(), getPriority(chunk.getCoordinate(), camera), chunk.getMemoryUsage() });
+        memory += loaded.back().memory;
+    });
+    std::ranges::sort(loaded, [](const Loaded& a, const Loaded& b) { return a.priority > b.priority; });
+    size_t keptCount = loaded.size();
+    for(const auto& chunk : loaded) {
+        if(std::isfinite(chunk.priority) && memory <= m_descriptor.memoryBudget)
+            break;
+        memory -= chunk.memory;
+        m_world.unloadChunk(chunk.coordinate);
+        --keptCount;
+        ++m_unloadedCount;
+    }
+
+    // Only queue as many chunks as are expected to fit into the remaining budget.
+    auto loadLimit = std::numeric_limits<size_t>::max();
+    if(keptCount > 0) {
+        auto averageMemory = std::max<size_t>(memory / keptCount, 1);
+        loadLimit = memory < m_descriptor.memoryBudget ? (m_descriptor.memoryBudget - memory) / averageMemory : 0;
+    }
+
+    std::vector<Request> requests;
+    auto radius = m_descriptor.loadRadius;
+    for(int32 x = -radius; x <= radius; ++x) {
+        for(int32 y = -radius; y <= radius; ++y) {
+            for(int32 z = -radius; z <= radius; ++z) {
+                auto coordinate = cameraChunk + glm::ivec3(x, y, z);
+                if(x * x + y * y + z * z > radius * radius || m_world.isLoaded(coordinate))
+                    continue;
+                requests.push_back({ coordinate, getPriority(coordinate, camera) });
+            }
+        }
+    }
+    std::ranges::sort(requests, [](const Request& a, const Request& b) { return a.priority < b.priority; });
+
+    size_t jobCount = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.clear();
+        for(const auto& request : requests) {
+            if(m_queue.size() + m_generating.size() >= loadLimit)
+                break;
+            if(!m_generating.find(request.coordinate))
+                m_queue.push_back(request);
+        }
+        // The jobs pop from the back.
+        std::ranges::reverse(m_queue);
+
+        auto maxJobs = m_descriptor.maxJobs ? m_descriptor.maxJobs : std::max(m_jobSystem.getWorkerCount(), 1u);
+        jobCount = std::min<size_t>(m_queue.size(), maxJobs - std::min(m_activeJobs, maxJobs));
+        m_activeJobs += jobCount;
+    }
+    for(size_t i = 0; i < jobCount; ++i) {
+        m_jobSystem.submit([this] { generateNext(); }, &m_jobs);
+    }
+}
+
+size_t world::ChunkStreamer::getPendingCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_queue.size() + m_generating.size();
+}
+
+float32 world::ChunkStreamer::getPriority(glm::ivec3 coordinate, const voxels::CameraDescriptor& camera) noexcept {
+    auto center = (glm::vec3(coordinate) + 0.5f) * static_cast<float32>(CHUNK_LENGTH);
+    auto offset = center - camera.position;
+    auto distance = glm::length(offset);
+    if(distance < 1.0f)
+        return 0.0f;
+    auto facing = glm::dot(offset / distance, camera.direction);
+    return distance / static_cast<float32>(CHUNK_LENGTH) * (2.0f - facing);
+}
+
+void world::ChunkStreamer::generateNext() {
+    PROFILE_SCOPE("generate");
+    Request request;
+    {
+        std::lock_guard lock(m_mutex);
+        if(m_stopping || m_queue.empty()) {
+            --m_activeJobs;
+            return;
+        }
+        request = m_queue.back();
+        m_queue.pop_back();
+        m_generating.tryEmplace(request.coordinate, true);
+    }
+
+    auto chunk = std::make_unique<Chunk>(request.coordinate);
+    m_generator(*chunk);
+
+    std::lock_guard lock(m_mutex);
+    m_completed.push_back(std::move(chunk));
+    --m_activeJobs;
+}
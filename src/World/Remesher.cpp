@@ -0,0 +1,292 @@
+/**
+ * @file Remesher.cpp
+ * @author WeaponizedSchizophrenia
+ * @brief This file contains the implementation of the incremental section remeshing.
+ */
+
+#include "World/Remesher.hpp" // For declarations.
+#include "Profiling/Profiler.hpp" // For the zones.
+#include "World/ChunkMesher.hpp" // For meshing the sections.
+#include "common.hpp" // For clamping the camera into the chunks.
+#include "exponential.hpp" // For the level from the cell size.
+#include "geometric.hpp" // For distances.
+#include <algorithm> // For picking the closest sections.
+#include <cmath> // For the field of view.
+#include <optional> // For the coarser node.
+#include <vector> // For the sections of an update.
+
+namespace {
+    /// @brief The directions towards the six neighbours of a chunk in normal index order.
+    constexpr glm::ivec3 NEIGHBOURS[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+    [[nodiscard]] inline glm::ivec3 getChunkOfSection(glm::ivec3 section) noexcept {
+        return world::toChunkCoordinate(section * static_cast<int32>(world::SECTION_LENGTH));
+    }
+}
+
+world::Remesher::Remesher(World& world, const RemeshingDescriptor& descriptor, jobs::JobSystem& jobSystem)
+    : m_world(world)
+    , m_jobSystem(jobSystem)
+    , m_descriptor(descriptor) {  }
+
+world::Remesher::~Remesher() {
+    m_jobSystem.wait(m_jobs);
+}
+
+void world::Remesher::update(const voxels::CameraDescriptor& camera) {
+    PROFILE_SCOPE("remesh");
+    m_updated.clear();
+    updateLevels(camera);
+    for(auto section : m_world.takeDirtySections()) {
+        m_pending.tryEmplace(section, true);
+    }
+
+    // A batch is swapped in once every job of it is done, until then the frame goes on with the old meshes.
+    if(!m_work.empty()) {
+        if(!m_jobs.isDone())
+            return;
+        applyWork();
+    }
+    submitWork(camera);
+}
+
+void world::Remesher::wait() {
+    m_jobSystem.wait(m_jobs);
+}
+
+void world::Remesher::submitWork(const voxels::CameraDescriptor& camera) {
+    // The dirty sections of a coarse chunk share their nodes, every node is meshed once.
+    ChunkMap<bool> nodes;
+    m_pending.forEach([&](glm::ivec3 section, bool) {
+        auto level = getChunkLevel(getChunkOfSection(section));
+        auto node = getNode(section, level);
+        if(!nodes.tryEmplace(node, true).second)
+            return;
+        auto offset = (glm::vec3(node) + 0.5f * static_cast<float32>(1u << level)) * static_cast<float32>(SECTION_LENGTH) - camera.position;
+        m_work.push_back({ node, level, level == 0 ? getSkirts(node) : uint8(0), glm::dot(offset, offset), std::nullopt, nullptr, {}, false });
+    });
+    if(m_work.size() > m_descriptor.maxSectionsPerUpdate) {
+        auto last = m_work.begin() + static_cast<std::ptrdiff_t>(m_descriptor.maxSectionsPerUpdate);
+        std::ranges::nth_element(m_work, last, {}, &Work::distance);
+        m_work.erase(last, m_work.end());
+        nodes.clear();
+        for(const auto& item : m_work) {
+            nodes.tryEmplace(item.section, true);
+        }
+    }
+    std::vector<glm::ivec3> done;
+    m_pending.forEach([&](glm::ivec3 section, bool) {
+        if(nodes.find(getNode(section, getChunkLevel(getChunkOfSection(section)))))
+            done.push_back(section);
+    });
+    for(auto section : done) {
+        m_pending.erase(section);
+    }
+
+    // The jobs read what the world shares with them, an edit in the meantime copies the chunk instead of changing it under them.
+    for(auto& item : m_work) {
+        auto coordinate = getChunkOfSection(item.section);
+        if(item.level == 0)
+            item.neighbourhood.emplace(m_world, coordinate);
+        else
+            item.chunk = m_world.shareChunk(coordinate);
+    }
+    for(auto& item : m_work) {
+        m_jobSystem.submit([&item] { meshNode(item); }, &m_jobs);
+    }
+}
+
+void world::Remesher::meshNode(Work& work) {
+    // Every worker keeps its own scratch buffers.
+    thread_local ChunkMesher mesher;
+    PROFILE_SCOPE("mesh");
+    auto coordinate = getChunkOfSection(work.section);
+    auto local = glm::uvec3(work.section - coordinate * static_cast<int32>(SECTIONS_PER_AXIS));
+    if(work.level == 0 && work.neighbourhood->getChunk()) {
+        work.mesh = mesher.meshPacked(*work.neighbourhood, local, work.skirts);
+        work.solid = mesher.isSolid();
+    } else if(work.chunk) {
+        work.mesh = mesher.meshPackedLevel(*work.chunk, local >> work.level, work.level);
+        work.solid = mesher.isSolid();
+    }
+    // Let go of the chunks early, the world has to copy a chunk it changes while anything still shares it.
+    work.neighbourhood.reset();
+    work.chunk.reset();
+}
+
+void world::Remesher::applyWork() {
+    // A newer mesh of a node makes the waiting ones it overlaps stale.
+    auto overlaps = [](const Work& first, const Work& second) {
+        auto level = std::max(first.level, second.level);
+        return getNode(first.section, level) == getNode(second.section, level);
+    };
+    for(auto& item : m_work) {
+        std::erase_if(m_waiting, [&](const Work& waiting) { return overlaps(waiting, item); });
+        if(getCoarserNode(item))
+            m_waiting.push_back(std::move(item));
+        else
+            applyNode(item);
+    }
+    m_totalProcessedCount += m_work.size();
+    m_work.clear();
+
+    // The finer nodes replacing a coarser one are swapped in together once no section of it is dirty, until then it is drawn.
+    ChunkMap<bool> ready;
+    auto isReady = [&](glm::ivec3 node) {
+        auto [value, inserted] = ready.tryEmplace(node, true);
+        if(!inserted)
+            return value;
+        auto length = static_cast<int32>(1u << getLevel(node));
+        for(int32 x = 0; x < length && value; ++x) {
+            for(int32 y = 0; y < length && value; ++y) {
+                for(int32 z = 0; z < length && value; ++z) {
+                    if(m_pending.find(node + glm::ivec3(x, y, z)))
+                        value = false;
+                }
+            }
+        }
+        return value;
+    };
+    std::vector<Work> waiting;
+    for(auto& item : m_waiting) {
+        auto coarser = getCoarserNode(item);
+        if(!coarser || isReady(*coarser))
+            applyNode(item);
+        else
+            waiting.push_back(std::move(item));
+    }
+    m_waiting = std::move(waiting);
+}
+
+void world::Remesher::applyNode(Work& item) {
+    // The nodes of the previous level of the chunk overlap this one, finer ones lie inside it and a coarser one contains it.
+    auto length = static_cast<int32>(1u << item.level);
+    if(item.level > 0) {
+        for(int32 x = 0; x < length; ++x) {
+            for(int32 y = 0; y < length; ++y) {
+                for(int32 z = 0; z < length; ++z) {
+                    if(x != 0 || y != 0 || z != 0)
+                        eraseNode(item.section + glm::ivec3(x, y, z));
+                }
+            }
+        }
+    }
+    for(auto level = item.level + 1; level <= MAX_LEVEL_OF_DETAIL; ++level) {
+        auto node = getNode(item.section, level);
+        if(node != item.section && getLevel(node) > item.level)
+            eraseNode(node);
+    }
+
+    m_updated.push_back(item.section);
+    if(item.solid)
+        m_solid.tryEmplace(item.section, true);
+    else
+        m_solid.erase(item.section);
+    if(item.mesh.vertices.empty())
+        m_meshes.erase(item.section);
+    else
+        m_meshes.tryEmplace(item.section).first = std::move(item.mesh);
+    if(item.solid || m_meshes.find(item.section))
+        m_levels.tryEmplace(item.section).first = item.level;
+    else
+        m_levels.erase(item.section);
+}
+
+std::optional<glm::ivec3> world::Remesher::getCoarserNode(const Work& item) const noexcept {
+    for(auto level = item.level + 1; level <= MAX_LEVEL_OF_DETAIL; ++level) {
+        auto node = getNode(item.section, level);
+        auto nodeLevel = m_levels.find(node);
+        if(nodeLevel && *nodeLevel > item.level && getNode(item.section, *nodeLevel) == node)
+            return node;
+    }
+    return std::nullopt;
+}
+
+void world::Remesher::updateLevels(const voxels::CameraDescriptor& camera) {
+    if(m_descriptor.maxScreenError <= 0.0f)
+        return;
+
+    std::vector<glm::ivec3> unloaded;
+    m_chunkLevels.forEach([&](glm::ivec3 chunk, uint32) {
+        if(!m_world.isLoaded(chunk))
+            unloaded.push_back(chunk);
+    });
+    for(auto chunk : unloaded) {
+        m_chunkLevels.erase(chunk);
+    }
+
+    // A cell of 2^level voxels at the distance covers 2^level / ( 2 distance tan( fov / 2 ) ) of the viewport height.
+    auto cellsPerDistance = m_descriptor.maxScreenError * 2.0f * std::tan(camera.fieldOfView * 0.5f);
+    m_world.forEachChunk([&](const Chunk& chunk) {
+        auto min = chunk.getOrigin();
+        auto distance = glm::distance(glm::clamp(camera.position, min, min + static_cast<float32>(CHUNK_LENGTH)), camera.position);
+        auto maxCellLength = cellsPerDistance * distance;
+        auto level = maxCellLength < 2.0f ? 0u : std::min(static_cast<uint32>(std::log2(maxCellLength)), MAX_LEVEL_OF_DETAIL);
+
+        auto coordinate = chunk.getCoordinate();
+        auto [current, inserted] = m_chunkLevels.tryEmplace(coordinate, level);
+        if(!inserted && current == level)
+            return;
+        // A chunk seen for the first time has been marked dirty by the world when it was loaded.
+        auto previous = inserted ? 0u : current;
+        current = level;
+
+        auto length = static_cast<int32>(SECTIONS_PER_AXIS);
+        if(!inserted) {
+            auto first = coordinate * length;
+            auto step = static_cast<int32>(1u << level);
+            for(int32 x = 0; x < length; x += step) {
+                for(int32 y = 0; y < length; y += step) {
+                    for(int32 z = 0; z < length; z += step) {
+                        m_pending.tryEmplace(first + glm::ivec3(x, y, z), true);
+                    }
+                }
+            }
+        }
+
+        // The sections of the neighbours facing the chunk gain or lose their skirts.
+        if((previous == 0) == (level == 0))
+            return;
+        for(uint32 face = 0; face < 6; ++face) {
+            auto neighbour = coordinate + NEIGHBOURS[face];
+            if(!m_world.isLoaded(neighbour) || getChunkLevel(neighbour) != 0)
+                continue;
+            auto axis = face / 2;
+            auto u = (axis + 1) % 3, v = (axis + 2) % 3;
+            auto section = neighbour * length;
+            section[axis] += face % 2 == 0 ? 0 : length - 1;
+            for(int32 i = 0; i < length; ++i) {
+                for(int32 j = 0; j < length; ++j) {
+                    auto border = section;
+                    border[u] += i;
+                    border[v] += j;
+                    m_pending.tryEmplace(border, true);
+                }
+            }
+        }
+    });
+}
+
+uint8 world::Remesher::getSkirts(glm::ivec3 section) const noexcept {
+    if(m_chunkLevels.size() == 0)
+        return 0;
+
+    auto coordinate = getChunkOfSection(section);
+    auto local = section - coordinate * static_cast<int32>(SECTIONS_PER_AXIS);
+    uint8 skirts = 0;
+    for(uint32 face = 0; face < 6; ++face) {
+        auto axis = face / 2;
+        auto border = face % 2 == 0 ? static_cast<int32>(SECTIONS_PER_AXIS) - 1 : 0;
+        if(local[axis] == border && getChunkLevel(coordinate + NEIGHBOURS[face]) > 0)
+            skirts |= 1 << face;
+    }
+    return skirts;
+}
+
+void world::Remesher::eraseNode(glm::ivec3 section) {
+    bool erased = m_meshes.erase(section);
+    erased |= m_solid.erase(section);
+    erased |= m_levels.erase(section);
+    if(erased)
+        m_updated.push_back(section);
+}